@@ -1,8 +1,9 @@
 ﻿// 3DMath.cpp : 此文件包含 "main" 函数。程序执行将在此处开始并结束。
 //
 
-#include <iostream>;
-#include "Vector3.h";
+#include <iostream>
+#include <stdio.h>
+#include "Vector3.h"
 #include "EulerAngles.h"
 
 int main()
@@ -3,7 +3,7 @@
 #include <stdlib.h>
 #include "AABB3.h"
 #include "Matrix4x3.h"
-#include <Windows.h>
+#include <algorithm>
 #include <iostream>
 
 using namespace std;
@@ -12,53 +12,10 @@ using namespace std;
 // ߣcary
 // 3Dеα߽AABB
 
-//ȡ˸еһ
-// ޶ [000,111]
-// 0λѡ min.x vs. max.x
-// 1λѡ min.y vs. max.y
-// 2λѡ min.z vs. max.z
-Vector3 AABB3::corner(int i)const {
-	assert(i >= 0);
-	assert(i <= 7);
-	return Vector3(
-		(i & 1) ? max.x : min.x,
-		(i & 2) ? max.y : min.y,
-		(i & 4) ? max.z : min.z
-	);
-}
-
-//աα߽
-//ֵΪֵ/Сֵվα߽
-void AABB3::empty() {
-	const float kBigNumber = 1e37f;
-	min.x = min.y = min.z = +kBigNumber;
-	max.x = max.y = max.z = -kBigNumber;
-}
-
-//α߽ӵ
-void AABB3::add(const Vector3& p) {
-	if (p.x < min.x)min.x = p.x;
-	if (p.y < min.y)min.y = p.y;
-	if (p.z < min.z)min.z = p.y;
-	if (p.x > max.x)max.x = p.x;
-	if (p.y > max.y)max.y = p.y;
-	if (p.z > max.z)max.z = p.y;
-}
-
-//α߽AABB
-void AABB3::add(const AABB3& box) {
-
-	if (box.min.x < min.x)min.x = box.min.x;
-	if (box.min.y < min.y)min.y = box.min.y;
-	if (box.min.z < min.z)min.z = box.min.y;
-	if (box.max.x > max.x)max.x = box.max.x;
-	if (box.max.y > max.y)max.y = box.max.y;
-	if (box.max.z > max.z)max.z = box.max.y;
-}
-
 //任α߽,µAABB
 //õһһߴöAABB
-void AABB3::setToTransFormedBox(const AABB3& box, const Matrix4x3& m)
+template <typename T>
+void AABB3T<T>::setToTransFormedBox(const AABB3T<T>& box, const Matrix4x3T<T>& m)
 {
 	if (box.isEmpty()) {
 		empty();
@@ -145,80 +102,20 @@ void AABB3::setToTransFormedBox(const AABB3& box, const Matrix4x3& m)
 	}
 }
 
-// trueα߽Ϊ
-bool AABB3::isEmpty() const
-{
-	return (min.x > max.x) || (min.y > max.y) || (min.z > max.z);
-}
-
-//trueΰõ
-bool AABB3::contains(const Vector3& p) const
-{
-	return (p.x >= min.x) && (p.x <= max.x)
-		&& (p.y >= min.y) && (p.y <= max.y)
-		&& (p.z >= min.z) && (p.z <= max.z);
-}
-
-//ؾ߽ϵ
-Vector3 AABB3::closestPointTo(const Vector3& p) const
-{
-	//ÿһάϽp򡱾α߽
-	Vector3 r;
-	//x
-	if (p.x < min.x) {
-		r.x = min.x;
-	}
-	else if (p.x > max.x) {
-		r.x = max.x;
-	}
-	else {
-		r.x = p.x;
-	}
 
-	//y
-	if (p.y < min.y) {
-		r.y = min.y;
-	}
-	else if (p.y > max.y) {
-		r.y = max.y;
-	}
-	else {
-		r.y = p.y;
-	}
 
-	//z
-	if (p.z < min.z) {
-		r.z = min.z;
-	}
-	else if (p.z > max.z) {
-		r.z = max.z;
-	}
-	else {
-		r.z = p.z;
-	}
-	return r;
-}
 
-//trueཻ
-bool AABB3::intersectsSphere(const Vector3& center, float radius) const
-{
-	//ҵα߽ĵ
-	Vector3 closestPoint = closestPointTo(center);
-	//ĵľǷСڰ뾶
-	return distanceSquared(center, closestPoint) < radius * radius;
-}
 
 //ͲߵཻԲԣ򷵻ֵ1
 	//rayOrg  
 	//rayDelta ߳Ⱥͷ
 	//returnNoamalѡཻ
-float AABB3::rayIntersect(const Vector3& rayOrg, const Vector3 rayDelta, Vector3* returnNoamal) const
+template <typename T>
+T AABB3T<T>::rayIntersect(const Vector3T<T>& rayOrg, const Vector3T<T> rayDelta, Vector3T<T>* returnNoamal) const
 {
-	//δཻ򷵻
-	const float kNoIntersection = 1e30f;
 	//ھα߽ڵ㵽ÿľ
 	bool inside = true;
-	float xt, xn;
+	T xt, xn;
 	if (rayOrg.x < min.x) {
 		xt = min.x - rayOrg.x;
 		if (xt > rayDelta.x) {
@@ -228,20 +125,20 @@ float AABB3::rayIntersect(const Vector3& rayOrg, const Vector3 rayDelta, Vector3
 		inside = false;
 		xn = -1.0f;
 	}
-	else if (rayDelta.x > max.x) {
-		xt = max.x - rayDelta.x;
+	else if (rayOrg.x > max.x) {
+		xt = max.x - rayOrg.x;
 		if (xt < rayDelta.x) {
 			return kNoIntersection;
 		}
 		xt /= rayDelta.x;
 		inside = false;
-		xn = -1.0f;
+		xn = 1.0f;
 	}
 	else {
 		xt = -1.0f;
 	}
 
-	float yt, yn;
+	T yt, yn;
 	if (rayOrg.y < min.y) {
 		yt = min.y - rayOrg.y;
 		if (yt > rayDelta.y) {
@@ -251,20 +148,20 @@ float AABB3::rayIntersect(const Vector3& rayOrg, const Vector3 rayDelta, Vector3
 		inside = false;
 		yn = -1.0f;
 	}
-	else if (rayDelta.y > max.y) {
-		yt = max.y - rayDelta.y;
+	else if (rayOrg.y > max.y) {
+		yt = max.y - rayOrg.y;
 		if (yt < rayDelta.y) {
 			return kNoIntersection;
 		}
 		yt /= rayDelta.y;
 		inside = false;
-		yn = -1.0f;
+		yn = 1.0f;
 	}
 	else {
 		yt = -1.0f;
 	}
 
-	float zt, zn;
+	T zt, zn;
 	if (rayOrg.z < min.z) {
 		zt = min.z - rayOrg.z;
 		if (zt > rayDelta.z) {
@@ -274,14 +171,14 @@ float AABB3::rayIntersect(const Vector3& rayOrg, const Vector3 rayDelta, Vector3
 		inside = false;
 		zn = -1.0f;
 	}
-	else if (rayDelta.z > max.z) {
-		zt = max.z - rayDelta.z;
+	else if (rayOrg.z > max.z) {
+		zt = max.z - rayOrg.z;
 		if (zt < rayDelta.z) {
 			return kNoIntersection;
 		}
 		zt /= rayDelta.z;
 		inside = false;
-		zn = -1.0f;
+		zn = 1.0f;
 	}
 	else {
 		zt = -1.0f;
@@ -297,7 +194,7 @@ float AABB3::rayIntersect(const Vector3& rayOrg, const Vector3 rayDelta, Vector3
 
 	//ѡԶƽ桪ཻĵط
 	int which = 0;
-	float t = xt;
+	T t = xt;
 	if (yt > t) {
 		which = 1;
 		t = yt;
@@ -311,12 +208,12 @@ float AABB3::rayIntersect(const Vector3& rayOrg, const Vector3 rayDelta, Vector3
 	{
 	case 0://yzƽཻ
 	{
-		float y = rayOrg.y + rayDelta.y * t;
+		T y = rayOrg.y + rayDelta.y * t;
 		if (y<min.y || y>max.y) {
 			return kNoIntersection;
 		}
 
-		float z = rayOrg.z + rayDelta.z * t;
+		T z = rayOrg.z + rayDelta.z * t;
 		if (z<min.z || z>max.z) {
 			return kNoIntersection;
 		}
@@ -329,12 +226,12 @@ float AABB3::rayIntersect(const Vector3& rayOrg, const Vector3 rayDelta, Vector3
 	break;
 	case 1://xzƽཻ
 	{
-		float x = rayOrg.x + rayDelta.x * t;
+		T x = rayOrg.x + rayDelta.x * t;
 		if (x<min.x || x>max.x) {
 			return kNoIntersection;
 		}
 
-		float z = rayOrg.z + rayDelta.z * t;
+		T z = rayOrg.z + rayDelta.z * t;
 		if (z<min.z || z>max.z) {
 			return kNoIntersection;
 		}
@@ -347,12 +244,12 @@ float AABB3::rayIntersect(const Vector3& rayOrg, const Vector3 rayDelta, Vector3
 	break;
 	case 2://xyƽཻ
 	{
-		float x = rayOrg.x + rayDelta.x * t;
+		T x = rayOrg.x + rayDelta.x * t;
 		if (x<min.x || x>max.x) {
 			return kNoIntersection;
 		}
 
-		float y = rayOrg.y + rayDelta.y * t;
+		T y = rayOrg.y + rayDelta.y * t;
 		if (y<min.y || y>max.y) {
 			return kNoIntersection;
 		}
@@ -377,10 +274,11 @@ float AABB3::rayIntersect(const Vector3& rayOrg, const Vector3 rayDelta, Vector3
 // С0  α߽ȫƽı
 // 0  α߽ȫƽ
 // 0  α߽ƽཻ
-int AABB3::classifyPlane(const Vector3& n, float d) const
+template <typename T>
+int AABB3T<T>::classifyPlane(const Vector3T<T>& n, T d) const
 {
 	//С
-	float minD, maxD;
+	T minD, maxD;
 	if (n.x > 0.0f) {
 		minD = n.x * min.x;
 		maxD = n.x * max.x;
@@ -430,20 +328,19 @@ int AABB3::classifyPlane(const Vector3& n, float d) const
 //ؽĲֵཻʱAABBƶľ룬δཻ򷵻һ
 //
 //ֻ̽ƽཻ
-float AABB3::intersectPlane(const Vector3& n, float planeD, const Vector3& dir) const
+template <typename T>
+T AABB3T<T>::intersectPlane(const Vector3T<T>& n, T planeD, const Vector3T<T>& dir) const
 {
 	//Ƿ
 	assert(fabs(n * n - 1.0f) < .01);
 	assert(fabs(dir * dir - 1.0f) < .01);
-	//δཻ򷵻
-	const float kNoIntersection = 1e30f;
 	//нǣȷƽƶ
-	float dot = n * dir;
+	T dot = n * dir;
 	if (dot >= 0.0f) {
 		return kNoIntersection;
 	}
 	//鷨СֵminDǡǰġDֵ
-	float minD, maxD;
+	T minD, maxD;
 	if (n.x > 0.0f) {
 		minD = n.x * min.x;
 		maxD = n.x * max.x;
@@ -476,7 +373,7 @@ float AABB3::intersectPlane(const Vector3& n, float planeD, const Vector3& dir)
 		return kNoIntersection;
 	}
 	//ǰ涨׼߷
-	float t = (planeD - minD) / dot;
+	T t = (planeD - minD) / dot;
 	if (t < 0.0f) {
 		//
 		return 0.0f;
@@ -485,37 +382,14 @@ float AABB3::intersectPlane(const Vector3& n, float planeD, const Vector3& dir)
 	return t;
 }
 
-//AABBཻԣtrueԷֵཻAABB
-bool intersectAABBs(const AABB3& box1, const AABB3& box2, AABB3* boxIntersect)
-{
-	//жǷص
-	if (box1.min.x > box2.max.x)return false;
-	if (box1.min.y > box2.max.y)return false;
-	if (box1.min.z > box2.max.z)return false;
-	if (box1.max.x < box2.min.x)return false;
-	if (box1.max.y < box2.min.y)return false;
-	if (box1.max.z < box2.min.z)return false;
-	//صصֵAABB
-	if (boxIntersect != NULL) {
-		boxIntersect->min.x = max(box1.min.x, box2.min.x);
-		boxIntersect->min.y = max(box1.min.y, box2.min.y);
-		boxIntersect->min.z = max(box1.min.z, box2.min.z);
-		boxIntersect->max.x = min(box1.max.x, box2.max.x);
-		boxIntersect->max.y = min(box1.max.y, box2.max.y);
-		boxIntersect->max.z = min(box1.max.z, box2.max.z);
-	}
-
-	return true;
-}
 
 //˶AABB;ֹAABBཻʱĲ㣬ཻ򷵻ֵ1
-float intersectMovingAABB(const AABB3& stationaryBox, const AABB3& movingBox, const Vector3& d)
+template <typename T>
+T intersectMovingAABB(const AABB3T<T>& stationaryBox, const AABB3T<T>& movingBox, const Vector3T<T>& d)
 {
-	//δཻ򷵻
-	const float kNoIntersection = 1e30f;
 	//ʼʱ䣬԰Ҫǵȫʱ
-	float tEnter = 0.0f;
-	float tLeave = 1.0f;
+	T tEnter = 0.0f;
+	T tLeave = 1.0f;
 	//ÿһάص֣ٽصֺǰصཻ
 	//һάصΪ򷵻(ཻ)
 	//ÿһά϶뵱ص
@@ -530,10 +404,10 @@ float intersectMovingAABB(const AABB3& stationaryBox, const AABB3& movingBox, co
 	}
 	else
 	{
-		float oneOverD = 1.0f / d.x;
+		T oneOverD = 1.0f / d.x;
 		//㿪ʼӴͷʱ
-		float xEnter = (stationaryBox.min.x - movingBox.max.x) * oneOverD;
-		float xLeave = (stationaryBox.max.x - movingBox.min.x) * oneOverD;
+		T xEnter = (stationaryBox.min.x - movingBox.max.x) * oneOverD;
+		T xLeave = (stationaryBox.max.x - movingBox.min.x) * oneOverD;
 		//
 		if (xEnter > xLeave) {
 			swap(xEnter, xLeave);
@@ -560,10 +434,10 @@ float intersectMovingAABB(const AABB3& stationaryBox, const AABB3& movingBox, co
 	}
 	else
 	{
-		float oneOverD = 1.0f / d.y;
+		T oneOverD = 1.0f / d.y;
 		//㿪ʼӴͷʱ
-		float yEnter = (stationaryBox.min.y - movingBox.max.y) * oneOverD;
-		float yLeave = (stationaryBox.max.y - movingBox.min.y) * oneOverD;
+		T yEnter = (stationaryBox.min.y - movingBox.max.y) * oneOverD;
+		T yLeave = (stationaryBox.max.y - movingBox.min.y) * oneOverD;
 		//
 		if (yEnter > yLeave) {
 			swap(yEnter, yLeave);
@@ -590,10 +464,10 @@ float intersectMovingAABB(const AABB3& stationaryBox, const AABB3& movingBox, co
 	}
 	else
 	{
-		float oneOverD = 1.0f / d.z;
+		T oneOverD = 1.0f / d.z;
 		//㿪ʼӴͷʱ
-		float zEnter = (stationaryBox.min.z - movingBox.max.z) * oneOverD;
-		float zLeave = (stationaryBox.max.z - movingBox.min.z) * oneOverD;
+		T zEnter = (stationaryBox.min.z - movingBox.max.z) * oneOverD;
+		T zLeave = (stationaryBox.max.z - movingBox.min.z) * oneOverD;
 		//
 		if (zEnter > zLeave) {
 			swap(zEnter, zLeave);
@@ -612,3 +486,9 @@ float intersectMovingAABB(const AABB3& stationaryBox, const AABB3& movingBox, co
 	}
 	return tEnter;
 }
+
+//floatdouble汾ʵ
+template class AABB3T<float>;
+template class AABB3T<double>;
+template float intersectMovingAABB(const AABB3&, const AABB3&, const Vector3&);
+template double intersectMovingAABB(const AABB3d&, const AABB3d&, const Vector3d&);
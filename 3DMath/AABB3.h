@@ -3,57 +3,69 @@
 #ifndef __AABB3_H_INCLUDED__
 #define __AABB3_H_INCLUDED__
 
+#include <assert.h>
+#include <stddef.h>
+
 #ifndef __VECTOR3_H_INCLUDED
 #include "Vector3.h"
 #endif // #ifndef __VECTOR3_H_INCLUDED
 
-class Matrix4x3;
+template <typename T> class Matrix4x3T;
+typedef Matrix4x3T<float> Matrix4x3;
+
+//ཻԲδཻʱصĴ
+const float kNoIntersection = 1e30f;
 
 // ƣAABB3D
 // ߣcary
 // 3Dеα߽AABB
-class AABB3
+//		ģAABB3Ϊfloat汾AABB3dΪdouble汾ԣAABB3Array.hֻfloat汾
+//		㡢աӵͰ/ཻԲconstexprڱڼ
+template <typename T>
+class AABB3T
 {
 public:
-	Vector3 min;
-	Vector3 max;
-	Vector3 size() const { return max - min; }
-	float xSize() { return max.x - min.x; }
-	float ySize() { return max.y - min.y; }
-	float zSize() { return max.z - min.z; }
-	Vector3 center() const { return (min + max) * .5f; }
+	typedef T Scalar;
+
+	Vector3T<T> min;
+	Vector3T<T> max;
+	constexpr Vector3T<T> size() const { return max - min; }
+	constexpr T xSize() const { return max.x - min.x; }
+	constexpr T ySize() const { return max.y - min.y; }
+	constexpr T zSize() const { return max.z - min.z; }
+	constexpr Vector3T<T> center() const { return (min + max) * .5f; }
 	//ȡ˸еһ
-	Vector3 corner(int i)const;
+	constexpr Vector3T<T> corner(int i)const;
 	//α߽
 	//աα߽
-	void empty();
+	constexpr void empty();
 	//α߽ӵ
-	void add(const Vector3& p);
+	constexpr void add(const Vector3T<T>& p);
 	//α߽AABB
-	void add(const AABB3 &box);
+	constexpr void add(const AABB3T &box);
 	//任α߽,µAABB
-	void setToTransFormedBox(const AABB3& box, const Matrix4x3& m);
+	void setToTransFormedBox(const AABB3T& box, const Matrix4x3T<T>& m);
 	///ཻԲ
 	// trueα߽Ϊ
-	bool isEmpty() const;
+	constexpr bool isEmpty() const;
 	//trueΰõ
-	bool contains(const Vector3& p) const;
+	constexpr bool contains(const Vector3T<T>& p) const;
 	//ؾ߽ϵ
-	Vector3 closestPointTo(const Vector3& p)const;
+	constexpr Vector3T<T> closestPointTo(const Vector3T<T>& p)const;
 	//trueཻ
-	bool intersectsSphere(const Vector3& center, float radius)const;
+	constexpr bool intersectsSphere(const Vector3T<T>& center, T radius)const;
 	//ͲߵཻԲԣ򷵻ֵ1
 	//rayOrg  
 	//rayDelta ߳Ⱥͷ
 	//returnNoamalѡཻ
-	float rayIntersect(const Vector3& rayOrg, const Vector3 rayDelta, Vector3* returnNoamal = 0)const;
+	T rayIntersect(const Vector3T<T>& rayOrg, const Vector3T<T> rayDelta, Vector3T<T>* returnNoamal = 0)const;
 	//жϾα߽ھεһ
 	//ֹAABBƽཻԼ
 	//ֵ
 	// С0  α߽ȫƽı
 	// 0  α߽ȫƽ
 	// 0  α߽ƽཻ
-	int classifyPlane(const Vector3& n, float d)const;
+	int classifyPlane(const Vector3T<T>& n, T d)const;
 	//ƽĶཻ̬Բ
 	//nΪƽķ׼
 	//planeD Ϊƽ淽 p*n=d еDֵ
@@ -64,14 +76,153 @@ public:
 	//
 	//ֻ̽ƽཻ
 	// ֵ  1δܼʱƽ棬ʱҪ߽м
-	float intersectPlane(const Vector3& n, float planeD, const Vector3& dir)const;
+	T intersectPlane(const Vector3T<T>& n, T planeD, const Vector3T<T>& dir)const;
 
 };
 
+typedef AABB3T<float> AABB3;
+typedef AABB3T<double> AABB3d;
+
+//ȡ˸еһ
+// ޶ [000,111]
+// 0λѡ min.x vs. max.x
+// 1λѡ min.y vs. max.y
+// 2λѡ min.z vs. max.z
+template <typename T>
+constexpr Vector3T<T> AABB3T<T>::corner(int i)const {
+	assert(i >= 0);
+	assert(i <= 7);
+	return Vector3T<T>(
+		(i & 1) ? max.x : min.x,
+		(i & 2) ? max.y : min.y,
+		(i & 4) ? max.z : min.z
+	);
+}
+
+//աα߽
+//ֵΪֵ/Сֵվα߽
+template <typename T>
+constexpr void AABB3T<T>::empty() {
+	const T kBigNumber = 1e37f;
+	min.x = min.y = min.z = +kBigNumber;
+	max.x = max.y = max.z = -kBigNumber;
+}
+
+//α߽ӵ
+template <typename T>
+constexpr void AABB3T<T>::add(const Vector3T<T>& p) {
+	if (p.x < min.x)min.x = p.x;
+	if (p.y < min.y)min.y = p.y;
+	if (p.z < min.z)min.z = p.z;
+	if (p.x > max.x)max.x = p.x;
+	if (p.y > max.y)max.y = p.y;
+	if (p.z > max.z)max.z = p.z;
+}
+
+//α߽AABB
+template <typename T>
+constexpr void AABB3T<T>::add(const AABB3T<T>& box) {
+	if (box.min.x < min.x)min.x = box.min.x;
+	if (box.min.y < min.y)min.y = box.min.y;
+	if (box.min.z < min.z)min.z = box.min.z;
+	if (box.max.x > max.x)max.x = box.max.x;
+	if (box.max.y > max.y)max.y = box.max.y;
+	if (box.max.z > max.z)max.z = box.max.z;
+}
+
+// trueα߽Ϊ
+template <typename T>
+constexpr bool AABB3T<T>::isEmpty() const
+{
+	return (min.x > max.x) || (min.y > max.y) || (min.z > max.z);
+}
+
+//trueΰõ
+template <typename T>
+constexpr bool AABB3T<T>::contains(const Vector3T<T>& p) const
+{
+	return (p.x >= min.x) && (p.x <= max.x)
+		&& (p.y >= min.y) && (p.y <= max.y)
+		&& (p.z >= min.z) && (p.z <= max.z);
+}
+
+//ؾ߽ϵ
+template <typename T>
+constexpr Vector3T<T> AABB3T<T>::closestPointTo(const Vector3T<T>& p) const
+{
+	//ÿһάϽp򡱾α߽
+	Vector3T<T> r{};
+	//x
+	if (p.x < min.x) {
+		r.x = min.x;
+	}
+	else if (p.x > max.x) {
+		r.x = max.x;
+	}
+	else {
+		r.x = p.x;
+	}
+
+	//y
+	if (p.y < min.y) {
+		r.y = min.y;
+	}
+	else if (p.y > max.y) {
+		r.y = max.y;
+	}
+	else {
+		r.y = p.y;
+	}
+
+	//z
+	if (p.z < min.z) {
+		r.z = min.z;
+	}
+	else if (p.z > max.z) {
+		r.z = max.z;
+	}
+	else {
+		r.z = p.z;
+	}
+	return r;
+}
+
+//trueཻ
+template <typename T>
+constexpr bool AABB3T<T>::intersectsSphere(const Vector3T<T>& center, T radius) const
+{
+	//ҵα߽ĵ
+	Vector3T<T> closestPoint = closestPointTo(center);
+	//ĵľǷСڰ뾶
+	return distanceSquared(center, closestPoint) < radius * radius;
+}
+
 //AABBཻԣtrueԷֵཻAABB
-bool intersectAABBs(const AABB3& box1, const AABB3& box2, AABB3* boxIntersect = 0);
+template <typename T>
+constexpr bool intersectAABBs(const AABB3T<T>& box1, const AABB3T<T>& box2, AABB3T<T>* boxIntersect = 0)
+{
+	//жǷص
+	if (box1.min.x > box2.max.x)return false;
+	if (box1.min.y > box2.max.y)return false;
+	if (box1.min.z > box2.max.z)return false;
+	if (box1.max.x < box2.min.x)return false;
+	if (box1.max.y < box2.min.y)return false;
+	if (box1.max.z < box2.min.z)return false;
+	//صصֵAABB
+	if (boxIntersect != NULL) {
+		boxIntersect->min.x = box1.min.x < box2.min.x ? box2.min.x : box1.min.x;
+		boxIntersect->min.y = box1.min.y < box2.min.y ? box2.min.y : box1.min.y;
+		boxIntersect->min.z = box1.min.z < box2.min.z ? box2.min.z : box1.min.z;
+		boxIntersect->max.x = box2.max.x < box1.max.x ? box2.max.x : box1.max.x;
+		boxIntersect->max.y = box2.max.y < box1.max.y ? box2.max.y : box1.max.y;
+		boxIntersect->max.z = box2.max.z < box1.max.z ? box2.max.z : box1.max.z;
+	}
+
+	return true;
+}
 
 //˶AABB;ֹAABBཻʱĲ㣬ཻ򷵻ֵ1
-float intersectMovingAABB(const AABB3& stationaryBox, const AABB3& movingBox, const Vector3& d);
+template <typename T>
+T intersectMovingAABB(const AABB3T<T>& stationaryBox, const AABB3T<T>& movingBox, const Vector3T<T>& d);
 
-#endif // #ifndef __AABB3_H_INCLUDED__
\ No newline at end of file
+#endif // #ifndef __AABB3_H_INCLUDED__
@@ -0,0 +1,674 @@
+#include <assert.h>
+#include <math.h>
+
+#include "AABB3Array.h"
+#include "AABB3.h"
+#include "Vector3.h"
+#include "Matrix4x3.h"
+#include "SimdUtil.h"
+#include "SimdMatrix4x3.h"
+
+// ƣAABB
+// ߣcary
+// SoAʽһα߽minmaxֱһVector3Array
+//		ںʹAABBཻԲ
+
+//AABB
+AABB3 AABB3Array::get(size_t i) const {
+	AABB3 box;
+	box.min = min.get(i);
+	box.max = max.get(i);
+	return box;
+}
+
+//дAABB
+void AABB3Array::set(size_t i, const AABB3& box) {
+	min.set(i, box.min);
+	max.set(i, box.max);
+}
+
+//box[0..n)룬СΪn
+void AABB3Array::fromAABB3s(const AABB3* box, size_t n) {
+	resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		set(i, box[i]);
+	}
+}
+
+//дbox[0..size())
+void AABB3Array::toAABB3s(AABB3* box) const {
+	const size_t n = size();
+	for (size_t i = 0; i < n; ++i) {
+		box[i] = get(i);
+	}
+}
+
+//SIMDƽ㷨ͬʱkSimdWidthߺAABB
+//ÿһάȰķѡȵġƽ桱ͺ󵽴ġԶƽ桱
+//ʱȡάƽֵ뿪ʱȡάԶƽСֵ
+//
+//Ϊ㲢ƽʱ0 * õNaN
+//simdMax(a, b)simdMin(a, b)NaNʱb԰ۻֵڵڶϣNaNᱻԣ
+//ʱߺ͸άƽƽУƽڣӰ
+static SimdFloat simdRayIntersectBox(
+	SimdFloat orgX, SimdFloat orgY, SimdFloat orgZ,
+	SimdFloat deltaX, SimdFloat deltaY, SimdFloat deltaZ,
+	SimdFloat invX, SimdFloat invY, SimdFloat invZ,
+	SimdFloat minX, SimdFloat minY, SimdFloat minZ,
+	SimdFloat maxX, SimdFloat maxY, SimdFloat maxZ,
+	SimdFloat* normalX, SimdFloat* normalY, SimdFloat* normalZ) {
+	const SimdFloat zero = simdZero();
+	const SimdFloat one = simdSet(1.0f);
+
+	//Ϊʱȵmaxƽ
+	SimdFloat negX = simdCmpLt(invX, zero);
+	SimdFloat negY = simdCmpLt(invY, zero);
+	SimdFloat negZ = simdCmpLt(invZ, zero);
+
+	SimdFloat nearX = simdMul(simdSub(simdSelect(negX, maxX, minX), orgX), invX);
+	SimdFloat nearY = simdMul(simdSub(simdSelect(negY, maxY, minY), orgY), invY);
+	SimdFloat nearZ = simdMul(simdSub(simdSelect(negZ, maxZ, minZ), orgZ), invZ);
+	SimdFloat farX = simdMul(simdSub(simdSelect(negX, minX, maxX), orgX), invX);
+	SimdFloat farY = simdMul(simdSub(simdSelect(negY, minY, maxY), orgY), invY);
+	SimdFloat farZ = simdMul(simdSub(simdSelect(negZ, minZ, maxZ), orgZ), invZ);
+
+	SimdFloat tEnter = simdSet(-HUGE_VALF);
+	tEnter = simdMax(nearX, tEnter);
+	tEnter = simdMax(nearY, tEnter);
+	tEnter = simdMax(nearZ, tEnter);
+	SimdFloat tLeave = simdSet(HUGE_VALF);
+	tLeave = simdMin(farX, tLeave);
+	tLeave = simdMin(farY, tLeave);
+	tLeave = simdMin(farZ, tLeave);
+
+	//ʱ䲻˵AABBڲ
+	SimdFloat inside = simdCmpLe(tEnter, zero);
+	SimdFloat t = simdMax(tEnter, zero);
+	SimdFloat hit = simdAnd(simdCmpLe(t, tLeave), simdCmpLe(t, one));
+
+	if (normalX != NULL) {
+		//ཻǽʱһάʱxyzAABB3::rayIntersect()һ
+		SimdFloat onX = simdCmpEq(nearX, tEnter);
+		SimdFloat onY = simdAndNot(onX, simdCmpEq(nearY, tEnter));
+		//Ϊʱmax룬Ϊ+1Ϊ-1
+		SimdFloat minusOne = simdSet(-1.0f);
+		SimdFloat faceX = simdAnd(onX, simdSelect(negX, one, minusOne));
+		SimdFloat faceY = simdAnd(onY, simdSelect(negY, one, minusOne));
+		SimdFloat faceZ = simdAndNot(simdOr(onX, onY), simdSelect(negZ, one, minusOne));
+
+		//ڲʱΪ-rayDeltaĵλΪ
+		SimdFloat sumOfSquare = simdAdd(simdAdd(simdMul(deltaX, deltaX), simdMul(deltaY, deltaY)), simdMul(deltaZ, deltaZ));
+		SimdFloat reciprocal = simdDiv(minusOne, simdSqrt(sumOfSquare));
+		reciprocal = simdAnd(simdCmpGt(sumOfSquare, zero), reciprocal);
+
+		*normalX = simdAnd(hit, simdSelect(inside, simdMul(deltaX, reciprocal), faceX));
+		*normalY = simdAnd(hit, simdSelect(inside, simdMul(deltaY, reciprocal), faceY));
+		*normalZ = simdAnd(hit, simdSelect(inside, simdMul(deltaZ, reciprocal), faceZ));
+	}
+
+	return simdSelect(hit, t, simdSet(kNoIntersection));
+}
+
+//nߺһAABBཻԲԣÿβkSimdWidth48
+void rayIntersect(const AABB3& box, const Vector3Array& rayOrg, const Vector3Array& rayDelta,
+	float* t, Vector3Array* returnNoamal) {
+	assert(rayOrg.size() == rayDelta.size());
+	const size_t n = rayOrg.size();
+	if (returnNoamal != NULL) {
+		returnNoamal->resize(n);
+	}
+	const SimdFloat one = simdSet(1.0f);
+	const SimdFloat minX = simdSet(box.min.x), minY = simdSet(box.min.y), minZ = simdSet(box.min.z);
+	const SimdFloat maxX = simdSet(box.max.x), maxY = simdSet(box.max.y), maxZ = simdSet(box.max.z);
+	SimdFloat normalX, normalY, normalZ;
+	SimdFloat* normal = returnNoamal != NULL ? &normalX : NULL;
+
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat dx = simdLoadAligned(rayDelta.x + i), dy = simdLoadAligned(rayDelta.y + i), dz = simdLoadAligned(rayDelta.z + i);
+		SimdFloat r = simdRayIntersectBox(
+			simdLoadAligned(rayOrg.x + i), simdLoadAligned(rayOrg.y + i), simdLoadAligned(rayOrg.z + i),
+			dx, dy, dz, simdDiv(one, dx), simdDiv(one, dy), simdDiv(one, dz),
+			minX, minY, minZ, maxX, maxY, maxZ,
+			normal, &normalY, &normalZ);
+		simdStore(t + i, r);
+		if (returnNoamal != NULL) {
+			simdStoreAligned(returnNoamal->x + i, normalX);
+			simdStoreAligned(returnNoamal->y + i, normalY);
+			simdStoreAligned(returnNoamal->z + i, normalZ);
+		}
+	}
+	if (i < n) {
+		//ʣ²һ߸ƵʱУ㣬ֻдЧ
+		float temp[6][kSimdWidth] = {};
+		for (size_t j = i; j < n; ++j) {
+			temp[0][j - i] = rayOrg.x[j];
+			temp[1][j - i] = rayOrg.y[j];
+			temp[2][j - i] = rayOrg.z[j];
+			temp[3][j - i] = rayDelta.x[j];
+			temp[4][j - i] = rayDelta.y[j];
+			temp[5][j - i] = rayDelta.z[j];
+		}
+		SimdFloat dx = simdLoad(temp[3]), dy = simdLoad(temp[4]), dz = simdLoad(temp[5]);
+		SimdFloat r = simdRayIntersectBox(
+			simdLoad(temp[0]), simdLoad(temp[1]), simdLoad(temp[2]),
+			dx, dy, dz, simdDiv(one, dx), simdDiv(one, dy), simdDiv(one, dz),
+			minX, minY, minZ, maxX, maxY, maxZ,
+			normal, &normalY, &normalZ);
+		simdStore(temp[0], r);
+		if (returnNoamal != NULL) {
+			simdStore(temp[1], normalX);
+			simdStore(temp[2], normalY);
+			simdStore(temp[3], normalZ);
+		}
+		for (size_t j = i; j < n; ++j) {
+			t[j] = temp[0][j - i];
+			if (returnNoamal != NULL) {
+				returnNoamal->x[j] = temp[1][j - i];
+				returnNoamal->y[j] = temp[2][j - i];
+				returnNoamal->z[j] = temp[3][j - i];
+			}
+		}
+	}
+}
+
+//һߺnAABBཻԲԣÿβkSimdWidth48AABB
+void rayIntersect(const AABB3Array& boxes, const Vector3& rayOrg, const Vector3& rayDelta, const Vector3& rayDeltaInv,
+	float* t, Vector3Array* returnNoamal) {
+	const size_t n = boxes.size();
+	if (returnNoamal != NULL) {
+		returnNoamal->resize(n);
+	}
+	const SimdFloat orgX = simdSet(rayOrg.x), orgY = simdSet(rayOrg.y), orgZ = simdSet(rayOrg.z);
+	const SimdFloat deltaX = simdSet(rayDelta.x), deltaY = simdSet(rayDelta.y), deltaZ = simdSet(rayDelta.z);
+	const SimdFloat invX = simdSet(rayDeltaInv.x), invY = simdSet(rayDeltaInv.y), invZ = simdSet(rayDeltaInv.z);
+	SimdFloat normalX, normalY, normalZ;
+	SimdFloat* normal = returnNoamal != NULL ? &normalX : NULL;
+
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat r = simdRayIntersectBox(orgX, orgY, orgZ, deltaX, deltaY, deltaZ, invX, invY, invZ,
+			simdLoadAligned(boxes.min.x + i), simdLoadAligned(boxes.min.y + i), simdLoadAligned(boxes.min.z + i),
+			simdLoadAligned(boxes.max.x + i), simdLoadAligned(boxes.max.y + i), simdLoadAligned(boxes.max.z + i),
+			normal, &normalY, &normalZ);
+		simdStore(t + i, r);
+		if (returnNoamal != NULL) {
+			simdStoreAligned(returnNoamal->x + i, normalX);
+			simdStoreAligned(returnNoamal->y + i, normalY);
+			simdStoreAligned(returnNoamal->z + i, normalZ);
+		}
+	}
+	if (i < n) {
+		//ʣ²һAABBƵʱУ㣬ֻдЧ
+		float temp[6][kSimdWidth] = {};
+		for (size_t j = i; j < n; ++j) {
+			temp[0][j - i] = boxes.min.x[j];
+			temp[1][j - i] = boxes.min.y[j];
+			temp[2][j - i] = boxes.min.z[j];
+			temp[3][j - i] = boxes.max.x[j];
+			temp[4][j - i] = boxes.max.y[j];
+			temp[5][j - i] = boxes.max.z[j];
+		}
+		SimdFloat r = simdRayIntersectBox(orgX, orgY, orgZ, deltaX, deltaY, deltaZ, invX, invY, invZ,
+			simdLoad(temp[0]), simdLoad(temp[1]), simdLoad(temp[2]),
+			simdLoad(temp[3]), simdLoad(temp[4]), simdLoad(temp[5]),
+			normal, &normalY, &normalZ);
+		simdStore(temp[0], r);
+		if (returnNoamal != NULL) {
+			simdStore(temp[1], normalX);
+			simdStore(temp[2], normalY);
+			simdStore(temp[3], normalZ);
+		}
+		for (size_t j = i; j < n; ++j) {
+			t[j] = temp[0][j - i];
+			if (returnNoamal != NULL) {
+				returnNoamal->x[j] = temp[1][j - i];
+				returnNoamal->y[j] = temp[2][j - i];
+				returnNoamal->z[j] = temp[3][j - i];
+			}
+		}
+	}
+}
+
+//任AABBһάtΪƽƣabcΪеϵ
+//AABB3::setToTransFormedBox()һϵʱСֵȡԭAABBminȡmax
+//simdSelect()֧ۼӵ˳ҲͬԽλһ
+//
+//ļӰ߳ʽcenter * m + |m| * extentͬûз֧㲻ͬ
+//ܺ͵汾λһ£ﰴѡ
+static inline void simdTransformAxis(SimdFloat t, SimdFloat a, SimdFloat b, SimdFloat c,
+	const SimdFloat* boxMin, const SimdFloat* boxMax, SimdFloat* returnMin, SimdFloat* returnMax) {
+	const SimdFloat zero = simdZero();
+	SimdFloat positiveA = simdCmpGt(a, zero);
+	SimdFloat positiveB = simdCmpGt(b, zero);
+	SimdFloat positiveC = simdCmpGt(c, zero);
+	SimdFloat lo = simdAdd(t, simdMul(a, simdSelect(positiveA, boxMin[0], boxMax[0])));
+	SimdFloat hi = simdAdd(t, simdMul(a, simdSelect(positiveA, boxMax[0], boxMin[0])));
+	lo = simdAdd(lo, simdMul(b, simdSelect(positiveB, boxMin[1], boxMax[1])));
+	hi = simdAdd(hi, simdMul(b, simdSelect(positiveB, boxMax[1], boxMin[1])));
+	lo = simdAdd(lo, simdMul(c, simdSelect(positiveC, boxMin[2], boxMax[2])));
+	hi = simdAdd(hi, simdMul(c, simdSelect(positiveC, boxMax[2], boxMin[2])));
+	*returnMin = lo;
+	*returnMax = hi;
+}
+
+//ͬʱ任kSimdWidthAABBboxΪmin.xmin.ymin.zmax.xmax.ymax.zдbox
+static inline void simdTransformBox(const SimdMatrix4x3& m, SimdFloat* box) {
+	const SimdFloat* boxMin = box;
+	const SimdFloat* boxMax = box + 3;
+	//յAABBAABB3::isEmpty()ͬ
+	SimdFloat empty = simdOr(simdOr(simdCmpGt(boxMin[0], boxMax[0]), simdCmpGt(boxMin[1], boxMax[1])),
+		simdCmpGt(boxMin[2], boxMax[2]));
+
+	SimdFloat r[6];
+	simdTransformAxis(m.tx, m.m11, m.m21, m.m31, boxMin, boxMax, &r[0], &r[3]);
+	simdTransformAxis(m.ty, m.m12, m.m22, m.m32, boxMin, boxMax, &r[1], &r[4]);
+	simdTransformAxis(m.tz, m.m13, m.m23, m.m33, boxMin, boxMax, &r[2], &r[5]);
+
+	//AABB3::empty()ֵͬ
+	const SimdFloat bigNumber = simdSet(1e37f);
+	const SimdFloat minusBigNumber = simdSet(-1e37f);
+	for (int k = 0; k < 3; ++k) {
+		box[k] = simdSelect(empty, bigNumber, r[k]);
+		box[k + 3] = simdSelect(empty, minusBigNumber, r[k + 3]);
+	}
+}
+
+//任AABBshared ΪʱAABBʹͬһ󣬷ʹm[i]
+static void transformBoxes(const AABB3Array& in, AABB3Array* out, const Matrix4x3* m, const SimdMatrix4x3* shared) {
+	const size_t n = in.size();
+	out->resize(n);
+	const float* src[6] = { in.min.x, in.min.y, in.min.z, in.max.x, in.max.y, in.max.z };
+	float* dst[6] = { out->min.x, out->min.y, out->min.z, out->max.x, out->max.y, out->max.z };
+
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdMatrix4x3 matrices;
+		if (shared == NULL) {
+			simdLoadMatrices(m + i, &matrices);
+		}
+		SimdFloat box[6];
+		for (int k = 0; k < 6; ++k) {
+			box[k] = simdLoadAligned(src[k] + i);
+		}
+		simdTransformBox(shared != NULL ? *shared : matrices, box);
+		for (int k = 0; k < 6; ++k) {
+			simdStoreAligned(dst[k] + i, box[k]);
+		}
+	}
+	if (i < n) {
+		//ʣ²һAABB;ƵʱУ㣬ֻдЧ
+		const size_t count = n - i;
+		float temp[6][kSimdWidth] = {};
+		Matrix4x3 tempMatrices[kSimdWidth] = {};
+		for (size_t j = 0; j < count; ++j) {
+			for (int k = 0; k < 6; ++k) {
+				temp[k][j] = src[k][i + j];
+			}
+			if (shared == NULL) {
+				tempMatrices[j] = m[i + j];
+			}
+		}
+		SimdMatrix4x3 matrices;
+		if (shared == NULL) {
+			simdLoadMatrices(tempMatrices, &matrices);
+		}
+		SimdFloat box[6];
+		for (int k = 0; k < 6; ++k) {
+			box[k] = simdLoad(temp[k]);
+		}
+		simdTransformBox(shared != NULL ? *shared : matrices, box);
+		for (int k = 0; k < 6; ++k) {
+			simdStore(temp[k], box[k]);
+		}
+		for (size_t j = 0; j < count; ++j) {
+			for (int k = 0; k < 6; ++k) {
+				dst[k][i + j] = temp[k][j];
+			}
+		}
+	}
+}
+
+//ÿAABBʹøԵľ
+void transformBoxes(const AABB3Array& in, AABB3Array* out, const Matrix4x3* m) {
+	transformBoxes(in, out, m, NULL);
+}
+
+//AABBʹͬһ
+void transformBoxes(const AABB3Array& in, AABB3Array* out, const Matrix4x3& m) {
+	SimdMatrix4x3 shared;
+	simdSetMatrix(m, &shared);
+	transformBoxes(in, out, NULL, &shared);
+}
+
+//ͬʱkSimdWidth˶AABB;ֹAABB
+//boxΪmin.xmin.ymin.zmax.xmax.ymax.z
+//
+//intersectMovingAABB()һxyz˳Сʱ[tEnter, tLeave]
+//ıȽ϶дsimdMin()/simdMax()ǵĲ˳͵汾һ£
+//NaNʱҲõͬĽ
+//汾ΪʱأֻСͳһжһνͬ
+static inline SimdFloat simdIntersectMovingBox(const SimdFloat* stationaryBox, const SimdFloat* movingBox,
+	const SimdFloat* d) {
+	const SimdFloat zero = simdZero();
+	const SimdFloat one = simdSet(1.0f);
+	SimdFloat tEnter = zero;
+	SimdFloat tLeave = one;
+	SimdFloat miss = zero;
+	for (int k = 0; k < 3; ++k) {
+		const SimdFloat& stationaryMin = stationaryBox[k];
+		const SimdFloat& stationaryMax = stationaryBox[k + 3];
+		const SimdFloat& movingMin = movingBox[k];
+		const SimdFloat& movingMax = movingBox[k + 3];
+
+		//һάûƶص
+		SimdFloat zeroD = simdCmpEq(d[k], zero);
+		SimdFloat separated = simdOr(simdCmpGt(stationaryMin, movingMax), simdCmpLt(stationaryMax, movingMin));
+		miss = simdOr(miss, simdAnd(zeroD, separated));
+
+		//㿪ʼӴͷʱ䣬ûƶ·Ч
+		SimdFloat oneOverD = simdDiv(one, d[k]);
+		SimdFloat enter = simdMul(simdSub(stationaryMin, movingMax), oneOverD);
+		SimdFloat leave = simdMul(simdSub(stationaryMax, movingMin), oneOverD);
+		//enter > leave ʱ
+		SimdFloat first = simdMin(leave, enter);
+		SimdFloat second = simdMax(enter, leave);
+		tEnter = simdSelect(zeroD, tEnter, simdMax(first, tEnter));
+		tLeave = simdSelect(zeroD, tLeave, simdMin(second, tLeave));
+	}
+	miss = simdOr(miss, simdCmpGt(tEnter, tLeave));
+	return simdSelect(miss, simdSet(kNoIntersection), tEnter);
+}
+
+//nAABBĲ
+void intersectMovingAABBs(const AABB3Array& stationaryBoxes, const AABB3Array& movingBoxes, const Vector3Array& d,
+	float* t) {
+	assert(stationaryBoxes.size() == movingBoxes.size());
+	assert(stationaryBoxes.size() == d.size());
+	const size_t n = stationaryBoxes.size();
+	//6ֹAABB6˶AABB3λƵ
+	const float* src[15] = {
+		stationaryBoxes.min.x, stationaryBoxes.min.y, stationaryBoxes.min.z,
+		stationaryBoxes.max.x, stationaryBoxes.max.y, stationaryBoxes.max.z,
+		movingBoxes.min.x, movingBoxes.min.y, movingBoxes.min.z,
+		movingBoxes.max.x, movingBoxes.max.y, movingBoxes.max.z,
+		d.x, d.y, d.z
+	};
+
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat r[15];
+		for (int k = 0; k < 15; ++k) {
+			r[k] = simdLoadAligned(src[k] + i);
+		}
+		simdStore(t + i, simdIntersectMovingBox(r, r + 6, r + 12));
+	}
+	if (i < n) {
+		//ʣ²һĲԶԸƵʱУ㣬ֻдЧ
+		const size_t count = n - i;
+		float temp[15][kSimdWidth] = {};
+		for (size_t j = 0; j < count; ++j) {
+			for (int k = 0; k < 15; ++k) {
+				temp[k][j] = src[k][i + j];
+			}
+		}
+		SimdFloat r[15];
+		for (int k = 0; k < 15; ++k) {
+			r[k] = simdLoad(temp[k]);
+		}
+		simdStore(temp[0], simdIntersectMovingBox(r, r + 6, r + 12));
+		for (size_t j = 0; j < count; ++j) {
+			t[i + j] = temp[0][j];
+		}
+	}
+}
+
+//ÿһ·±ƫ 012...±
+static SimdFloat simdLaneIndex() {
+	float index[kSimdWidth];
+	for (size_t j = 0; j < kSimdWidth; ++j) {
+		index[j] = (float)j;
+	}
+	return simdLoad(index);
+}
+
+//ÿһ·ֱСt±꣬tͬʱȳֵģҲ±С
+//±float棬2^24ʱǾȷ
+static inline void simdKeepEarliest(SimdFloat t, SimdFloat index, SimdFloat* bestT, SimdFloat* bestIndex) {
+	SimdFloat earlier = simdCmpLt(t, *bestT);
+	*bestT = simdSelect(earlier, t, *bestT);
+	*bestIndex = simdSelect(earlier, index, *bestIndex);
+}
+
+//ڸ·ĽѡСttͬʱȡ±С
+//ûཻʱkNoIntersection±Ϊ-1
+static float earliestOfLanes(SimdFloat bestT, SimdFloat bestIndex, int* returnIndex) {
+	float t[kSimdWidth], index[kSimdWidth];
+	simdStore(t, bestT);
+	simdStore(index, bestIndex);
+	float resultT = kNoIntersection;
+	int resultIndex = -1;
+	for (size_t j = 0; j < kSimdWidth; ++j) {
+		if (t[j] < resultT || (t[j] == resultT && resultIndex >= 0 && (int)index[j] < resultIndex)) {
+			resultT = t[j];
+			resultIndex = (int)index[j];
+		}
+	}
+	if (returnIndex != NULL) {
+		*returnIndex = resultIndex;
+	}
+	return resultT;
+}
+
+//һ˶AABBnֹAABBĲԣֻཻ
+float intersectMovingAABB(const AABB3Array& stationaryBoxes, const AABB3& movingBox, const Vector3& d,
+	int* returnIndex) {
+	const size_t n = stationaryBoxes.size();
+	assert(n <= (1 << 24));
+	const SimdFloat moving[6] = {
+		simdSet(movingBox.min.x), simdSet(movingBox.min.y), simdSet(movingBox.min.z),
+		simdSet(movingBox.max.x), simdSet(movingBox.max.y), simdSet(movingBox.max.z)
+	};
+	const SimdFloat delta[3] = { simdSet(d.x), simdSet(d.y), simdSet(d.z) };
+	const float* src[6] = {
+		stationaryBoxes.min.x, stationaryBoxes.min.y, stationaryBoxes.min.z,
+		stationaryBoxes.max.x, stationaryBoxes.max.y, stationaryBoxes.max.z
+	};
+	const SimdFloat step = simdSet((float)kSimdWidth);
+	SimdFloat index = simdLaneIndex();
+	SimdFloat bestT = simdSet(kNoIntersection);
+	SimdFloat bestIndex = simdSet(-1.0f);
+
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat stationary[6];
+		for (int k = 0; k < 6; ++k) {
+			stationary[k] = simdLoadAligned(src[k] + i);
+		}
+		simdKeepEarliest(simdIntersectMovingBox(stationary, moving, delta), index, &bestT, &bestIndex);
+		index = simdAdd(index, step);
+	}
+	if (i < n) {
+		//ʣ²һAABBƵʱУ㣬ϵ·Ƚ
+		const size_t count = n - i;
+		float temp[6][kSimdWidth] = {};
+		float valid[kSimdWidth] = {};
+		for (size_t j = 0; j < count; ++j) {
+			for (int k = 0; k < 6; ++k) {
+				temp[k][j] = src[k][i + j];
+			}
+			valid[j] = 1.0f;
+		}
+		SimdFloat stationary[6];
+		for (int k = 0; k < 6; ++k) {
+			stationary[k] = simdLoad(temp[k]);
+		}
+		SimdFloat t = simdIntersectMovingBox(stationary, moving, delta);
+		t = simdSelect(simdCmpGt(simdLoad(valid), simdZero()), t, simdSet(kNoIntersection));
+		simdKeepEarliest(t, index, &bestT, &bestIndex);
+	}
+	return earliestOfLanes(bestT, bestIndex, returnIndex);
+}
+
+//˶AABBཻ
+void earliestHits(const float* t, const int* firstPair, size_t moverCount, float* returnT, int* returnPair) {
+	const SimdFloat step = simdSet((float)kSimdWidth);
+	const SimdFloat laneIndex = simdLaneIndex();
+	for (size_t k = 0; k < moverCount; ++k) {
+		const int first = firstPair[k];
+		const size_t count = (size_t)(firstPair[k + 1] - first);
+		assert(firstPair[k + 1] >= first);
+		assert(count <= (1 << 24));
+		const float* pairT = t + first;
+		//±first
+		SimdFloat index = laneIndex;
+		SimdFloat bestT = simdSet(kNoIntersection);
+		SimdFloat bestIndex = simdSet(-1.0f);
+
+		const size_t simdEnd = count - count % kSimdWidth;
+		size_t i = 0;
+		for (; i < simdEnd; i += kSimdWidth) {
+			simdKeepEarliest(simdLoad(pairT + i), index, &bestT, &bestIndex);
+			index = simdAdd(index, step);
+		}
+		if (i < count) {
+			float temp[kSimdWidth];
+			for (size_t j = 0; j < kSimdWidth; ++j) {
+				temp[j] = i + j < count ? pairT[i + j] : kNoIntersection;
+			}
+			simdKeepEarliest(simdLoad(temp), index, &bestT, &bestIndex);
+		}
+		int index0;
+		returnT[k] = earliestOfLanes(bestT, bestIndex, &index0);
+		if (returnPair != NULL) {
+			returnPair[k] = index0 >= 0 ? first + index0 : -1;
+		}
+	}
+}
+
+//һԽλbitsдmaskindicesУfirstΪһһAABB±
+//kSimdWidth32һĽmaskԪ
+static inline size_t appendSelected(int bits, size_t first, uint32_t* mask, int* indices, size_t count) {
+	if (mask != NULL) {
+		if (first % 32 == 0) {
+			mask[first / 32] = 0;
+		}
+		mask[first / 32] |= (uint32_t)bits << (first % 32);
+	}
+	if (indices == NULL) {
+		//ÿȥ͵һ1
+		for (; bits != 0; bits &= bits - 1) {
+			++count;
+		}
+		return count;
+	}
+	for (int j = 0; bits != 0; ++j, bits >>= 1) {
+		if (bits & 1) {
+			indices[count++] = (int)(first + j);
+		}
+	}
+	return count;
+}
+
+//ÿAABBtest()õλ룬jλΪ1ʾj·
+//ʣ²һAABBƵʱУ㣬ϵ·Ľȥ
+template <typename Test>
+static size_t selectBoxes(const AABB3Array& boxes, Test test, uint32_t* mask, int* indices) {
+	const size_t n = boxes.size();
+	const float* src[6] = {
+		boxes.min.x, boxes.min.y, boxes.min.z,
+		boxes.max.x, boxes.max.y, boxes.max.z
+	};
+	size_t count = 0;
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat box[6];
+		for (int k = 0; k < 6; ++k) {
+			box[k] = simdLoadAligned(src[k] + i);
+		}
+		count = appendSelected(test(box), i, mask, indices, count);
+	}
+	if (i < n) {
+		float temp[6][kSimdWidth] = {};
+		for (size_t j = i; j < n; ++j) {
+			for (int k = 0; k < 6; ++k) {
+				temp[k][j - i] = src[k][j];
+			}
+		}
+		SimdFloat box[6];
+		for (int k = 0; k < 6; ++k) {
+			box[k] = simdLoad(temp[k]);
+		}
+		int valid = (1 << (n - i)) - 1;
+		count = appendSelected(test(box) & valid, i, mask, indices, count);
+	}
+	return count;
+}
+
+//ÿһάpƵAABBϣAABB3::closestPointTo()ķ֧ͬAABBΪʱҲһ
+static inline SimdFloat simdClosestCoord(SimdFloat p, SimdFloat boxMin, SimdFloat boxMax) {
+	return simdSelect(simdCmpLt(p, boxMin), boxMin, simdSelect(simdCmpGt(p, boxMax), boxMax, p));
+}
+
+//pAABB
+size_t contains(const AABB3Array& boxes, const Vector3& p, uint32_t* mask, int* indices) {
+	const SimdFloat px = simdSet(p.x), py = simdSet(p.y), pz = simdSet(p.z);
+	return selectBoxes(boxes, [&](const SimdFloat* box) {
+		SimdFloat inside = simdAnd(simdCmpGe(px, box[0]), simdCmpLe(px, box[3]));
+		inside = simdAnd(inside, simdAnd(simdCmpGe(py, box[1]), simdCmpLe(py, box[4])));
+		inside = simdAnd(inside, simdAnd(simdCmpGe(pz, box[2]), simdCmpLe(pz, box[5])));
+		return simdMoveMask(inside);
+	}, mask, indices);
+}
+
+//ཻAABB
+size_t intersectsSphere(const AABB3Array& boxes, const Vector3& center, float radius, uint32_t* mask, int* indices) {
+	const SimdFloat cx = simdSet(center.x), cy = simdSet(center.y), cz = simdSet(center.z);
+	const SimdFloat radiusSquared = simdSet(radius * radius);
+	return selectBoxes(boxes, [&](const SimdFloat* box) {
+		SimdFloat dx = simdSub(cx, simdClosestCoord(cx, box[0], box[3]));
+		SimdFloat dy = simdSub(cy, simdClosestCoord(cy, box[1], box[4]));
+		SimdFloat dz = simdSub(cz, simdClosestCoord(cz, box[2], box[5]));
+		SimdFloat distanceSquared = simdAdd(simdAdd(simdMul(dx, dx), simdMul(dy, dy)), simdMul(dz, dz));
+		return simdMoveMask(simdCmpLt(distanceSquared, radiusSquared));
+	}, mask, indices);
+}
+
+//boxཻAABB
+//intersectAABBs()һжÿһάǷ룬NaNʱȽΪ٣
+size_t intersectAABBs(const AABB3Array& boxes, const AABB3& box, uint32_t* mask, int* indices) {
+	const SimdFloat minX = simdSet(box.min.x), minY = simdSet(box.min.y), minZ = simdSet(box.min.z);
+	const SimdFloat maxX = simdSet(box.max.x), maxY = simdSet(box.max.y), maxZ = simdSet(box.max.z);
+	return selectBoxes(boxes, [&](const SimdFloat* other) {
+		SimdFloat separated = simdOr(simdCmpGt(minX, other[3]), simdCmpLt(maxX, other[0]));
+		separated = simdOr(separated, simdOr(simdCmpGt(minY, other[4]), simdCmpLt(maxY, other[1])));
+		separated = simdOr(separated, simdOr(simdCmpGt(minZ, other[5]), simdCmpLt(maxZ, other[2])));
+		return ~simdMoveMask(separated) & kSimdAllTrue;
+	}, mask, indices);
+}
+
+//nAABBpĵ
+void closestPointTo(const AABB3Array& boxes, const Vector3& p, Vector3Array* out) {
+	const size_t n = boxes.size();
+	out->resize(n);
+	const SimdFloat px = simdSet(p.x), py = simdSet(p.y), pz = simdSet(p.z);
+	//㣬ҪһĲ
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		simdStoreAligned(out->x + i, simdClosestCoord(px, simdLoadAligned(boxes.min.x + i), simdLoadAligned(boxes.max.x + i)));
+		simdStoreAligned(out->y + i, simdClosestCoord(py, simdLoadAligned(boxes.min.y + i), simdLoadAligned(boxes.max.y + i)));
+		simdStoreAligned(out->z + i, simdClosestCoord(pz, simdLoadAligned(boxes.min.z + i), simdLoadAligned(boxes.max.z + i)));
+	}
+	for (; i < n; ++i) {
+		out->x[i] = p.x < boxes.min.x[i] ? boxes.min.x[i] : (p.x > boxes.max.x[i] ? boxes.max.x[i] : p.x);
+		out->y[i] = p.y < boxes.min.y[i] ? boxes.min.y[i] : (p.y > boxes.max.y[i] ? boxes.max.y[i] : p.y);
+		out->z[i] = p.z < boxes.min.z[i] ? boxes.min.z[i] : (p.z > boxes.max.z[i] ? boxes.max.z[i] : p.z);
+	}
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#ifndef __AABB3ARRAY_H_INCLUDED__
+#define __AABB3ARRAY_H_INCLUDED__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Vector3Array.h"
+
+template <typename T> class Vector3T;
+typedef Vector3T<float> Vector3;
+template <typename T> class AABB3T;
+typedef AABB3T<float> AABB3;
+template <typename T> class Matrix4x3T;
+typedef Matrix4x3T<float> Matrix4x3;
+
+// ƣAABB
+// ߣcary
+// SoAʽһα߽minmaxֱһVector3Array
+//		ںʹAABBཻԲ
+
+class AABB3Array
+{
+public:
+	Vector3Array min;
+	Vector3Array max;
+
+	AABB3Array() {}
+	explicit AABB3Array(size_t n) :min(n), max(n) {}
+
+	//AABB
+	size_t size() const { return min.size(); }
+
+	//ıAABBԭеݱĲδʼ
+	void resize(size_t n) {
+		min.resize(n);
+		max.resize(n);
+	}
+
+	//дAABB
+	AABB3 get(size_t i) const;
+	void set(size_t i, const AABB3& box);
+
+	//AoS֮ת
+	//box[0..n)룬СΪn
+	void fromAABB3s(const AABB3* box, size_t n);
+	//дbox[0..size())
+	void toAABB3s(AABB3* box) const;
+};
+
+//ߺAABBཻԲԣʹ޷֧SIMDƽ壨slab㷨
+//AABB3::rayIntersect()ͬ
+//	Ϊ rayOrg + rayDelta * tt[0,1]֮
+//	ཻʱtAABBڲʱ0δཻʱkNoIntersection
+//	returnNoamalѡཻķڲʱΪ-rayDeltaĵλδཻʱΪ
+//͵汾㷽ʽͬԷĵtмulpĲ
+
+//nߺһAABBཻԲԣÿβkSimdWidth48
+//t Ҫ rayOrg.size() Ԫ
+void rayIntersect(const AABB3& box, const Vector3Array& rayOrg, const Vector3Array& rayDelta,
+	float* t, Vector3Array* returnNoamal = 0);
+
+//һߺnAABBཻԲԣÿβkSimdWidth48AABB
+//rayDeltaInv ΪrayDeltaĵɵԤȼ㣬ΪʱӦΪ1.0f / 0.0f
+//t Ҫ boxes.size() Ԫ
+void rayIntersect(const AABB3Array& boxes, const Vector3& rayOrg, const Vector3& rayDelta, const Vector3& rayDeltaInv,
+	float* t, Vector3Array* returnNoamal = 0);
+
+//任AABBout[i] Ϊ in[i] 任AABBAABB3::setToTransFormedBox()λһ
+//ÿα任kSimdWidth48AABBoutĴСͬout Ժ in ͬһ
+//յAABB任ΪգAABB3::empty()ֵͬ
+
+//ÿAABBʹøԵľm Ҫ in.size() Ԫ
+void transformBoxes(const AABB3Array& in, AABB3Array* out, const Matrix4x3* m);
+//AABBʹͬһ
+void transformBoxes(const AABB3Array& in, AABB3Array* out, const Matrix4x3& m);
+
+//˶AABB;ֹAABBཻ̬ԲԣÿβkSimdWidth48
+//intersectMovingAABB()ͬ˳Ҳͬλһ£
+//	d Ϊ˶AABBһʱڵλƣཻʱĲֵt[0,1]֮䣩δཻʱkNoIntersection
+
+//nAABBĲԣt[i] = intersectMovingAABB(stationaryBoxes[i], movingBoxes[i], d[i])
+//ĴСͬt Ҫ stationaryBoxes.size() Ԫ
+void intersectMovingAABBs(const AABB3Array& stationaryBoxes, const AABB3Array& movingBoxes, const Vector3Array& d,
+	float* t);
+
+//һ˶AABBnֹAABBĲԣֻཻ
+//СtδκAABBཻʱkNoIntersection
+//returnIndex ѡཻAABB±꣬tͬʱȡ±СģδཻʱΪ-1
+float intersectMovingAABB(const AABB3Array& stationaryBoxes, const AABB3& movingBox, const Vector3& d,
+	int* returnIndex = 0);
+
+//intersectMovingAABBs()Ľ˶AABBཻ
+//ͬһ˶AABBвԶԱڣk˶AABBĲԶΪ[firstPair[k], firstPair[k + 1])
+//	firstPair  moverCount + 1 Ԫ
+//returnT[k] Ϊk˶AABBСtûཻʱΪkNoIntersection
+//returnPair ѡཻĲԶԵ±꣬tͬʱȡ±СģûཻʱΪ-1
+void earliestHits(const float* t, const int* firstPair, size_t moverCount, float* returnT, int* returnPair = 0);
+
+//һѯnAABBԣÿβkSimdWidth48AABBAABB3жӦĺͬ
+//ΪλAABB±꣬ǿѡģAABB
+//	mask Ҫ (boxes.size() + 31) / 32 ԪأiAABBĽ mask[i / 32] ĵ i % 32 λλΪ0
+//	indices Ҫ boxes.size() ԪأС˳дAABB±
+
+//pAABB3::contains()AABB͵汾һ
+size_t contains(const AABB3Array& boxes, const Vector3& p, uint32_t* mask = 0, int* indices = 0);
+//ཻAABB3::intersectsSphere()AABB͵汾һ
+size_t intersectsSphere(const AABB3Array& boxes, const Vector3& center, float radius, uint32_t* mask = 0, int* indices = 0);
+//boxཻintersectAABBs()AABB͵汾һ
+size_t intersectAABBs(const AABB3Array& boxes, const AABB3& box, uint32_t* mask = 0, int* indices = 0);
+
+//nAABBpĵ㣨AABB3::closestPointTo()͵汾λһ
+//outĴСboxesͬ
+void closestPointTo(const AABB3Array& boxes, const Vector3& p, Vector3Array* out);
+
+#endif // #ifndef __AABB3ARRAY_H_INCLUDED__
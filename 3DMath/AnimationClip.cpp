@@ -0,0 +1,162 @@
+#include <assert.h>
+#include <algorithm>
+
+#include "AnimationClip.h"
+#include "SimdUtil.h"
+
+// ƣƬ
+// ߣcary
+// αǲֵk times[k] <= time < times[k + 1]k [0, count - 2]֮䣬
+//		time ڵһؼ֮֡ǰʱΪ0һؼ֮֡ʱΪcount - 2ֵ[0,1]֮
+
+//αԲҵΪֲ
+const uint32_t kMaxCursorSteps = 4;
+
+//һת
+int AnimationClip::addRotationTrack(const float* times, const Quaternion* keys, size_t count) {
+	assert(count >= 1);
+	Track track = { (uint32_t)rotationTimes.size(), (uint32_t)count };
+	for (size_t k = 0; k < count; ++k) {
+		assert(k == 0 || times[k] > times[k - 1]);
+		rotationTimes.push_back(times[k]);
+		rotationKeys.push_back(keys[k]);
+	}
+	rotationTracks.push_back(track);
+	return (int)rotationTracks.size() - 1;
+}
+
+//һƽƹ
+int AnimationClip::addTranslationTrack(const float* times, const Vector3* keys, size_t count) {
+	assert(count >= 1);
+	Track track = { (uint32_t)translationTimes.size(), (uint32_t)count };
+	for (size_t k = 0; k < count; ++k) {
+		assert(k == 0 || times[k] > times[k - 1]);
+		translationTimes.push_back(times[k]);
+		translationKeys.push_back(keys[k]);
+	}
+	translationTracks.push_back(track);
+	return (int)translationTracks.size() - 1;
+}
+
+//һؼ֡ʱ
+float AnimationClip::duration() const {
+	float d = 0.0f;
+	for (size_t i = 0; i < rotationTracks.size(); ++i) {
+		d = std::max(d, rotationTimes[rotationTracks[i].first + rotationTracks[i].count - 1]);
+	}
+	for (size_t i = 0; i < translationTracks.size(); ++i) {
+		d = std::max(d, translationTimes[translationTracks[i].first + translationTracks[i].count - 1]);
+	}
+	return d;
+}
+
+//α꿪ʼtimeڵĲֵ䣬times ΪһĹؼ֡ʱ䣬count Ϊ2
+//ƽkMaxCursorStepsؼ֡ʱԲңʣµķΧжֲ
+static uint32_t findKey(const float* times, uint32_t count, float time, uint32_t cursor) {
+	const uint32_t last = count - 2;
+	assert(cursor <= last);
+	if (time < times[cursor]) {
+		//ʱ䵹ˣα֮ǰֲ
+		return cursor == 0 ? 0 : (uint32_t)(std::upper_bound(times + 1, times + cursor, time) - times) - 1;
+	}
+	uint32_t k = cursor;
+	for (uint32_t step = 0; step < kMaxCursorSteps; ++step) {
+		if (k == last || time < times[k + 1]) {
+			return k;
+		}
+		++k;
+	}
+	return (uint32_t)(std::upper_bound(times + k + 1, times + last + 1, time) - times) - 1;
+}
+
+//ֵ[0,1]֮
+static float keyFraction(const float* times, uint32_t k, float time) {
+	float t = (time - times[k]) / (times[k + 1] - times[k]);
+	return t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+}
+
+//Բֵout[i] = v0[i] + (v1[i] - v0[i]) * t[i]
+static void lerpBatch(const Vector3* v0, const Vector3* v1, const float* t, Vector3* out, size_t n) {
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat ax, ay, az, bx, by, bz;
+		simdLoadXYZ(&v0[i].x, &ax, &ay, &az);
+		simdLoadXYZ(&v1[i].x, &bx, &by, &bz);
+		SimdFloat vt = simdLoad(t + i);
+		simdStoreXYZ(&out[i].x,
+			simdAdd(ax, simdMul(simdSub(bx, ax), vt)),
+			simdAdd(ay, simdMul(simdSub(by, ay), vt)),
+			simdAdd(az, simdMul(simdSub(bz, az), vt)));
+	}
+	for (; i < n; ++i) {
+		out[i] = Vector3(
+			v0[i].x + (v1[i].x - v0[i].x) * t[i],
+			v0[i].y + (v1[i].y - v0[i].y) * t[i],
+			v0[i].z + (v1[i].z - v0[i].z) * t[i]);
+	}
+}
+
+//һʵαꡢռؼ֡ٶȫֵ
+//ʵ汾ʹԽλһ
+void AnimationClip::sampleInstance(float time, uint32_t* cursors, Quaternion* rotations, Vector3* translations,
+	Scratch& scratch) const {
+	const size_t rotationCount = rotationTracks.size();
+	for (size_t i = 0; i < rotationCount; ++i) {
+		const Track& track = rotationTracks[i];
+		const float* times = &rotationTimes[track.first];
+		const Quaternion* keys = &rotationKeys[track.first];
+		if (track.count == 1) {
+			scratch.q0[i] = scratch.q1[i] = keys[0];
+			scratch.rotationT[i] = 0.0f;
+			continue;
+		}
+		uint32_t k = findKey(times, track.count, time, cursors[i]);
+		cursors[i] = k;
+		scratch.q0[i] = keys[k];
+		scratch.q1[i] = keys[k + 1];
+		scratch.rotationT[i] = keyFraction(times, k, time);
+	}
+	slerpBatch(scratch.q0.data(), scratch.q1.data(), scratch.rotationT.data(), rotations, rotationCount);
+
+	const size_t translationCount = translationTracks.size();
+	uint32_t* translationCursors = cursors + rotationCount;
+	for (size_t i = 0; i < translationCount; ++i) {
+		const Track& track = translationTracks[i];
+		const float* times = &translationTimes[track.first];
+		const Vector3* keys = &translationKeys[track.first];
+		if (track.count == 1) {
+			scratch.v0[i] = scratch.v1[i] = keys[0];
+			scratch.translationT[i] = 0.0f;
+			continue;
+		}
+		uint32_t k = findKey(times, track.count, time, translationCursors[i]);
+		translationCursors[i] = k;
+		scratch.v0[i] = keys[k];
+		scratch.v1[i] = keys[k + 1];
+		scratch.translationT[i] = keyFraction(times, k, time);
+	}
+	lerpBatch(scratch.v0.data(), scratch.v1.data(), scratch.translationT.data(), translations, translationCount);
+}
+
+//һʵ
+void AnimationClip::sample(float time, uint32_t* cursors, Quaternion* rotations, Vector3* translations) const {
+	sample(&time, cursors, 1, rotations, translations);
+}
+
+//ʱֻһ
+void AnimationClip::sample(const float* times, uint32_t* cursors, size_t instanceCount,
+	Quaternion* rotations, Vector3* translations) const {
+	Scratch scratch;
+	scratch.q0.resize(rotationTracks.size());
+	scratch.q1.resize(rotationTracks.size());
+	scratch.rotationT.resize(rotationTracks.size());
+	scratch.v0.resize(translationTracks.size());
+	scratch.v1.resize(translationTracks.size());
+	scratch.translationT.resize(translationTracks.size());
+	const size_t stride = cursorCount();
+	for (size_t i = 0; i < instanceCount; ++i) {
+		sampleInstance(times[i], cursors + i * stride,
+			rotations + i * rotationTracks.size(), translations + i * translationTracks.size(), scratch);
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#ifndef __ANIMATIONCLIP_H_INCLUDED__
+#define __ANIMATIONCLIP_H_INCLUDED__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "Quaternion.h"
+#include "Vector3.h"
+
+// ƣƬ
+// ߣcary
+// ؼ֡ɵĶƬΣתĹؼ֡Quaternionslerpֵ
+//		ƽƹĹؼ֡Vector3Բֵ
+//		ؼ֡ʱֵֿ棨SoAͬһʱֱֵһ
+//
+//		ÿʵһα꣬¼ÿϴʹõĹؼ֡
+//		ʱǰƽʱα꿪ʼңһ㲻Ҫƶֻƶһؼ̯֡O(1)
+//		ǰƽ̫ʱ䵹ʱתѭöֲ
+//		αɵ߱棬ÿʵ cursorCount() uint32_tȫ0ΪЧĳʼֵ
+//
+//		һμܶʵȫÿʵα꣬
+//		ռڵؼ֡ͲֵٶƬεĹһslerpBatch()ֵ
+
+class AnimationClip
+{
+public:
+	AnimationClip() {}
+
+	//ӹعͬһе±
+	//times ؼ֡ʱ䣬С˳򣬲ͬʱ䣬count Ϊ1
+	//ֻһؼ֡ʱǳ
+	int addRotationTrack(const float* times, const Quaternion* keys, size_t count);
+	int addTranslationTrack(const float* times, const Vector3* keys, size_t count);
+
+	size_t rotationTrackCount() const { return rotationTracks.size(); }
+	size_t translationTrackCount() const { return translationTracks.size(); }
+	//ÿʵαתǰƽƹں
+	size_t cursorCount() const { return rotationTracks.size() + translationTracks.size(); }
+	//һؼ֡ʱ
+	float duration() const;
+
+	//һʵ
+	//time ڵһؼ֮֡ǰʱȡһؼ֡һؼ֮֡ʱȡһѭɵߴ
+	//cursors ʵα꣬cursorCount()
+	//rotations rotationTrackCount()Ԫأtranslations translationTrackCount()Ԫ
+	//ÿεöҪʱ飬ʵʱӦʹ汾
+	void sample(float time, uint32_t* cursors, Quaternion* rotations, Vector3* translations) const;
+
+	//instanceCountʵiʵ
+	//	ʱΪtimes[i]αΪ cursors[i * cursorCount()] ʼcursorCount()
+	//	Ϊ rotations[i * rotationTrackCount() + ]  translations[i * translationTrackCount() + ]
+	//ʵsample()λһ
+	void sample(const float* times, uint32_t* cursors, size_t instanceCount,
+		Quaternion* rotations, Vector3* translations) const;
+
+private:
+	struct Track {
+		//һؼ֡timeskeysе±
+		uint32_t first;
+		uint32_t count;
+	};
+
+	std::vector<Track> rotationTracks;
+	std::vector<float> rotationTimes;
+	std::vector<Quaternion> rotationKeys;
+
+	std::vector<Track> translationTracks;
+	std::vector<float> translationTimes;
+	std::vector<Vector3> translationKeys;
+
+	//ֵõʱ飬ÿʵÿһԪ
+	struct Scratch {
+		std::vector<Quaternion> q0, q1;
+		std::vector<Vector3> v0, v1;
+		std::vector<float> rotationT, translationT;
+	};
+
+	void sampleInstance(float time, uint32_t* cursors, Quaternion* rotations, Vector3* translations, Scratch& scratch) const;
+};
+
+#endif // #ifndef __ANIMATIONCLIP_H_INCLUDED__
@@ -0,0 +1,494 @@
+#include <assert.h>
+#include <float.h>
+#include <limits.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include "BVH.h"
+#include "Vector3.h"
+
+// ƣΰΧ
+// ߣcary
+// AABBɵĶΰΧУBounding Volume Hierarchy
+//
+//		죺
+//		ÿڵĵķΧڣxyzֳkBinCountӣ
+//		ÿܵķָλSAHʽƴۣ
+//			 = kTraversalCost + (߱ *  + ұ߱ * ұ) / ڵ
+//		ȡСķָֱΪҶӽڵ㣨Ϊ󣬾Ͳٷָ
+//		ԭػ֣ǰںÿе嶼
+//		϶µ̹߳죬вཻ
+//
+//		ѯ
+//		ʽջȱkMaxDepthڣջ
+
+//ĸ
+const int kBinCount = 16;
+//һڵĴۣԲһĴΪλ
+const float kTraversalCost = 1.0f;
+//ֵʱŻΪSAH۶ΪҶӽڵ
+const int kMaxLeafSize = 8;
+//ȣʱǿƳΪҶӽڵ
+const int kMaxDepth = 60;
+//ڸֵŻύµ̹߳
+const int kParallelThreshold = 4096;
+
+//ʱʹõϢֱӻ飬ڴ
+struct BuildPrimitive {
+	AABB3 box;
+	Vector3 center;
+	int index;
+};
+
+struct BVH::BuildState {
+	//бΪÿҶӽڵķΧ
+	std::vector<BuildPrimitive> primitives;
+	//һɷĽڵ
+	std::atomic<int> nextNode;
+	//߳
+	std::atomic<int> spareThreads;
+};
+
+static float axisValue(const Vector3& v, int axis) {
+	return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+//box󵽰otherAABB3::add()ͬûз֧
+//ʱÿҪϲʮΣ֧ԤʧܵĴۺܴ
+static void growBox(AABB3& box, const AABB3& other) {
+	box.min.x = std::min(box.min.x, other.min.x);
+	box.min.y = std::min(box.min.y, other.min.y);
+	box.min.z = std::min(box.min.z, other.min.z);
+	box.max.x = std::max(box.max.x, other.max.x);
+	box.max.y = std::max(box.max.y, other.max.y);
+	box.max.z = std::max(box.max.z, other.max.z);
+}
+
+static void growBox(AABB3& box, const Vector3& p) {
+	box.min.x = std::min(box.min.x, p.x);
+	box.min.y = std::min(box.min.y, p.y);
+	box.min.z = std::min(box.min.z, p.z);
+	box.max.x = std::max(box.max.x, p.x);
+	box.max.y = std::max(box.max.y, p.y);
+	box.max.z = std::max(box.max.z, p.z);
+}
+
+//һ룬ֻȽϴС
+static float halfArea(const AABB3& box) {
+	Vector3 d = box.max - box.min;
+	return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+//ڵ
+static int binIndex(float center, float low, float scale, int binCount) {
+	int b = (int)((center - low) * scale);
+	return b < 0 ? 0 : (b >= binCount ? binCount - 1 : b);
+}
+
+//boxes[0..n)죬ids[i]Ϊboxes[i]ûIDidsΪNULLʱ±iΪID
+void BVH::build(const AABB3* boxes, const int* ids, size_t n, unsigned threadCount) {
+	nodes.clear();
+	leafBoxes.clear();
+	leafIds.clear();
+	if (n == 0) {
+		return;
+	}
+	assert(n <= INT_MAX / 2);
+
+	if (threadCount == 0) {
+		threadCount = std::thread::hardware_concurrency();
+		if (threadCount == 0) {
+			threadCount = 1;
+		}
+	}
+
+	BuildState state;
+	state.primitives.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		state.primitives[i].box = boxes[i];
+		state.primitives[i].center = boxes[i].center();
+		state.primitives[i].index = (int)i;
+	}
+	state.nextNode = 1;
+	state.spareThreads = (int)threadCount - 1;
+
+	//ÿҶӽڵһ壬ڵᳬ2n-1
+	//Ԥȷãв·
+	nodes.resize(n * 2 - 1);
+	buildNode(state, 0, 0, (int)n, 0);
+	nodes.resize(state.nextNode);
+	nodes.shrink_to_fit();
+
+	leafBoxes.resize(n);
+	leafIds.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		int index = state.primitives[i].index;
+		leafBoxes[i] = boxes[index];
+		leafIds[i] = ids != NULL ? ids[index] : index;
+	}
+}
+
+//nodes[nodeIndex]state.primitives[first..first+count)е
+void BVH::buildNode(BuildState& state, int nodeIndex, int first, int count, int depth) {
+	Node& node = nodes[nodeIndex];
+	BuildPrimitive* primitives = &state.primitives[first];
+
+	//ڵAABBĵķΧ
+	AABB3 box, centerBox;
+	box.empty();
+	centerBox.empty();
+	for (int i = 0; i < count; ++i) {
+		growBox(box, primitives[i].box);
+		growBox(centerBox, primitives[i].center);
+	}
+	node.box = box;
+	node.first = first;
+	node.count = count;
+	if (count == 1 || depth >= kMaxDepth) {
+		return;
+	}
+
+	//ͬʱ䣬ѰSAHСķָλ
+	//ʱָλbʾ[0..b]ߣ[b+1..binCount)ұ
+	const int binCount = count < kBinCount ? count : kBinCount;
+	float low[3], scale[3];
+	AABB3 binBox[3][kBinCount];
+	int binSize[3][kBinCount];
+	for (int axis = 0; axis < 3; ++axis) {
+		low[axis] = axisValue(centerBox.min, axis);
+		float extent = axisValue(centerBox.max, axis) - low[axis];
+		scale[axis] = extent > 0.0f ? binCount / extent : 0.0f;
+		for (int b = 0; b < binCount; ++b) {
+			binBox[axis][b].empty();
+			binSize[axis][b] = 0;
+		}
+	}
+	for (int i = 0; i < count; ++i) {
+		for (int axis = 0; axis < 3; ++axis) {
+			int b = binIndex(axisValue(primitives[i].center, axis), low[axis], scale[axis], binCount);
+			growBox(binBox[axis][b], primitives[i].box);
+			++binSize[axis][b];
+		}
+	}
+
+	int bestAxis = -1;
+	int bestSplit = 0;
+	float bestCost = FLT_MAX;
+	for (int axis = 0; axis < 3; ++axis) {
+		//غϣ޷ָ
+		if (scale[axis] == 0.0f) {
+			continue;
+		}
+		//ۻұߵı
+		float rightArea[kBinCount - 1];
+		int rightCount[kBinCount - 1];
+		AABB3 sum;
+		sum.empty();
+		int sumCount = 0;
+		for (int b = binCount - 1; b > 0; --b) {
+			growBox(sum, binBox[axis][b]);
+			sumCount += binSize[axis][b];
+			rightArea[b - 1] = halfArea(sum);
+			rightCount[b - 1] = sumCount;
+		}
+		//ۻߵıͬʱ
+		sum.empty();
+		sumCount = 0;
+		for (int b = 0; b < binCount - 1; ++b) {
+			growBox(sum, binBox[axis][b]);
+			sumCount += binSize[axis][b];
+			if (sumCount == 0 || rightCount[b] == 0) {
+				continue;
+			}
+			float cost = halfArea(sum) * sumCount + rightArea[b] * rightCount[b];
+			if (cost < bestCost) {
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = b;
+			}
+		}
+	}
+
+	int middle;
+	if (bestAxis < 0) {
+		//ȫغϣмֳ
+		middle = count / 2;
+	}
+	else {
+		float area = halfArea(box);
+		float splitCost = kTraversalCost + (area > 0.0f ? bestCost / area : 0.0f);
+		if (count <= kMaxLeafSize && splitCost >= (float)count) {
+			return;
+		}
+		BuildPrimitive* split = std::partition(primitives, primitives + count, [&](const BuildPrimitive& p) {
+			return binIndex(axisValue(p.center, bestAxis), low[bestAxis], scale[bestAxis], binCount) <= bestSplit;
+		});
+		middle = (int)(split - primitives);
+	}
+
+	int left = state.nextNode.fetch_add(2);
+	node.first = left;
+	node.count = 0;
+
+	//϶ʱµ̣߳ǰ̹߳
+	bool spawn = false;
+	if (count >= kParallelThreshold) {
+		if (state.spareThreads.fetch_sub(1) > 0) {
+			spawn = true;
+		}
+		else {
+			state.spareThreads.fetch_add(1);
+		}
+	}
+	if (spawn) {
+		std::thread worker(&BVH::buildNode, this, std::ref(state), left, first, middle, depth + 1);
+		buildNode(state, left + 1, first + middle, count - middle, depth + 1);
+		worker.join();
+		state.spareThreads.fetch_add(1);
+	}
+	else {
+		buildNode(state, left, first, middle, depth + 1);
+		buildNode(state, left + 1, first + middle, count - middle, depth + 1);
+	}
+}
+
+//ȫAABBûʱءաAABB
+AABB3 BVH::bounds() const {
+	if (nodes.empty()) {
+		AABB3 box;
+		box.empty();
+		return box;
+	}
+	return nodes[0].box;
+}
+
+//ߺͽڵƽԣrayDeltaInvΪĵ
+//true[0,tMax]ںͽڵཻtEnterؽڵʱĲֵ
+//Ϊ㲢ƽʱõNaNȽϽΪfalse൱ںһά
+static bool raySlab(const AABB3& box, const Vector3& rayOrg, const Vector3& rayDeltaInv, float tMax, float* tEnter) {
+	float t0 = 0.0f;
+	float t1 = tMax;
+	float tNear, tFar;
+
+	tNear = ((rayDeltaInv.x < 0.0f ? box.max.x : box.min.x) - rayOrg.x) * rayDeltaInv.x;
+	tFar = ((rayDeltaInv.x < 0.0f ? box.min.x : box.max.x) - rayOrg.x) * rayDeltaInv.x;
+	if (tNear > t0) t0 = tNear;
+	if (tFar < t1) t1 = tFar;
+
+	tNear = ((rayDeltaInv.y < 0.0f ? box.max.y : box.min.y) - rayOrg.y) * rayDeltaInv.y;
+	tFar = ((rayDeltaInv.y < 0.0f ? box.min.y : box.max.y) - rayOrg.y) * rayDeltaInv.y;
+	if (tNear > t0) t0 = tNear;
+	if (tFar < t1) t1 = tFar;
+
+	tNear = ((rayDeltaInv.z < 0.0f ? box.max.z : box.min.z) - rayOrg.z) * rayDeltaInv.z;
+	tFar = ((rayDeltaInv.z < 0.0f ? box.min.z : box.max.z) - rayOrg.z) * rayDeltaInv.z;
+	if (tNear > t0) t0 = tNear;
+	if (tFar < t1) t1 = tFar;
+
+	*tEnter = t0;
+	return t0 <= t1;
+}
+
+//߲ѯAABB3::rayIntersect()ཻͬĲֵ
+float BVH::rayIntersect(const Vector3& rayOrg, const Vector3& rayDelta, int* returnId, Vector3* returnNoamal) const {
+	if (nodes.empty()) {
+		return kNoIntersection;
+	}
+	const Vector3 rayDeltaInv(1.0f / rayDelta.x, 1.0f / rayDelta.y, 1.0f / rayDelta.z);
+	float best = kNoIntersection;
+	int bestIndex = -1;
+
+	struct StackEntry {
+		int node;
+		float tEnter;
+	};
+	StackEntry stack[kMaxDepth + 4];
+	int top = 0;
+	float tEnter;
+	if (raySlab(nodes[0].box, rayOrg, rayDeltaInv, 1.0f, &tEnter)) {
+		stack[top].node = 0;
+		stack[top].tEnter = tEnter;
+		++top;
+	}
+
+	while (top > 0) {
+		--top;
+		//ջ֮Ѿҵ˸ཻ
+		if (stack[top].tEnter > best) {
+			continue;
+		}
+		const Node& node = nodes[stack[top].node];
+		if (node.count > 0) {
+			for (int i = node.first; i < node.first + node.count; ++i) {
+				float t = leafBoxes[i].rayIntersect(rayOrg, rayDelta);
+				if (t < best) {
+					best = t;
+					bestIndex = i;
+				}
+			}
+			continue;
+		}
+
+		//ӽڵջȱ
+		float tMax = best < 1.0f ? best : 1.0f;
+		float tLeft, tRight;
+		bool hitLeft = raySlab(nodes[node.first].box, rayOrg, rayDeltaInv, tMax, &tLeft);
+		bool hitRight = raySlab(nodes[node.first + 1].box, rayOrg, rayDeltaInv, tMax, &tRight);
+		if (hitLeft && hitRight) {
+			bool leftFirst = tLeft <= tRight;
+			stack[top].node = leftFirst ? node.first + 1 : node.first;
+			stack[top].tEnter = leftFirst ? tRight : tLeft;
+			++top;
+			stack[top].node = leftFirst ? node.first : node.first + 1;
+			stack[top].tEnter = leftFirst ? tLeft : tRight;
+			++top;
+		}
+		else if (hitLeft) {
+			stack[top].node = node.first;
+			stack[top].tEnter = tLeft;
+			++top;
+		}
+		else if (hitRight) {
+			stack[top].node = node.first + 1;
+			stack[top].tEnter = tRight;
+			++top;
+		}
+	}
+
+	if (bestIndex < 0) {
+		return kNoIntersection;
+	}
+	if (returnId != NULL) {
+		*returnId = leafIds[bestIndex];
+	}
+	if (returnNoamal != NULL) {
+		leafBoxes[bestIndex].rayIntersect(rayOrg, rayDelta, returnNoamal);
+	}
+	return best;
+}
+
+//leafBoxesеķΧ[first, last)
+//֮ǰԷֱҵ·ߵҶӽڵ㼴
+void BVH::subtreeRange(int nodeIndex, int* first, int* last) const {
+	int i = nodeIndex;
+	while (nodes[i].count == 0) {
+		i = nodes[i].first;
+	}
+	*first = nodes[i].first;
+	i = nodeIndex;
+	while (nodes[i].count == 0) {
+		i = nodes[i].first + 1;
+	}
+	*last = nodes[i].first + nodes[i].count;
+}
+
+void BVH::appendRange(int first, int last, std::vector<int>* result) const {
+	result->insert(result->end(), leafIds.begin() + first, leafIds.begin() + last);
+}
+
+//trueouterȫinner
+static bool containsAABB(const AABB3& outer, const AABB3& inner) {
+	return inner.min.x >= outer.min.x && inner.max.x <= outer.max.x
+		&& inner.min.y >= outer.min.y && inner.max.y <= outer.max.y
+		&& inner.min.z >= outer.min.z && inner.max.z <= outer.max.z;
+}
+
+//ҺboxཻintersectAABBs()壬ID׷ӵresultĩβ
+void BVH::queryAABB(const AABB3& box, std::vector<int>* result) const {
+	if (nodes.empty() || !intersectAABBs(nodes[0].box, box)) {
+		return;
+	}
+	int stack[kMaxDepth + 4];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		int index = stack[--top];
+		const Node& node = nodes[index];
+		//ڵ㶼ڲѯΧڣ
+		if (containsAABB(box, node.box)) {
+			int first, last;
+			subtreeRange(index, &first, &last);
+			appendRange(first, last, result);
+			continue;
+		}
+		if (node.count > 0) {
+			for (int i = node.first; i < node.first + node.count; ++i) {
+				if (intersectAABBs(leafBoxes[i], box)) {
+					result->push_back(leafIds[i]);
+				}
+			}
+			continue;
+		}
+		for (int child = node.first; child < node.first + 2; ++child) {
+			if (intersectAABBs(nodes[child].box, box)) {
+				stack[top++] = child;
+			}
+		}
+	}
+}
+
+//ҺཻAABB3::intersectsSphere()壬ID׷ӵresultĩβ
+void BVH::querySphere(const Vector3& center, float radius, std::vector<int>* result) const {
+	if (nodes.empty() || !nodes[0].box.intersectsSphere(center, radius)) {
+		return;
+	}
+	int stack[kMaxDepth + 4];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		const Node& node = nodes[stack[--top]];
+		if (node.count > 0) {
+			for (int i = node.first; i < node.first + node.count; ++i) {
+				if (leafBoxes[i].intersectsSphere(center, radius)) {
+					result->push_back(leafIds[i]);
+				}
+			}
+			continue;
+		}
+		for (int child = node.first; child < node.first + 2; ++child) {
+			if (nodes[child].box.intersectsSphere(center, radius)) {
+				stack[top++] = child;
+			}
+		}
+	}
+}
+
+//AABB3::classifyPlane()Ľֳ
+void BVH::classifyPlane(const Vector3& n, float d,
+	std::vector<int>* front, std::vector<int>* back, std::vector<int>* spanning) const {
+	if (nodes.empty()) {
+		return;
+	}
+	int stack[kMaxDepth + 4];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		int index = stack[--top];
+		const Node& node = nodes[index];
+		int side = node.box.classifyPlane(n, d);
+		//ƽһ
+		if (side != 0) {
+			std::vector<int>* result = side > 0 ? front : back;
+			if (result != NULL) {
+				int first, last;
+				subtreeRange(index, &first, &last);
+				appendRange(first, last, result);
+			}
+			continue;
+		}
+		if (node.count > 0) {
+			for (int i = node.first; i < node.first + node.count; ++i) {
+				int leafSide = leafBoxes[i].classifyPlane(n, d);
+				std::vector<int>* result = leafSide > 0 ? front : (leafSide < 0 ? back : spanning);
+				if (result != NULL) {
+					result->push_back(leafIds[i]);
+				}
+			}
+			continue;
+		}
+		stack[top++] = node.first;
+		stack[top++] = node.first + 1;
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#ifndef __BVH_H_INCLUDED__
+#define __BVH_H_INCLUDED__
+
+#include <stddef.h>
+#include <vector>
+#include "AABB3.h"
+
+// ƣΰΧ
+// ߣcary
+// AABBɵĶΰΧУBounding Volume Hierarchy
+//		ߡAABBƽѯÿһAABBһûIDʾ
+//		÷䣨binnedSAH죬ϴ䵽߳ϲй
+//		֮Ǿ̬ģƶ֮Ҫ¹
+
+class BVH
+{
+public:
+	BVH() {}
+
+	//boxes[0..n)죬ids[i]Ϊboxes[i]ûIDidsΪNULLʱ±iΪID
+	//threadCount ʱʹõ߳0ʾʹȫӲ߳
+	void build(const AABB3* boxes, const int* ids, size_t n, unsigned threadCount = 0);
+
+	//
+	size_t size() const { return leafIds.size(); }
+	//ڵ
+	size_t nodeCount() const { return nodes.size(); }
+	//ȫAABBûʱءաAABB
+	AABB3 bounds() const;
+
+	//߲ѯAABB3::rayIntersect()ཻͬĲֵδཻʱkNoIntersection
+	//returnId ѡཻID
+	//returnNoamal ѡཻķ
+	float rayIntersect(const Vector3& rayOrg, const Vector3& rayDelta, int* returnId = 0, Vector3* returnNoamal = 0) const;
+
+	//ҺboxཻintersectAABBs()壬ID׷ӵresultĩβ
+	void queryAABB(const AABB3& box, std::vector<int>* result) const;
+	//ҺཻAABB3::intersectsSphere()壬ID׷ӵresultĩβ
+	void querySphere(const Vector3& center, float radius, std::vector<int>* result) const;
+	//AABB3::classifyPlane()Ľֳ飬IDֱ׷ӵӦĩβ
+	//front ȫƽ棬back ȫƽ汳棬spanning ƽ棬ΪNULLʱռ
+	//ƽһʱ
+	void classifyPlane(const Vector3& n, float d,
+		std::vector<int>* front, std::vector<int>* back, std::vector<int>* spanning) const;
+
+private:
+	struct Node {
+		AABB3 box;
+		//Ҷӽڵ㣺һleafBoxesе±
+		//ڲڵ㣺ӽڵ±꣬ӽڵ
+		int first;
+		//ҶӽڵеڲڵΪ0
+		int count;
+	};
+	struct BuildState;
+
+	//ڵ㣬nodes[0]Ϊڵ
+	std::vector<Node> nodes;
+	//Ҷӽڵ˳е壬ÿе
+	std::vector<AABB3> leafBoxes;
+	std::vector<int> leafIds;
+
+	void buildNode(BuildState& state, int nodeIndex, int first, int count, int depth);
+	//leafBoxesеķΧ[first, last)
+	void subtreeRange(int nodeIndex, int* first, int* last) const;
+	void appendRange(int first, int last, std::vector<int>* result) const;
+};
+
+#endif // #ifndef __BVH_H_INCLUDED__
@@ -0,0 +1,64 @@
+#include <assert.h>
+
+#include "CameraRelative.h"
+#include "Vector3.h"
+#include "Matrix4x3.h"
+#include "AABB3.h"
+
+// ƣ
+// ߣcary
+// double½УֻתһΪfloat
+//		ѭûз֧԰doublefloatת
+
+//p - originתΪfloat
+void rebasePoints(const Vector3d* in, const Vector3d& origin, Vector3* out, size_t n) {
+	assert(n == 0 || (in != NULL && out != NULL));
+	for (size_t i = 0; i < n; ++i) {
+		out[i].x = (float)(in[i].x - origin.x);
+		out[i].y = (float)(in[i].y - origin.y);
+		out[i].z = (float)(in[i].z - origin.z);
+	}
+}
+
+//ֲľתΪֲľ
+void rebaseMatrices(const Matrix4x3d* in, const Vector3d& origin, Matrix4x3* out, size_t n) {
+	assert(n == 0 || (in != NULL && out != NULL));
+	for (size_t i = 0; i < n; ++i) {
+		const Matrix4x3d& m = in[i];
+		Matrix4x3& r = out[i];
+		r.m11 = (float)m.m11; r.m12 = (float)m.m12; r.m13 = (float)m.m13;
+		r.m21 = (float)m.m21; r.m22 = (float)m.m22; r.m23 = (float)m.m23;
+		r.m31 = (float)m.m31; r.m32 = (float)m.m32; r.m33 = (float)m.m33;
+		r.tx = (float)(m.tx - origin.x);
+		r.ty = (float)(m.ty - origin.y);
+		r.tz = (float)(m.tz - origin.z);
+	}
+}
+
+//ռAABBתΪoriginAABB
+//յAABBֵΪ1e37ȥoriginfloatķΧڣminmax
+void rebaseBoxes(const AABB3d* in, const Vector3d& origin, AABB3* out, size_t n) {
+	assert(n == 0 || (in != NULL && out != NULL));
+	for (size_t i = 0; i < n; ++i) {
+		out[i].min.x = (float)(in[i].min.x - origin.x);
+		out[i].min.y = (float)(in[i].min.y - origin.y);
+		out[i].min.z = (float)(in[i].min.z - origin.z);
+		out[i].max.x = (float)(in[i].max.x - origin.x);
+		out[i].max.y = (float)(in[i].max.y - origin.y);
+		out[i].max.z = (float)(in[i].max.z - origin.z);
+	}
+}
+
+//硪ľתΪ硪ľ
+Matrix4x3 rebaseWorldToCamera(const Matrix4x3d& worldToCamera, const Vector3d& origin) {
+	const Matrix4x3d& m = worldToCamera;
+	Vector3d t = origin * m;
+	Matrix4x3 r;
+	r.m11 = (float)m.m11; r.m12 = (float)m.m12; r.m13 = (float)m.m13;
+	r.m21 = (float)m.m21; r.m22 = (float)m.m22; r.m23 = (float)m.m23;
+	r.m31 = (float)m.m31; r.m32 = (float)m.m32; r.m33 = (float)m.m33;
+	r.tx = (float)t.x;
+	r.ty = (float)t.y;
+	r.tz = (float)t.z;
+	return r;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#ifndef __CAMERARELATIVE_H_INCLUDED__
+#define __CAMERARELATIVE_H_INCLUDED__
+
+#include <stddef.h>
+
+template <typename T> class Vector3T;
+typedef Vector3T<float> Vector3;
+typedef Vector3T<double> Vector3d;
+template <typename T> class Matrix4x3T;
+typedef Matrix4x3T<float> Matrix4x3;
+typedef Matrix4x3T<double> Matrix4x3d;
+template <typename T> class AABB3T;
+typedef AABB3T<float> AABB3;
+typedef AABB3T<double> AABB3d;
+
+// ƣ
+// ߣcary
+// Χĳdouble棬ԭԶʱfloatľȲ1e5ԼΪ0.008
+//		ÿ֡ѡһԭ㣨һλãdoubleͱ任ȥԭתΪfloat
+//		֮㣨transformPoints()concatenate()AABB3Arrayȣԭfloatռн
+//		double¼ȥԭתԭ屣float
+//
+//		кǼ򵥵Ԫѭin  out ص
+
+//p - originתΪfloat
+void rebasePoints(const Vector3d* in, const Vector3d& origin, Vector3* out, size_t n);
+
+//ֲľתΪֲľ
+//3x3ֱתΪfloatƽƲּȥoriginת
+void rebaseMatrices(const Matrix4x3d* in, const Vector3d& origin, Matrix4x3* out, size_t n);
+
+//ռAABBתΪoriginAABBյAABBΪ
+void rebaseBoxes(const AABB3d* in, const Vector3d& origin, AABB3* out, size_t n);
+
+//硪ľתΪ硪ľ󣬺rebaseMatrices()ĽӼΪֲľ
+// p ӦΪ p + originƽƲΪ origin * worldToCameradouble¼
+//originΪλʱƽƲֽӽ
+Matrix4x3 rebaseWorldToCamera(const Matrix4x3d& worldToCamera, const Vector3d& origin);
+
+#endif // #ifndef __CAMERARELATIVE_H_INCLUDED__
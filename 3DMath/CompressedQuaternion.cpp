@@ -0,0 +1,202 @@
+#include <assert.h>
+#include <math.h>
+
+#include "CompressedQuaternion.h"
+#include "Quaternion.h"
+#include "SimdUtil.h"
+
+// ƣѹԪ
+// ߣcary
+// ֵuͷv֮ĹϵΪ v = u * scale - 1/sqrt(2)scale = sqrt(2) / (2^λ - 2)
+//		u Ϊ 2^λ - 2мֵ 2^(λ - 1) - 1 ʾ0λԪȳֵԾȷʾ
+//		汾Ľ汾ʹͬ˳򣬽λһ
+
+static_assert(sizeof(CompressedQuaternion48) == 6, "CompressedQuaternion48 must be six bytes");
+static_assert(sizeof(CompressedQuaternion32) == 4, "CompressedQuaternion32 must be four bytes");
+
+const float kSqrt1Over2 = 0.707106781f;
+
+//ÿ15λ10λֵ
+const uint32_t kMax48 = (1u << 15) - 2;
+const uint32_t kMax32 = (1u << 10) - 2;
+//10λֶε
+const uint32_t kMask32 = (1u << 10) - 1;
+const float kScale48 = 2.0f * kSqrt1Over2 / kMax48;
+const float kScale32 = 2.0f * kSqrt1Over2 / kMax32;
+
+//룺򻯺ҳֵķΪʱԪȡ
+//˳Ϊ [0, maxValue] ֮
+static int smallestThree(const Quaternion& q, uint32_t maxValue, uint32_t* u) {
+	Quaternion n = q;
+	n.normalize();
+	float c[4] = { n.x, n.y, n.z, n.w };
+	int largest = 0;
+	for (int i = 1; i < 4; ++i) {
+		if (fabs(c[i]) > fabs(c[largest])) {
+			largest = i;
+		}
+	}
+	const float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+	const float oneOverScale = maxValue / (2.0f * kSqrt1Over2);
+	for (int i = 0, k = 0; i < 4; ++i) {
+		if (i == largest) {
+			continue;
+		}
+		float v = floorf((c[i] * sign + kSqrt1Over2) * oneOverScale + 0.5f);
+		//ʹ΢Χ
+		if (v < 0.0f) {
+			v = 0.0f;
+		}
+		if (v > (float)maxValue) {
+			v = (float)maxValue;
+		}
+		u[k++] = (uint32_t)v;
+	}
+	return largest;
+}
+
+CompressedQuaternion48 compressQuaternion48(const Quaternion& q) {
+	uint32_t u[3];
+	int largest = smallestThree(q, kMax48, u);
+	CompressedQuaternion48 c;
+	c.bits[0] = (uint16_t)(((largest & 1) << 15) | u[0]);
+	c.bits[1] = (uint16_t)(((largest >> 1) << 15) | u[1]);
+	c.bits[2] = (uint16_t)u[2];
+	return c;
+}
+
+CompressedQuaternion32 compressQuaternion32(const Quaternion& q) {
+	uint32_t u[3];
+	int largest = smallestThree(q, kMax32, u);
+	CompressedQuaternion32 c;
+	c.bits = ((uint32_t)largest << 30) | (u[0] << 20) | (u[1] << 10) | u[2];
+	return c;
+}
+
+//±ķdŻأabcΪ
+static Quaternion reconstruct(int largest, float a, float b, float c) {
+	float t = 1.0f - a * a - b * b - c * c;
+	float d = sqrtf(t > 0.0f ? t : 0.0f);
+	Quaternion q;
+	q.x = largest == 0 ? d : a;
+	q.y = largest == 0 ? a : (largest == 1 ? d : b);
+	q.z = largest <= 1 ? b : (largest == 2 ? d : c);
+	q.w = largest == 3 ? d : c;
+	return q;
+}
+
+Quaternion decompressQuaternion(const CompressedQuaternion48& c) {
+	int largest = (c.bits[0] >> 15) | ((c.bits[1] >> 15) << 1);
+	return reconstruct(largest,
+		(float)(c.bits[0] & 0x7fff) * kScale48 - kSqrt1Over2,
+		(float)(c.bits[1] & 0x7fff) * kScale48 - kSqrt1Over2,
+		(float)c.bits[2] * kScale48 - kSqrt1Over2);
+}
+
+Quaternion decompressQuaternion(const CompressedQuaternion32& c) {
+	return reconstruct((int)(c.bits >> 30),
+		(float)((c.bits >> 20) & kMask32) * kScale32 - kSqrt1Over2,
+		(float)((c.bits >> 10) & kMask32) * kScale32 - kSqrt1Over2,
+		(float)(c.bits & kMask32) * kScale32 - kSqrt1Over2);
+}
+
+void compressQuaternions(const Quaternion* in, CompressedQuaternion48* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = compressQuaternion48(in[i]);
+	}
+}
+
+void compressQuaternions(const Quaternion* in, CompressedQuaternion32* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = compressQuaternion32(in[i]);
+	}
+}
+
+//汾reconstruct()largestΪ03float
+static inline void simdReconstruct(SimdFloat largest, SimdFloat a, SimdFloat b, SimdFloat c, Quaternion* out) {
+	const SimdFloat t = simdSub(simdSub(simdSub(simdSet(1.0f), simdMul(a, a)), simdMul(b, b)), simdMul(c, c));
+	const SimdFloat d = simdSqrt(simdMax(t, simdZero()));
+	const SimdFloat is0 = simdCmpEq(largest, simdZero());
+	const SimdFloat is1 = simdCmpEq(largest, simdSet(1.0f));
+	const SimdFloat is2 = simdCmpEq(largest, simdSet(2.0f));
+	const SimdFloat is3 = simdCmpEq(largest, simdSet(3.0f));
+	SimdFloat x = simdSelect(is0, d, a);
+	SimdFloat y = simdSelect(is0, a, simdSelect(is1, d, b));
+	SimdFloat z = simdSelect(simdOr(is0, is1), b, simdSelect(is2, d, c));
+	SimdFloat w = simdSelect(is3, d, c);
+	simdStore4x(&out->x, 4, x, y, z, w);
+}
+
+//һ48λԪÿһ·uint163Ԫ
+static inline void simdDecompress(const CompressedQuaternion48* in, Quaternion* out) {
+	const SimdFloat scale = simdSet(kScale48), offset = simdSet(kSqrt1Over2);
+	const SimdFloat highBit = simdSet(32768.0f);
+	SimdFloat u0 = simdLoadUint16(&in->bits[0], 3);
+	SimdFloat u1 = simdLoadUint16(&in->bits[1], 3);
+	SimdFloat u2 = simdLoadUint16(&in->bits[2], 3);
+	//λ±꣬ȥΪ
+	SimdFloat low = simdCmpGe(u0, highBit);
+	SimdFloat high = simdCmpGe(u1, highBit);
+	u0 = simdSub(u0, simdAnd(low, highBit));
+	u1 = simdSub(u1, simdAnd(high, highBit));
+	SimdFloat largest = simdAdd(simdAnd(low, simdSet(1.0f)), simdAnd(high, simdSet(2.0f)));
+	simdReconstruct(largest,
+		simdSub(simdMul(u0, scale), offset),
+		simdSub(simdMul(u1, scale), offset),
+		simdSub(simdMul(u2, scale), offset), out);
+}
+
+//һ32λԪ
+static inline void simdDecompress(const CompressedQuaternion32* in, Quaternion* out) {
+	const SimdFloat scale = simdSet(kScale32), offset = simdSet(kSqrt1Over2);
+	const uint32_t* p = &in->bits;
+	simdReconstruct(simdLoadBitField(p, 30, 3),
+		simdSub(simdMul(simdLoadBitField(p, 20, kMask32), scale), offset),
+		simdSub(simdMul(simdLoadBitField(p, 10, kMask32), scale), offset),
+		simdSub(simdMul(simdLoadBitField(p, 0, kMask32), scale), offset), out);
+}
+
+//룬һβƵʱУ㣬ֻдЧ
+template <typename Compressed>
+static void decompressGroups(const Compressed* in, Quaternion* out, size_t n) {
+	const size_t simdEnd = n - n % kSimdWidth;
+	for (size_t i = 0; i < simdEnd; i += kSimdWidth) {
+		simdDecompress(in + i, out + i);
+	}
+	if (simdEnd < n) {
+		Compressed tailIn[kSimdWidth] = {};
+		Quaternion tailOut[kSimdWidth];
+		for (size_t i = simdEnd; i < n; ++i) {
+			tailIn[i - simdEnd] = in[i];
+		}
+		simdDecompress(tailIn, tailOut);
+		for (size_t i = simdEnd; i < n; ++i) {
+			out[i] = tailOut[i - simdEnd];
+		}
+	}
+}
+
+void decompressQuaternions(const CompressedQuaternion48* in, Quaternion* out, size_t n) {
+	decompressGroups(in, out, n);
+}
+
+void decompressQuaternions(const CompressedQuaternion32* in, Quaternion* out, size_t n) {
+	decompressGroups(in, out, n);
+}
+
+//Ԫ֮Ƕ
+//СʱнǶԳȵУȳԪĳ
+float maxAngularError(const Quaternion* a, const Quaternion* b, size_t n) {
+	double maxAngle = 0.0;
+	for (size_t i = 0; i < n; ++i) {
+		double aa = double(a[i].x) * a[i].x + double(a[i].y) * a[i].y + double(a[i].z) * a[i].z + double(a[i].w) * a[i].w;
+		double bb = double(b[i].x) * b[i].x + double(b[i].y) * b[i].y + double(b[i].z) * b[i].z + double(b[i].w) * b[i].w;
+		double ab = double(a[i].x) * b[i].x + double(a[i].y) * b[i].y + double(a[i].z) * b[i].z + double(a[i].w) * b[i].w;
+		double d = fabs(ab) / sqrt(aa * bb);
+		double angle = d >= 1.0 ? 0.0 : 2.0 * acos(d);
+		if (angle > maxAngle) {
+			maxAngle = angle;
+		}
+	}
+	return (float)maxAngle;
+}
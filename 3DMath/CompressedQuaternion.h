@@ -0,0 +1,55 @@
+#pragma once
+
+#ifndef __COMPRESSEDQUATERNION_H_INCLUDED__
+#define __COMPRESSEDQUATERNION_H_INCLUDED__
+
+#include <stddef.h>
+#include <stdint.h>
+
+class Quaternion;
+
+// ƣѹԪ
+// ߣcary
+// áСsmallest threeʽ浥λԪڶ
+//		q  -q ʾͬһתʱѾֵķΪֻ±
+//		ʱλķsqrt(1 - a*a - b*b - c*c)
+//		ľֵ 1/sqrt(2) [-1/sqrt(2), 1/sqrt(2)] Ͼ
+//
+//		48λuint16ÿ15λ±λǰuint16λ6ֽ
+//		32λһuint32ÿ10λ±λ4ֽ
+//
+//		Ƕ2 * acos(|q0q1|)ڴתϲã
+//		48λԼ 1.4e-4 ȣ0.008ȣ32λԼ 4.2e-3 ȣ0.24ȣ
+//		maxAngularError()ԶԾĶݼ
+
+struct CompressedQuaternion48 {
+	uint16_t bits[3];
+};
+
+struct CompressedQuaternion32 {
+	uint32_t bits;
+};
+
+//Ԫıͽ
+//ǰ򻯣q Ϊ
+//Ľ汾λһ
+CompressedQuaternion48 compressQuaternion48(const Quaternion& q);
+CompressedQuaternion32 compressQuaternion32(const Quaternion& q);
+Quaternion decompressQuaternion(const CompressedQuaternion48& c);
+Quaternion decompressQuaternion(const CompressedQuaternion32& c);
+
+//룬һߴʱã
+void compressQuaternions(const Quaternion* in, CompressedQuaternion48* out, size_t n);
+void compressQuaternions(const Quaternion* in, CompressedQuaternion32* out, size_t n);
+
+//룬ÿνkSimdWidth48תΪfloat
+//ñȽϺѡ水±ķ֧תд
+void decompressQuaternions(const CompressedQuaternion48* in, Quaternion* out, size_t n);
+void decompressQuaternions(const CompressedQuaternion32* in, Quaternion* out, size_t n);
+
+//Ԫ֮Ƕȣ 2 * acos(|dotProduct(a[i], b[i])|) ֵ
+//ȡֵΪ q  -q ʾͬһת
+//ҪǵλԪȳԳȣСʱfloatacosȷdouble
+float maxAngularError(const Quaternion* a, const Quaternion* b, size_t n);
+
+#endif // #ifndef __COMPRESSEDQUATERNION_H_INCLUDED__
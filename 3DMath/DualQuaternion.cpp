@@ -0,0 +1,114 @@
+#include <assert.h>
+#include <math.h>
+
+#include "DualQuaternion.h"
+#include "Matrix4x3.h"
+
+// ƣżԪ
+// ߣcary
+// Quaternion p * a ൱Hamilton˷ a * p
+//		ĹʽȰHamilton˷ƵٻQuaternion::operator*˳
+
+//Ϊλ任
+void DualQuaternion::identity() {
+	real.identity();
+	dual.x = dual.y = dual.z = dual.w = 0.0f;
+}
+
+//dual = 0.5 * t * realHamilton˷ 0.5 * (real * t)
+void DualQuaternion::setup(const Quaternion& rotation, const Vector3& translation) {
+	Quaternion t = { translation.x, translation.y, translation.z, 0.0f };
+	real = rotation;
+	dual = rotation * t;
+	dual.x *= 0.5f; dual.y *= 0.5f; dual.z *= 0.5f; dual.w *= 0.5f;
+}
+
+//תԪֵķԺС
+//ԪĹϵMatrix4x3::fromQuaternion()
+void DualQuaternion::fromMatrix4x3(const Matrix4x3& m) {
+	float fourWSquaredMinus1 = m.m11 + m.m22 + m.m33;
+	float fourXSquaredMinus1 = m.m11 - m.m22 - m.m33;
+	float fourYSquaredMinus1 = m.m22 - m.m11 - m.m33;
+	float fourZSquaredMinus1 = m.m33 - m.m11 - m.m22;
+
+	int biggestIndex = 0;
+	float fourBiggestSquaredMinus1 = fourWSquaredMinus1;
+	if (fourXSquaredMinus1 > fourBiggestSquaredMinus1) {
+		fourBiggestSquaredMinus1 = fourXSquaredMinus1;
+		biggestIndex = 1;
+	}
+	if (fourYSquaredMinus1 > fourBiggestSquaredMinus1) {
+		fourBiggestSquaredMinus1 = fourYSquaredMinus1;
+		biggestIndex = 2;
+	}
+	if (fourZSquaredMinus1 > fourBiggestSquaredMinus1) {
+		fourBiggestSquaredMinus1 = fourZSquaredMinus1;
+		biggestIndex = 3;
+	}
+
+	float biggestVal = sqrtf(fourBiggestSquaredMinus1 + 1.0f) * 0.5f;
+	float mult = 0.25f / biggestVal;
+
+	Quaternion q;
+	switch (biggestIndex) {
+	case 0:
+		q.w = biggestVal;
+		q.x = (m.m23 - m.m32) * mult;
+		q.y = (m.m31 - m.m13) * mult;
+		q.z = (m.m12 - m.m21) * mult;
+		break;
+	case 1:
+		q.x = biggestVal;
+		q.w = (m.m23 - m.m32) * mult;
+		q.y = (m.m12 + m.m21) * mult;
+		q.z = (m.m31 + m.m13) * mult;
+		break;
+	case 2:
+		q.y = biggestVal;
+		q.w = (m.m31 - m.m13) * mult;
+		q.x = (m.m12 + m.m21) * mult;
+		q.z = (m.m23 + m.m32) * mult;
+		break;
+	default:
+		q.z = biggestVal;
+		q.w = (m.m12 - m.m21) * mult;
+		q.x = (m.m31 + m.m13) * mult;
+		q.y = (m.m23 + m.m32) * mult;
+		break;
+	}
+	setup(q, Vector3(m.tx, m.ty, m.tz));
+}
+
+//(Br + Bd)(Ar + Ad) = BrAr + (BrAd + BdAr)Hamilton˷AΪBΪa
+DualQuaternion DualQuaternion::operator *(const DualQuaternion& a) const {
+	DualQuaternion r;
+	r.real = real * a.real;
+	Quaternion d0 = dual * a.real;
+	Quaternion d1 = real * a.dual;
+	r.dual.x = d0.x + d1.x;
+	r.dual.y = d0.y + d1.y;
+	r.dual.z = d0.z + d1.z;
+	r.dual.w = d0.w + d1.w;
+	return r;
+}
+
+//Ȩػϲ򻯣ۼӵ˳ƤSIMD汾ͬ
+DualQuaternion blend(const DualQuaternion* dq, const float* weight, size_t count) {
+	assert(count > 0);
+	DualQuaternion r;
+	const float* first = &dq[0].real.x;
+	float* p = &r.real.x;
+	for (int j = 0; j < 8; ++j) {
+		p[j] = weight[0] * first[j];
+	}
+	for (size_t k = 1; k < count; ++k) {
+		float w = dotProduct(dq[k].real, dq[0].real) < 0.0f ? -weight[k] : weight[k];
+		const float* q = &dq[k].real.x;
+		for (int j = 0; j < 8; ++j) {
+			p[j] = p[j] + w * q[j];
+		}
+	}
+	assert(dotProduct(r.real, r.real) > 0.0f);
+	r.normalize();
+	return r;
+}
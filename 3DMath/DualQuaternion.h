@@ -0,0 +1,76 @@
+#pragma once
+
+#ifndef __DUALQUATERNION_H_INCLUDED__
+#define __DUALQUATERNION_H_INCLUDED__
+
+#include <stddef.h>
+#include <math.h>
+#include "Quaternion.h"
+#include "Vector3.h"
+
+template <typename T> class Matrix4x3T;
+typedef Matrix4x3T<float> Matrix4x3;
+
+// ƣżԪ
+// ߣcary
+// öżԪ real +  * dual ʾ任תƽƣ32ֽڣƤ
+//		real תĵλԪdual ƽƣdual = 0.5 * t * realHamilton˷tΪԪ
+//		ı任Matrix4x3ͬԼתƽ
+//		Ȩ򻯣DLBdual quaternion linear blendingõǸ任
+//		ԻڹؽڴǹֽЧӦ
+//		ܱʾ
+
+class DualQuaternion
+{
+public:
+	Quaternion real;
+	Quaternion dual;
+
+	//Ϊλ任
+	void identity();
+
+	//ȰrotationתƽtranslationrotationӦΪλԪ
+	void setup(const Quaternion& rotation, const Vector3& translation);
+	//Ӿ죬3x3ֱתûźб䣩
+	void fromMatrix4x3(const Matrix4x3& m);
+
+	//ƽƲ֣t = 2 * dual * conjugate(real)Hamilton˷
+	//real ΪλԪʱsetup()translation
+	Vector3 getTranslation() const;
+
+	//򻯣realdualͬʱrealĳ
+	void normalize();
+
+	//* ӱ任p * a ʾȽpı任ٽaı任Quaternionͬ
+	DualQuaternion operator *(const DualQuaternion& a) const;
+};
+
+//汾ڴ沼֣realdual8float
+static_assert(sizeof(DualQuaternion) == 8 * sizeof(float), "DualQuaternion must be eight packed floats");
+
+//˳ƤSIMD汾ͬ޸ʱҪһ
+inline Vector3 DualQuaternion::getTranslation() const {
+	return Vector3(
+		2.0f * ((real.w * dual.x - dual.w * real.x) + (real.y * dual.z - real.z * dual.y)),
+		2.0f * ((real.w * dual.y - dual.w * real.y) + (real.z * dual.x - real.x * dual.z)),
+		2.0f * ((real.w * dual.z - dual.w * real.z) + (real.x * dual.y - real.y * dual.x))
+	);
+}
+
+inline void DualQuaternion::normalize() {
+	float oneOverMag = 1.0f / sqrtf(dotProduct(real, real));
+	real.x *= oneOverMag; real.y *= oneOverMag; real.z *= oneOverMag; real.w *= oneOverMag;
+	dual.x *= oneOverMag; dual.y *= oneOverMag; dual.z *= oneOverMag; dual.w *= oneOverMag;
+}
+
+//*żԪ任㣬dq Ӧ
+inline Vector3 operator *(const Vector3& p, const DualQuaternion& dq) {
+	return rotate(dq.real, p) + dq.getTranslation();
+}
+
+//ȨػcountżԪ򻯣DLB
+//q  -q ʾͬһתweight[k]  dq[k].real  dq[0].real ĵΪʱȡ֤·
+//ȨصĺӦΪ1ϵĽΪ
+DualQuaternion blend(const DualQuaternion* dq, const float* weight, size_t count);
+
+#endif // #ifndef __DUALQUATERNION_H_INCLUDED__
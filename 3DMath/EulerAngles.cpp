@@ -10,7 +10,13 @@
 // ŷǻʵķװ
 //		ڱ heading-pitch-bankŷϵͳ
 
-const EulerAngles kEulerAnglesIdentity(0.0f, 0.0f, 0.0f);
+//Ԫתʱatan2Ĳdouble㣬kPrecisionFullʱԭļ㷽ʽ
+static float quaternionAtan2(double y, double x, MathPrecision precision) {
+	if (precision == kPrecisionFull) {
+		return (float)atan2(y, x);
+	}
+	return fastAtan2((float)y, (float)x, precision);
+}
 
 //任ɡƼŷ
 void EulerAngles::canonize() {
@@ -44,7 +50,7 @@ void EulerAngles::warpPitchPiOver2() {
 }
 
 //塪Ԫŷ
-void EulerAngles::fromObjectToIntertialQuaternion(const Quaternion& q) {
+void EulerAngles::fromObjectToIntertialQuaternion(const Quaternion& q, MathPrecision precision) {
 	//sin(pitch)
 	//m23 = -sin(pitch) = 2yz - 2wx
 	float sinPicth = -2.0f * (q.y * q.z - q.w * q.x);
@@ -53,20 +59,20 @@ void EulerAngles::fromObjectToIntertialQuaternion(const Quaternion& q) {
 		//Ϸ·
 		pitch = kPiOver2 * sinPicth;
 		//heading = atan2(-xz + wy, 1/2 - y^2 - z^2);
-		heading = atan2(-double(q.x) * double(q.z) + double(q.w) * double(q.y), 0.5f - double(q.y) * double(q.y) - double(q.z) * double(q.z));
+		heading = quaternionAtan2(-double(q.x) * double(q.z) + double(q.w) * double(q.y), 0.5f - double(q.y) * double(q.y) - double(q.z) * double(q.z), precision);
 		bank = 0.0f;
 	}
 	else {
-		pitch = asin(sinPicth);
+		pitch = fastAsin(sinPicth, precision);
 		//heading = atan2(xz + wy, 1/2 - x^2 - y^2);
-		heading = atan2(double(q.x) * double(q.z) + double(q.w) * double(q.y), 0.5f - double(q.x) * double(q.x) - double(q.y) * double(q.y));
+		heading = quaternionAtan2(double(q.x) * double(q.z) + double(q.w) * double(q.y), 0.5f - double(q.x) * double(q.x) - double(q.y) * double(q.y), precision);
 		//bank = atan2(xy + wz, 1/2 - x^2 - z^2);
-		bank = atan2(double(q.x) * double(q.y) + double(q.w) * double(q.z), 0.5f - double(q.x) * double(q.x) - double(q.z) * double(q.z));
+		bank = quaternionAtan2(double(q.x) * double(q.y) + double(q.w) * double(q.z), 0.5f - double(q.x) * double(q.x) - double(q.z) * double(q.z), precision);
 	}
 }
 
 //ӹԡԪŷ
-void EulerAngles::fromIntertialToObjectQuaternion(const Quaternion& q) {
+void EulerAngles::fromIntertialToObjectQuaternion(const Quaternion& q, MathPrecision precision) {
 	//sin(pitch)
 		//m23 = -sin(pitch) = 2yz + 2wx
 	float sinPicth = -2.0f * (q.y * q.z + q.w * q.x);;
@@ -75,65 +81,65 @@ void EulerAngles::fromIntertialToObjectQuaternion(const Quaternion& q) {
 		//Ϸ·
 		pitch = kPiOver2 * sinPicth;
 		//heading = atan2(-xz - wy, 1/2 - y^2 - z^2);
-		heading = atan2(-double(q.x) * double(q.z) - double(q.w) * double(q.y), 0.5f - double(q.y) * double(q.y) - double(q.z) * double(q.z));
+		heading = quaternionAtan2(-double(q.x) * double(q.z) - double(q.w) * double(q.y), 0.5f - double(q.y) * double(q.y) - double(q.z) * double(q.z), precision);
 		bank = 0.0f;
 	}
 	else {
-		pitch = asin(sinPicth);
+		pitch = fastAsin(sinPicth, precision);
 		//heading = atan2(xz - wy, 1/2 - x^2 - y^2);
-		heading = atan2(double(q.x) * double(q.z) - double(q.w) * double(q.y), 0.5f - double(q.x) * double(q.x) - double(q.y) * double(q.y));
+		heading = quaternionAtan2(double(q.x) * double(q.z) - double(q.w) * double(q.y), 0.5f - double(q.x) * double(q.x) - double(q.y) * double(q.y), precision);
 		//bank = atan2(xy - wz, 1/2 - x^2 - z^2);
-		bank = atan2(double(q.x) * double(q.y) - double(q.w) * double(q.z), 0.5f - double(q.x) * double(q.x) - double(q.z) * double(q.z));
+		bank = quaternionAtan2(double(q.x) * double(q.y) - double(q.w) * double(q.z), 0.5f - double(q.x) * double(q.x) - double(q.z) * double(q.z), precision);
 	}
 }
 
 //Ϊ塪ת
-void EulerAngles::formObjectToWorldMatrix(const Matrix4x3& m) {
+void EulerAngles::formObjectToWorldMatrix(const Matrix4x3& m, MathPrecision precision) {
 	float sinPitch = -m.m32;
 
 	//Ƿ
-	if (fabs(sinPitch) > 9.9999f) {
+	if (fabs(sinPitch) > 0.9999f) {
 		pitch = kPiOver2 * sinPitch;
-		heading = atan2(-m.m23, m.m11);
+		heading = fastAtan2(-m.m23, m.m11, precision);
 		bank = 0.0f;
 	}
 	else {
-		pitch = asin(sinPitch);
-		heading = atan2(m.m31, m.m33);
-		bank = atan2(m.m21, m.m22);
+		pitch = fastAsin(sinPitch, precision);
+		heading = fastAtan2(m.m31, m.m33, precision);
+		bank = fastAtan2(m.m21, m.m22, precision);
 	}
 }
 
 //Ϊ硪ת
-void EulerAngles::formWorldToObjectMatrix(const Matrix4x3& m) {
+void EulerAngles::formWorldToObjectMatrix(const Matrix4x3& m, MathPrecision precision) {
 	float sinPitch = -m.m23;
 
 	//Ƿ
-	if (fabs(sinPitch) > 9.9999f) {
+	if (fabs(sinPitch) > 0.9999f) {
 		pitch = kPiOver2 * sinPitch;
-		heading = atan2(-m.m31, m.m11);
+		heading = fastAtan2(-m.m31, m.m11, precision);
 		bank = 0.0f;
 	}
 	else {
-		pitch = asin(sinPitch);
-		heading = atan2(m.m31, m.m33);
-		bank = atan2(m.m21, m.m22);
+		pitch = fastAsin(sinPitch, precision);
+		heading = fastAtan2(m.m31, m.m33, precision);
+		bank = fastAtan2(m.m21, m.m22, precision);
 	}
 }
 
 //תתŷ
-void EulerAngles::fromRotationMatrix(const RotationMatrix& m) {
+void EulerAngles::fromRotationMatrix(const RotationMatrix& m, MathPrecision precision) {
 	float sinPitch = -m.m23;
 
 	//Ƿ
-	if (fabs(sinPitch) > 9.9999f) {
+	if (fabs(sinPitch) > 0.9999f) {
 		pitch = kPiOver2 * sinPitch;
-		heading = atan2(-m.m31, m.m11);
+		heading = fastAtan2(-m.m31, m.m11, precision);
 		bank = 0.0f;
 	}
 	else {
-		pitch = asin(sinPitch);
-		heading = atan2(m.m31, m.m33);
-		bank = atan2(m.m21, m.m22);
+		pitch = fastAsin(sinPitch, precision);
+		heading = fastAtan2(m.m31, m.m33, precision);
+		bank = fastAtan2(m.m21, m.m22, precision);
 	}
 }
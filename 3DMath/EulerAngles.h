@@ -8,7 +8,10 @@
 #ifndef __UELERANGLES_H_INCLUDED
 #define __UELERANGLES_H_INCLUDED
 
-class Matrix4x3;
+#include "MathUtil.h"
+
+template <typename T> class Matrix4x3T;
+typedef Matrix4x3T<float> Matrix4x3;
 class RotationMatrix;
 class Quaternion;
 
@@ -18,39 +21,41 @@ public:
 	float pitch;
 	float bank;
 
-	EulerAngles() {}
-	EulerAngles(float h, float p, float b) :heading(h), pitch(p), bank(b) {};
+	EulerAngles() = default;
+	constexpr EulerAngles(float h, float p, float b) :heading(h), pitch(p), bank(b) {};
 
 	//
-	void identity(){
+	constexpr void identity(){
 		heading = pitch = bank = 0.0f;
 	}
 
 	//任ɡƼŷ
 	void canonize();
 
+	//תprecisionѡasinatan2ľȣMathUtil.h
+
 	//Ԫתŷ
 	//塪Ԫŷ
-	void fromObjectToIntertialQuaternion(const Quaternion& q);
+	void fromObjectToIntertialQuaternion(const Quaternion& q, MathPrecision precision = kPrecisionFull);
 	//ӹԡԪŷ
-	void fromIntertialToObjectQuaternion(const Quaternion& q);
+	void fromIntertialToObjectQuaternion(const Quaternion& q, MathPrecision precision = kPrecisionFull);
 
 	//Ӿתŷ
 	//ƽƲֱʡԣҼ
 	//Ϊ塪ת
-	void formObjectToWorldMatrix(const Matrix4x3& m);
+	void formObjectToWorldMatrix(const Matrix4x3& m, MathPrecision precision = kPrecisionFull);
 	//Ϊ硪ת
-	void formWorldToObjectMatrix(const Matrix4x3& m);
+	void formWorldToObjectMatrix(const Matrix4x3& m, MathPrecision precision = kPrecisionFull);
 
 	//תתŷ
-	void fromRotationMatrix(const RotationMatrix& m);
+	void fromRotationMatrix(const RotationMatrix& m, MathPrecision precision = kPrecisionFull);
 
 private:
 	//pitch任[-pi/2-pi/2]֮
 	void warpPitchPiOver2();
 };
 
-//ȫֵġλŷ
-extern const EulerAngles kEulerAnglesIdentity;
+//ȫֵġλŷǣڳ
+constexpr EulerAngles kEulerAnglesIdentity(0.0f, 0.0f, 0.0f);
 
 #endif //#ifndef __UELERANGLES_H_INCLUDED
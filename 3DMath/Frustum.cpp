@@ -0,0 +1,246 @@
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+#include "Frustum.h"
+#include "AABB3.h"
+#include "AABB3Array.h"
+#include "Matrix4x3.h"
+#include "SimdUtil.h"
+
+// ƣ׶
+// ߣcary
+// ƽΧɵ׶壬üAABB
+//
+//		AABBƽĲAABB3::classifyPlane()ͬ
+//		ÿķţminmaxѡƽСĶ㣬
+//			С >= d ƽ棬 <= d ƽ汳棬ƽ
+//		ʱAABBķͬѡminmaxֻҪÿƽжһΣû·ѡ
+//		һAABBκһƽ汳׶⣬ƽ׶ڣ
+//		Ͳƽ˳޹أ͵ԵĽȫһ
+
+void Frustum::setPlanes(const Vector3* normals, const float* planeD)
+{
+	for (int i = 0; i < kFrustumPlaneCount; ++i) {
+		n[i] = normals[i];
+		d[i] = planeD[i];
+	}
+}
+
+//ռйƽ棬ٱ任ռ
+//ռеĵ c = p * M + tƽ c*nc >= dc Ϊ
+//		p * (M * nc) >= dc - t*nc
+//M * nc þкncķ任ٱ׼
+void Frustum::setupFromView(const Matrix4x3& worldToCamera, float fovX, float aspect, float nearClip, float farClip)
+{
+	assert(aspect > 0.0f);
+	assert(nearClip < farClip);
+	float tanX = tanf(fovX * 0.5f);
+	float tanY = tanX / aspect;
+
+	//ռеƽ棬涼ͨԭ
+	Vector3 cameraN[kFrustumPlaneCount] = {
+		Vector3(1.0f, 0.0f, tanX),
+		Vector3(-1.0f, 0.0f, tanX),
+		Vector3(0.0f, 1.0f, tanY),
+		Vector3(0.0f, -1.0f, tanY),
+		Vector3(0.0f, 0.0f, 1.0f),
+		Vector3(0.0f, 0.0f, -1.0f)
+	};
+	float cameraD[kFrustumPlaneCount] = { 0.0f, 0.0f, 0.0f, 0.0f, nearClip, -farClip };
+
+	const Matrix4x3& m = worldToCamera;
+	for (int i = 0; i < kFrustumPlaneCount; ++i) {
+		const Vector3& nc = cameraN[i];
+		Vector3 worldN(
+			m.m11 * nc.x + m.m12 * nc.y + m.m13 * nc.z,
+			m.m21 * nc.x + m.m22 * nc.y + m.m23 * nc.z,
+			m.m31 * nc.x + m.m32 * nc.y + m.m33 * nc.z);
+		float worldD = cameraD[i] - (m.tx * nc.x + m.ty * nc.y + m.tz * nc.z);
+		float mag = vectorMag(worldN);
+		assert(mag > 0.0f);
+		float oneOverMag = 1.0f / mag;
+		n[i] = worldN * oneOverMag;
+		d[i] = worldD * oneOverMag;
+	}
+}
+
+//һAABB
+int Frustum::classifyAABB(const AABB3& box, unsigned planeMask, unsigned* returnMask, unsigned char* lastPlane) const
+{
+	//Ȳϴξܾƽ棬ٰ˳ƽ
+	unsigned first = 0;
+	if (lastPlane != NULL && *lastPlane < kFrustumPlaneCount) {
+		first = (1u << *lastPlane) & planeMask;
+	}
+	unsigned spanning = 0;
+	for (int pass = 0; pass < 2; ++pass) {
+		unsigned planes = pass == 0 ? first : (planeMask & ~first);
+		for (int i = 0; i < kFrustumPlaneCount; ++i) {
+			if ((planes & (1u << i)) == 0) {
+				continue;
+			}
+			int side = box.classifyPlane(n[i], d[i]);
+			if (side < 0) {
+				if (lastPlane != NULL) {
+					*lastPlane = (unsigned char)i;
+				}
+				if (returnMask != NULL) {
+					*returnMask = spanning;
+				}
+				return kCullOutside;
+			}
+			if (side == 0) {
+				spanning |= 1u << i;
+			}
+		}
+	}
+	if (returnMask != NULL) {
+		*returnMask = spanning;
+	}
+	return spanning == 0 ? kCullInside : kCullIntersecting;
+}
+
+//һƽSIMDʽ
+struct SimdPlane {
+	SimdFloat nx, ny, nz, d;
+	//ƽеλλreturnMask
+	SimdFloat bit;
+	//ƽ±
+	SimdFloat index;
+	//ΪʱƽСĶȡminȡmaxAABB3::classifyPlane()һ
+	bool positiveX, positiveY, positiveZ;
+};
+
+//ͬʱkSimdWidthAABBcountΪЧ·
+//ȲһAABBϴξܾƽĲٰ˳ƽ
+//Լ¼ľܾƽܺclassifyAABB()ͬȷʵܾAABBƽ
+//lastPlane ѡkSimdWidthԪأֻдǰcount
+static void simdCullBlock(const SimdPlane* planes, unsigned planeMask, size_t count,
+	SimdFloat minX, SimdFloat minY, SimdFloat minZ, SimdFloat maxX, SimdFloat maxY, SimdFloat maxZ,
+	signed char* result, unsigned char* returnMask, unsigned char* lastPlane) {
+	//ϴξܾƽ±꣬תfloatԱsimdSelect()
+	unsigned first = 0;
+	float planeIndex[kSimdWidth];
+	SimdFloat rejectedBy = simdZero();
+	if (lastPlane != NULL) {
+		//kFrustumNoPlane & 7 Ӧ7λplaneMaskλ֮ȥ
+		for (size_t j = 0; j < kSimdWidth; ++j) {
+			planeIndex[j] = lastPlane[j];
+			first |= 1u << (lastPlane[j] & 7);
+		}
+		first &= planeMask;
+		rejectedBy = simdLoad(planeIndex);
+	}
+
+	const SimdFloat allTrue = simdCmpEq(simdZero(), simdZero());
+	SimdFloat outsideMask = simdZero();
+	SimdFloat frontMask = allTrue;
+	SimdFloat spanningBits = simdZero();
+	for (int pass = 0; pass < 2; ++pass) {
+		unsigned passPlanes = pass == 0 ? first : (planeMask & ~first);
+		for (int i = 0; i < kFrustumPlaneCount; ++i) {
+			if ((passPlanes & (1u << i)) == 0) {
+				continue;
+			}
+			const SimdPlane& plane = planes[i];
+			SimdFloat minD = simdMul(plane.nx, plane.positiveX ? minX : maxX);
+			SimdFloat maxD = simdMul(plane.nx, plane.positiveX ? maxX : minX);
+			minD = simdAdd(minD, simdMul(plane.ny, plane.positiveY ? minY : maxY));
+			maxD = simdAdd(maxD, simdMul(plane.ny, plane.positiveY ? maxY : minY));
+			minD = simdAdd(minD, simdMul(plane.nz, plane.positiveZ ? minZ : maxZ));
+			maxD = simdAdd(maxD, simdMul(plane.nz, plane.positiveZ ? maxZ : minZ));
+
+			//AABB3::classifyPlane()һж棬minD == maxD == d ʱյĻƽϵAABB
+			SimdFloat front = simdCmpGe(minD, plane.d);
+			SimdFloat back = simdAndNot(front, simdCmpLe(maxD, plane.d));
+			//¼һαܾƽ
+			rejectedBy = simdSelect(simdAndNot(outsideMask, back), plane.index, rejectedBy);
+			outsideMask = simdOr(outsideMask, back);
+			frontMask = simdAnd(frontMask, front);
+			spanningBits = simdOr(spanningBits, simdAndNot(front, plane.bit));
+			if (simdMoveMask(outsideMask) == kSimdAllTrue) {
+				//ȫ׶⣬ƽ治ٲ
+				pass = 2;
+				break;
+			}
+		}
+	}
+
+	int outside = simdMoveMask(outsideMask);
+	int inside = simdMoveMask(frontMask);
+	float spanning[kSimdWidth];
+	if (returnMask != NULL) {
+		simdStore(spanning, spanningBits);
+	}
+	//ûAABBܾʱҪд
+	bool writeLastPlane = lastPlane != NULL && outside != 0;
+	if (writeLastPlane) {
+		simdStore(planeIndex, rejectedBy);
+	}
+	for (size_t j = 0; j < count; ++j) {
+		if (outside & (1 << j)) {
+			result[j] = kCullOutside;
+		}
+		else {
+			result[j] = (inside & (1 << j)) ? kCullInside : kCullIntersecting;
+		}
+		if (returnMask != NULL) {
+			returnMask[j] = (unsigned char)simdFloatToBits(spanning[j]);
+		}
+		if (writeLastPlane) {
+			lastPlane[j] = (unsigned char)planeIndex[j];
+		}
+	}
+}
+
+//ԣÿβkSimdWidth48AABB
+void cullAABBs(const Frustum& frustum, const AABB3Array& boxes, signed char* result,
+	unsigned planeMask, unsigned char* returnMask, unsigned char* lastPlane) {
+	const size_t n = boxes.size();
+	SimdPlane planes[kFrustumPlaneCount];
+	for (int i = 0; i < kFrustumPlaneCount; ++i) {
+		const Vector3& normal = frustum.n[i];
+		planes[i].nx = simdSet(normal.x);
+		planes[i].ny = simdSet(normal.y);
+		planes[i].nz = simdSet(normal.z);
+		planes[i].d = simdSet(frustum.d[i]);
+		planes[i].bit = simdSet(simdBitsToFloat(1u << i));
+		planes[i].index = simdSet((float)i);
+		planes[i].positiveX = normal.x > 0.0f;
+		planes[i].positiveY = normal.y > 0.0f;
+		planes[i].positiveZ = normal.z > 0.0f;
+	}
+
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		simdCullBlock(planes, planeMask, kSimdWidth,
+			simdLoadAligned(boxes.min.x + i), simdLoadAligned(boxes.min.y + i), simdLoadAligned(boxes.min.z + i),
+			simdLoadAligned(boxes.max.x + i), simdLoadAligned(boxes.max.y + i), simdLoadAligned(boxes.max.z + i),
+			result + i, returnMask != NULL ? returnMask + i : NULL, lastPlane != NULL ? lastPlane + i : NULL);
+	}
+	if (i < n) {
+		//ʣ²һAABBƵʱУ㣬ֻдЧ
+		const size_t count = n - i;
+		float temp[6][kSimdWidth] = {};
+		unsigned char tempLastPlane[kSimdWidth];
+		memset(tempLastPlane, kFrustumNoPlane, sizeof(tempLastPlane));
+		for (size_t j = 0; j < count; ++j) {
+			temp[0][j] = boxes.min.x[i + j];
+			temp[1][j] = boxes.min.y[i + j];
+			temp[2][j] = boxes.min.z[i + j];
+			temp[3][j] = boxes.max.x[i + j];
+			temp[4][j] = boxes.max.y[i + j];
+			temp[5][j] = boxes.max.z[i + j];
+			tempLastPlane[j] = lastPlane != NULL ? lastPlane[i + j] : kFrustumNoPlane;
+		}
+		simdCullBlock(planes, planeMask, count,
+			simdLoad(temp[0]), simdLoad(temp[1]), simdLoad(temp[2]),
+			simdLoad(temp[3]), simdLoad(temp[4]), simdLoad(temp[5]),
+			result + i, returnMask != NULL ? returnMask + i : NULL, lastPlane != NULL ? tempLastPlane : NULL);
+		for (size_t j = 0; j < count && lastPlane != NULL; ++j) {
+			lastPlane[i + j] = tempLastPlane[j];
+		}
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#ifndef __FRUSTUM_H_INCLUDED__
+#define __FRUSTUM_H_INCLUDED__
+
+#include <stddef.h>
+#include "Vector3.h"
+
+template <typename T> class AABB3T;
+typedef AABB3T<float> AABB3;
+class AABB3Array;
+template <typename T> class Matrix4x3T;
+typedef Matrix4x3T<float> Matrix4x3;
+
+// ƣ׶
+// ߣcary
+// ƽΧɵ׶壬üAABB
+//		ÿƽķָ׶ڲƽĵ׶
+//		AABBĲֱʹAABB3::classifyPlane()ԶAABB3ArrayʹSIMD
+//		ߵ˳ͬüȫһ
+//		ʱһAABBȲϴξܾƽĲ¼ľܾƽܺ͵Բͬ
+//
+//		ƽ룺iλΪ1ʾҪԵiƽ
+//		ڵȫĳƽʱӽڵ㲻Ҫٲƽ棬
+//		Ѹڵ㷵ص봫ӽڵ㼴
+//
+//		ϴξܾƽ棺ÿ¼һΰжΪ׶ƽ棬
+//		һ֡Ȳƽ棬ƶʱͨһξܾܾ
+
+//üAABB3::classifyPlane()ķһ
+enum CullResult {
+	kCullOutside = -1,
+	kCullIntersecting = 0,
+	kCullInside = 1
+};
+
+//ƽ±
+enum FrustumPlane {
+	kFrustumLeft,
+	kFrustumRight,
+	kFrustumBottom,
+	kFrustumTop,
+	kFrustumNear,
+	kFrustumFar,
+	kFrustumPlaneCount
+};
+
+//ȫƽ
+const unsigned kFrustumAllPlanes = (1 << kFrustumPlaneCount) - 1;
+//ûоܾġϴξܾƽ桱
+const unsigned char kFrustumNoPlane = 0xff;
+
+class Frustum
+{
+public:
+	//ƽ淽 p*n = dΪλָ׶ڲ
+	Vector3 n[kFrustumPlaneCount];
+	float d[kFrustumPlaneCount];
+
+	Frustum() {}
+
+	//ֱӸƽ棬˳FrustumPlaneָ׶ڲ
+	void setPlanes(const Vector3* normals, const float* planeD);
+
+	//ռ䡪>ռı任
+	//ռΪϵ+z+yϣ+x
+	//fovX ˮƽӳǣȣaspect ߱ȣ/ߣ
+	//nearClip, farClip üԶüľ
+	void setupFromView(const Matrix4x3& worldToCamera, float fovX, float aspect, float nearClip, float farClip);
+
+	//һAABB
+	//planeMask ҪԵƽ棬ƽΪѾͨ
+	//returnMask ѡAABBƽ룬ΪӽڵplaneMask׶ʱû
+	//lastPlane ѡϴξܾAABBƽ棨Ȳԣξܾƽ棬ûбܾʱ
+	//CullResult
+	int classifyAABB(const AABB3& box, unsigned planeMask = kFrustumAllPlanes,
+		unsigned* returnMask = 0, unsigned char* lastPlane = 0) const;
+};
+
+//ԣÿβkSimdWidth48AABBüFrustum::classifyAABB()ͬ
+//result Ҫ boxes.size() ԪأCullResult
+//planeMask AABBͬһǹͬĸڵ㷵ص
+//returnMask, lastPlane ѡÿAABBһԪأlastPlaneʼΪkFrustumNoPlane
+//lastPlane ľܾƽܺFrustum::classifyAABB()ͬ
+void cullAABBs(const Frustum& frustum, const AABB3Array& boxes, signed char* result,
+	unsigned planeMask = kFrustumAllPlanes, unsigned char* returnMask = 0, unsigned char* lastPlane = 0);
+
+#endif // #ifndef __FRUSTUM_H_INCLUDED__
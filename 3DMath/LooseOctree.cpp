@@ -0,0 +1,481 @@
+#include <assert.h>
+
+#include "LooseOctree.h"
+#include "Frustum.h"
+
+// ƣɢ˲
+// ߣcary
+// ĴС
+//			߳ e  e <= (looseness - 1) * h ȣhΪȵԪİ߳
+//		ٰڵ£ÿֻһڵУO()
+//		ɢ߽ǵԪloosenessŴӽڵɢ߽絽ڵĵľΪ (1 + looseness) / 2 * h
+//		ڵ looseness * hе嶼ڵɢ߽ڣѯʱڵһܻܾ
+//
+//		ÿڵ㱣е飬¼еλãɾʱһԪؽO(1)
+//		ڵ¼е0ʱŻؽڵأ֤ѯյ
+//
+//		ڵûб߽磬ѯʱǱǶӽڵճ
+
+//ʽջȱÿ7ֵܽڵ
+const int kMaxStackSize = LooseOctree::kMaxDepthLimit * 7 + 8;
+
+LooseOctree::LooseOctree(const Vector3& center, float halfSize, int maxDepth, float looseness)
+	: looseness(looseness), maxDepth(maxDepth), objectCount(0), updateCount(0), relocationCount(0)
+{
+	assert(halfSize > 0.0f);
+	assert(maxDepth >= 0 && maxDepth <= kMaxDepthLimit);
+	assert(looseness > 1.0f);
+	nodes.resize(1);
+	Node& root = nodes[0];
+	root.center = center;
+	root.halfSize = halfSize;
+	Vector3 loose(halfSize * looseness, halfSize * looseness, halfSize * looseness);
+	root.looseBox.min = center - loose;
+	root.looseBox.max = center + loose;
+	root.parent = -1;
+	root.octant = 0;
+	root.depth = 0;
+	for (int i = 0; i < 8; ++i) {
+		root.children[i] = -1;
+	}
+	root.subtreeCount = 0;
+}
+
+//壬ؾ
+int LooseOctree::add(const AABB3& box)
+{
+	assert(!box.isEmpty());
+	int handle;
+	if (!freeHandles.empty()) {
+		handle = freeHandles.back();
+		freeHandles.pop_back();
+	}
+	else {
+		handle = (int)objects.size();
+		objects.resize(objects.size() + 1);
+	}
+	objects[handle].box = box;
+	insertObject(handle);
+	++objectCount;
+	return handle;
+}
+
+//ɾ
+void LooseOctree::remove(int handle)
+{
+	assert(handle >= 0 && handle < (int)objects.size());
+	assert(objects[handle].node >= 0);
+	removeObject(handle);
+	objects[handle].node = -1;
+	freeHandles.push_back(handle);
+	--objectCount;
+}
+
+//ƶ壬ԭڵɢ߽ʱֻAABB
+//ڵеܷŽӽڵʱƶ
+void LooseOctree::update(int handle, const AABB3& box)
+{
+	assert(handle >= 0 && handle < (int)objects.size());
+	assert(objects[handle].node >= 0);
+	assert(!box.isEmpty());
+	Object& object = objects[handle];
+	object.box = box;
+	++updateCount;
+	const Node& node = nodes[object.node];
+	int octant;
+	bool stay;
+	if (object.node == 0) {
+		stay = maxDepth == 0 || !fitsChild(0, box, &octant);
+	}
+	else {
+		stay = box.min.x >= node.looseBox.min.x && box.max.x <= node.looseBox.max.x
+			&& box.min.y >= node.looseBox.min.y && box.max.y <= node.looseBox.max.y
+			&& box.min.z >= node.looseBox.min.z && box.max.z <= node.looseBox.max.z;
+	}
+	if (!stay) {
+		removeObject(handle);
+		insertObject(handle);
+		++relocationCount;
+	}
+}
+
+//ͳϢ
+LooseOctree::Stats LooseOctree::getStats() const
+{
+	Stats stats;
+	stats.nodeCount = nodes.size() - freeNodes.size();
+	stats.objectCount = objectCount;
+	stats.maxDepth = 0;
+	stats.memoryBytes = nodes.capacity() * sizeof(Node) + freeNodes.capacity() * sizeof(int)
+		+ objects.capacity() * sizeof(Object) + freeHandles.capacity() * sizeof(int);
+	for (size_t i = 0; i < nodes.size(); ++i) {
+		const Node& node = nodes[i];
+		stats.memoryBytes += node.objects.capacity() * sizeof(int);
+		if (!node.objects.empty() && node.depth > stats.maxDepth) {
+			stats.maxDepth = node.depth;
+		}
+	}
+	stats.updateCount = updateCount;
+	stats.relocationCount = relocationCount;
+	return stats;
+}
+
+void LooseOctree::resetUpdateStats()
+{
+	updateCount = 0;
+	relocationCount = 0;
+}
+
+//ӽڵзnodes[parent]ӽڵ㣬octantΪڵ
+int LooseOctree::allocateNode(int parent, int octant)
+{
+	int index;
+	if (!freeNodes.empty()) {
+		index = freeNodes.back();
+		freeNodes.pop_back();
+	}
+	else {
+		index = (int)nodes.size();
+		nodes.resize(nodes.size() + 1);
+	}
+	//resize()֮ȡ
+	const Node& parentNode = nodes[parent];
+	Node& node = nodes[index];
+	float halfSize = parentNode.halfSize * 0.5f;
+	node.center.x = parentNode.center.x + ((octant & 1) ? halfSize : -halfSize);
+	node.center.y = parentNode.center.y + ((octant & 2) ? halfSize : -halfSize);
+	node.center.z = parentNode.center.z + ((octant & 4) ? halfSize : -halfSize);
+	node.halfSize = halfSize;
+	float loose = halfSize * looseness;
+	node.looseBox.min = node.center - Vector3(loose, loose, loose);
+	node.looseBox.max = node.center + Vector3(loose, loose, loose);
+	node.parent = parent;
+	node.octant = octant;
+	node.depth = parentNode.depth + 1;
+	for (int i = 0; i < 8; ++i) {
+		node.children[i] = -1;
+	}
+	node.subtreeCount = 0;
+	nodes[parent].children[octant] = index;
+	return index;
+}
+
+//trueӦ÷ŵnodes[nodeIndex]ӽڵУreturnOctantӽڵ
+//岻ܱӽڵĴС󣬲ұӽڵɢ߽ڣڸڵĵԪʱܲ
+bool LooseOctree::fitsChild(int nodeIndex, const AABB3& box, int* returnOctant) const
+{
+	const Node& node = nodes[nodeIndex];
+	float childHalf = node.halfSize * 0.5f;
+	Vector3 extent = (box.max - box.min) * 0.5f;
+	float maxExtent = extent.x > extent.y ? extent.x : extent.y;
+	maxExtent = maxExtent > extent.z ? maxExtent : extent.z;
+	if (maxExtent > (looseness - 1.0f) * childHalf) {
+		return false;
+	}
+	Vector3 center = box.center();
+	int octant = (center.x >= node.center.x ? 1 : 0)
+		| (center.y >= node.center.y ? 2 : 0)
+		| (center.z >= node.center.z ? 4 : 0);
+	//allocateNode()ļ֤ͬһ
+	float loose = childHalf * looseness;
+	Vector3 childCenter;
+	childCenter.x = node.center.x + ((octant & 1) ? childHalf : -childHalf);
+	childCenter.y = node.center.y + ((octant & 2) ? childHalf : -childHalf);
+	childCenter.z = node.center.z + ((octant & 4) ? childHalf : -childHalf);
+	Vector3 looseMin = childCenter - Vector3(loose, loose, loose);
+	Vector3 looseMax = childCenter + Vector3(loose, loose, loose);
+	if (box.min.x < looseMin.x || box.max.x > looseMax.x
+		|| box.min.y < looseMin.y || box.max.y > looseMax.y
+		|| box.min.z < looseMin.z || box.max.z > looseMax.z) {
+		return false;
+	}
+	*returnOctant = octant;
+	return true;
+}
+
+//ӸڵҵӦڵĽڵ㣬ȱٵĽڵӽڵз
+void LooseOctree::insertObject(int handle)
+{
+	Object& object = objects[handle];
+	int index = 0;
+	int octant;
+	while (nodes[index].depth < maxDepth && fitsChild(index, object.box, &octant)) {
+		int child = nodes[index].children[octant];
+		index = child >= 0 ? child : allocateNode(index, octant);
+	}
+	Node& node = nodes[index];
+	object.node = index;
+	object.position = (int)node.objects.size();
+	node.objects.push_back(handle);
+	for (int i = index; i >= 0; i = nodes[i].parent) {
+		++nodes[i].subtreeCount;
+	}
+}
+
+//ڵĽڵɾ壬ûĽڵŻؽڵ
+void LooseOctree::removeObject(int handle)
+{
+	const Object& object = objects[handle];
+	Node& node = nodes[object.node];
+	//һԪƵճλ
+	int last = node.objects.back();
+	node.objects[object.position] = last;
+	objects[last].position = object.position;
+	node.objects.pop_back();
+	for (int i = object.node; i >= 0;) {
+		Node& n = nodes[i];
+		int parent = n.parent;
+		if (--n.subtreeCount == 0 && parent >= 0) {
+			nodes[parent].children[n.octant] = -1;
+			n.depth = -1;
+			freeNodes.push_back(i);
+		}
+		i = parent;
+	}
+}
+
+//е׷ӵresultĩβ
+void LooseOctree::appendSubtree(int nodeIndex, std::vector<int>* result) const
+{
+	int stack[kMaxStackSize];
+	int top = 0;
+	stack[top++] = nodeIndex;
+	while (top > 0) {
+		const Node& node = nodes[stack[--top]];
+		result->insert(result->end(), node.objects.begin(), node.objects.end());
+		for (int i = 0; i < 8; ++i) {
+			if (node.children[i] >= 0) {
+				stack[top++] = node.children[i];
+			}
+		}
+	}
+}
+
+//ߺͽڵƽԣBVHеͬrayDeltaInvΪĵ
+//true[0,tMax]ںͽڵཻtEnterؽڵʱĲֵ
+static bool raySlab(const AABB3& box, const Vector3& rayOrg, const Vector3& rayDeltaInv, float tMax, float* tEnter) {
+	float t0 = 0.0f;
+	float t1 = tMax;
+	float tNear, tFar;
+
+	tNear = ((rayDeltaInv.x < 0.0f ? box.max.x : box.min.x) - rayOrg.x) * rayDeltaInv.x;
+	tFar = ((rayDeltaInv.x < 0.0f ? box.min.x : box.max.x) - rayOrg.x) * rayDeltaInv.x;
+	if (tNear > t0) t0 = tNear;
+	if (tFar < t1) t1 = tFar;
+
+	tNear = ((rayDeltaInv.y < 0.0f ? box.max.y : box.min.y) - rayOrg.y) * rayDeltaInv.y;
+	tFar = ((rayDeltaInv.y < 0.0f ? box.min.y : box.max.y) - rayOrg.y) * rayDeltaInv.y;
+	if (tNear > t0) t0 = tNear;
+	if (tFar < t1) t1 = tFar;
+
+	tNear = ((rayDeltaInv.z < 0.0f ? box.max.z : box.min.z) - rayOrg.z) * rayDeltaInv.z;
+	tFar = ((rayDeltaInv.z < 0.0f ? box.min.z : box.max.z) - rayOrg.z) * rayDeltaInv.z;
+	if (tNear > t0) t0 = tNear;
+	if (tFar < t1) t1 = tFar;
+
+	*tEnter = t0;
+	return t0 <= t1;
+}
+
+//߲ѯAABB3::rayIntersect()ཻͬĲֵ
+float LooseOctree::rayIntersect(const Vector3& rayOrg, const Vector3& rayDelta, int* returnHandle, Vector3* returnNoamal) const
+{
+	const Vector3 rayDeltaInv(1.0f / rayDelta.x, 1.0f / rayDelta.y, 1.0f / rayDelta.z);
+	float best = kNoIntersection;
+	int bestHandle = -1;
+
+	struct StackEntry {
+		int node;
+		float tEnter;
+	};
+	StackEntry stack[kMaxStackSize];
+	int top = 0;
+	if (nodes[0].subtreeCount > 0) {
+		stack[top].node = 0;
+		stack[top].tEnter = 0.0f;
+		++top;
+	}
+
+	while (top > 0) {
+		--top;
+		//ջ֮Ѿҵ˸ཻ
+		if (stack[top].tEnter > best) {
+			continue;
+		}
+		const Node& node = nodes[stack[top].node];
+		for (size_t i = 0; i < node.objects.size(); ++i) {
+			int handle = node.objects[i];
+			float t = objects[handle].box.rayIntersect(rayOrg, rayDelta);
+			if (t < best) {
+				best = t;
+				bestHandle = handle;
+			}
+		}
+
+		//ӽڵ㰴ĲֵԶջȱ
+		float tMax = best < 1.0f ? best : 1.0f;
+		StackEntry hits[8];
+		int hitCount = 0;
+		for (int i = 0; i < 8; ++i) {
+			int child = node.children[i];
+			float tEnter;
+			if (child >= 0 && raySlab(nodes[child].looseBox, rayOrg, rayDeltaInv, tMax, &tEnter)) {
+				int k = hitCount++;
+				for (; k > 0 && hits[k - 1].tEnter < tEnter; --k) {
+					hits[k] = hits[k - 1];
+				}
+				hits[k].node = child;
+				hits[k].tEnter = tEnter;
+			}
+		}
+		for (int k = 0; k < hitCount; ++k) {
+			stack[top++] = hits[k];
+		}
+	}
+
+	if (bestHandle < 0) {
+		return kNoIntersection;
+	}
+	if (returnHandle != NULL) {
+		*returnHandle = bestHandle;
+	}
+	if (returnNoamal != NULL) {
+		objects[bestHandle].box.rayIntersect(rayOrg, rayDelta, returnNoamal);
+	}
+	return best;
+}
+
+//trueouterȫinner
+static bool containsAABB(const AABB3& outer, const AABB3& inner) {
+	return inner.min.x >= outer.min.x && inner.max.x <= outer.max.x
+		&& inner.min.y >= outer.min.y && inner.max.y <= outer.max.y
+		&& inner.min.z >= outer.min.z && inner.max.z <= outer.max.z;
+}
+
+//ҺboxཻintersectAABBs()壬׷ӵresultĩβ
+void LooseOctree::queryAABB(const AABB3& box, std::vector<int>* result) const
+{
+	int stack[kMaxStackSize];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		int index = stack[--top];
+		const Node& node = nodes[index];
+		//ڵ㶼ڲѯΧڣԣڵûб߽
+		if (index != 0 && containsAABB(box, node.looseBox)) {
+			appendSubtree(index, result);
+			continue;
+		}
+		for (size_t i = 0; i < node.objects.size(); ++i) {
+			if (intersectAABBs(objects[node.objects[i]].box, box)) {
+				result->push_back(node.objects[i]);
+			}
+		}
+		for (int i = 0; i < 8; ++i) {
+			int child = node.children[i];
+			if (child >= 0 && intersectAABBs(nodes[child].looseBox, box)) {
+				stack[top++] = child;
+			}
+		}
+	}
+}
+
+//ҺཻAABB3::intersectsSphere()壬׷ӵresultĩβ
+void LooseOctree::querySphere(const Vector3& center, float radius, std::vector<int>* result) const
+{
+	int stack[kMaxStackSize];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		const Node& node = nodes[stack[--top]];
+		for (size_t i = 0; i < node.objects.size(); ++i) {
+			if (objects[node.objects[i]].box.intersectsSphere(center, radius)) {
+				result->push_back(node.objects[i]);
+			}
+		}
+		for (int i = 0; i < 8; ++i) {
+			int child = node.children[i];
+			if (child >= 0 && nodes[child].looseBox.intersectsSphere(center, radius)) {
+				stack[top++] = child;
+			}
+		}
+	}
+}
+
+//AABB3::classifyPlane()Ľֳ
+void LooseOctree::classifyPlane(const Vector3& n, float d,
+	std::vector<int>* front, std::vector<int>* back, std::vector<int>* spanning) const
+{
+	int stack[kMaxStackSize];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		int index = stack[--top];
+		const Node& node = nodes[index];
+		int side = index != 0 ? node.looseBox.classifyPlane(n, d) : 0;
+		//ƽһ
+		if (side != 0) {
+			std::vector<int>* result = side > 0 ? front : back;
+			if (result != NULL) {
+				appendSubtree(index, result);
+			}
+			continue;
+		}
+		for (size_t i = 0; i < node.objects.size(); ++i) {
+			int objectSide = objects[node.objects[i]].box.classifyPlane(n, d);
+			std::vector<int>* result = objectSide > 0 ? front : (objectSide < 0 ? back : spanning);
+			if (result != NULL) {
+				result->push_back(node.objects[i]);
+			}
+		}
+		for (int i = 0; i < 8; ++i) {
+			if (node.children[i] >= 0) {
+				stack[top++] = node.children[i];
+			}
+		}
+	}
+}
+
+//Ҳ׶⣨Frustum::classifyAABB()壬׷ӵresultĩβ
+void LooseOctree::queryFrustum(const Frustum& frustum, std::vector<int>* result) const
+{
+	struct StackEntry {
+		int node;
+		//ڵƽ
+		unsigned planeMask;
+	};
+	StackEntry stack[kMaxStackSize];
+	int top = 0;
+	stack[top].node = 0;
+	stack[top].planeMask = kFrustumAllPlanes;
+	++top;
+	while (top > 0) {
+		--top;
+		int index = stack[top].node;
+		unsigned planeMask = stack[top].planeMask;
+		const Node& node = nodes[index];
+		if (index != 0) {
+			int side = frustum.classifyAABB(node.looseBox, planeMask, &planeMask);
+			if (side == kCullOutside) {
+				continue;
+			}
+			//׶
+			if (side == kCullInside) {
+				appendSubtree(index, result);
+				continue;
+			}
+		}
+		for (size_t i = 0; i < node.objects.size(); ++i) {
+			if (frustum.classifyAABB(objects[node.objects[i]].box, planeMask) != kCullOutside) {
+				result->push_back(node.objects[i]);
+			}
+		}
+		for (int i = 0; i < 8; ++i) {
+			if (node.children[i] >= 0) {
+				stack[top].node = node.children[i];
+				stack[top].planeMask = planeMask;
+				++top;
+			}
+		}
+	}
+}
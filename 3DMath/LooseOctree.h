@@ -0,0 +1,126 @@
+#pragma once
+
+#ifndef __LOOSEOCTREE_H_INCLUDED__
+#define __LOOSEOCTREE_H_INCLUDED__
+
+#include <stddef.h>
+#include <vector>
+#include "AABB3.h"
+
+class Frustum;
+
+// ƣɢ˲
+// ߣcary
+// Զ̬µɢ˲loose octreeߡ׶塢ƽ桢AABBѯ
+//		ÿڵĵԪ壬ġɢ߽硱ǵԪloosenessŴ
+//		ĽڵУİ߳ (looseness - 1) * Ԫ߳
+//		ڸýڵĵԪУһڽڵɢ߽
+//		ƶֻҪԭڵɢ߽ھͲҪƶֻAABB
+//
+//		ڵӽڵз䣬ûʱڵ㱻
+//		ڵı߽޵ģΧ̫嶼ڸڵ
+
+class LooseOctree
+{
+public:
+	//ͳϢ
+	struct Stats {
+		//ʹеĽڵ
+		size_t nodeCount;
+		//
+		size_t objectCount;
+		//ڵȣڵΪ0
+		int maxDepth;
+		//ڵءԼڵռõڴ棬
+		size_t memoryBytes;
+		//ϴresetUpdateStats()update()ĵôԼҪƵڵĴ
+		size_t updateCount;
+		size_t relocationCount;
+	};
+
+	//ȵ
+	static const int kMaxDepthLimit = 16;
+
+	//center, halfSize ڵ㵥ԪĺͰ߳һȡķΧ
+	//maxDepth ȣkMaxDepthLimit
+	//looseness ɢ߽ķŴ1һȡ2
+	LooseOctree(const Vector3& center, float halfSize, int maxDepth = 8, float looseness = 2.0f);
+
+	//壬ؾɾľᱻظʹ
+	//AABBΪգ޵ֵ
+	int add(const AABB3& box);
+	void remove(int handle);
+	//ƶ壬ԭڵɢ߽ʱֻAABB
+	void update(int handle, const AABB3& box);
+
+	const AABB3& getBox(int handle) const { return objects[handle].box; }
+	//
+	size_t size() const { return objectCount; }
+
+	Stats getStats() const;
+	void resetUpdateStats();
+
+	//߲ѯAABB3::rayIntersect()ཻͬĲֵδཻʱkNoIntersection
+	//returnHandle ѡཻľ
+	//returnNoamal ѡཻķ
+	float rayIntersect(const Vector3& rayOrg, const Vector3& rayDelta, int* returnHandle = 0, Vector3* returnNoamal = 0) const;
+
+	//ҺboxཻintersectAABBs()壬׷ӵresultĩβ
+	void queryAABB(const AABB3& box, std::vector<int>* result) const;
+	//ҺཻAABB3::intersectsSphere()壬׷ӵresultĩβ
+	void querySphere(const Vector3& center, float radius, std::vector<int>* result) const;
+	//AABB3::classifyPlane()Ľֳ飬ֱ׷ӵӦĩβ
+	//front ȫƽ棬back ȫƽ汳棬spanning ƽ棬ΪNULLʱռ
+	//ڵ㶼ƽһʱ
+	void classifyPlane(const Vector3& n, float d,
+		std::vector<int>* front, std::vector<int>* back, std::vector<int>* spanning) const;
+	//Ҳ׶⣨Frustum::classifyAABB()壬׷ӵresultĩβ
+	//ڵƽ봫ӽڵ㣬ڵ㶼׶ʱ
+	void queryFrustum(const Frustum& frustum, std::vector<int>* result) const;
+
+private:
+	struct Node {
+		Vector3 center;
+		float halfSize;
+		//ɢ߽
+		AABB3 looseBox;
+		int parent;
+		//ڸڵеλã012λֱʾxyzǷڸڵĵ
+		int octant;
+		int depth;
+		//ӽڵ㣬ûʱΪ-1
+		int children[8];
+		//ڸýڵеľ
+		std::vector<int> objects;
+		//ýڵ㣩еΪ0ʱ
+		int subtreeCount;
+	};
+
+	struct Object {
+		AABB3 box;
+		//ڵĽڵ㣬ɾʱΪ-1
+		int node;
+		//ڸýڵobjectsе±
+		int position;
+	};
+
+	float looseness;
+	int maxDepth;
+
+	//ڵأnodes[0]Ϊڵ㣬յĽڵfreeNodesУobjects
+	std::vector<Node> nodes;
+	std::vector<int> freeNodes;
+	std::vector<Object> objects;
+	std::vector<int> freeHandles;
+	size_t objectCount;
+	size_t updateCount;
+	size_t relocationCount;
+
+	int allocateNode(int parent, int octant);
+	bool fitsChild(int nodeIndex, const AABB3& box, int* returnOctant) const;
+	void insertObject(int handle);
+	void removeObject(int handle);
+	void appendSubtree(int nodeIndex, std::vector<int>* result) const;
+};
+
+#endif // #ifndef __LOOSEOCTREE_H_INCLUDED__
@@ -1,13 +1,12 @@
 #include<math.h>
 #include "MathUtil.h"
+#include "SimdMath.h"
 #include "Vector3.h"
 
 // ƣѧ
 // ߣcary
 // װһЩѧʽ
 
-const Vector3 kZeroVector(0.0f, 0.0f, 0.0f);
-
 // ͨʵ2piǶ[-pi,pi]
 float warpPi(float theta) {
 	theta += kPi;
@@ -29,3 +28,131 @@ extern float safeAcos(float x) {
 	//ʹñ׼C
 	return acos(x);
 }
+
+// Ǻ
+// ֵĽư汾Ѳ㲥SIMDĴм㣬֤汾Ľһ
+void fastSinCos(float* returnSin, float* returnCos, float theta, MathPrecision precision) {
+	if (precision == kPrecisionFull) {
+		sinCos(returnSin, returnCos, theta);
+		return;
+	}
+	SimdFloat s, c;
+	simdSinCos(simdSet(theta), &s, &c, precision);
+	*returnSin = simdFirst(s);
+	*returnCos = simdFirst(c);
+}
+
+float fastAcos(float x, MathPrecision precision) {
+	if (precision == kPrecisionFull) {
+		return safeAcos(x);
+	}
+	return simdFirst(simdAcos(simdSet(x), precision));
+}
+
+float fastAsin(float x, MathPrecision precision) {
+	if (precision == kPrecisionFull) {
+		if (x <= -1.0f) {
+			return -kPiOver2;
+		}
+		if (x >= 1.0f) {
+			return kPiOver2;
+		}
+		return asin(x);
+	}
+	return simdFirst(simdAsin(simdSet(x), precision));
+}
+
+float fastAtan2(float y, float x, MathPrecision precision) {
+	if (precision == kPrecisionFull) {
+		return atan2(y, x);
+	}
+	return simdFirst(simdAtan2(simdSet(y), simdSet(x), precision));
+}
+
+// 汾
+// kSimdWidthβȸƵʱУ㣬ֻдЧ
+
+void sinCosArray(const float* theta, float* returnSin, float* returnCos, size_t n, MathPrecision precision) {
+	size_t simdEnd = n - n % kSimdWidth;
+	SimdFloat s, c;
+	for (size_t i = 0; i < simdEnd; i += kSimdWidth) {
+		simdSinCos(simdLoad(theta + i), &s, &c, precision);
+		simdStore(returnSin + i, s);
+		simdStore(returnCos + i, c);
+	}
+	if (simdEnd < n) {
+		float temp[kSimdWidth] = {}, tempSin[kSimdWidth], tempCos[kSimdWidth];
+		for (size_t i = simdEnd; i < n; ++i) {
+			temp[i - simdEnd] = theta[i];
+		}
+		simdSinCos(simdLoad(temp), &s, &c, precision);
+		simdStore(tempSin, s);
+		simdStore(tempCos, c);
+		for (size_t i = simdEnd; i < n; ++i) {
+			returnSin[i] = tempSin[i - simdEnd];
+			returnCos[i] = tempCos[i - simdEnd];
+		}
+	}
+}
+
+void acosArray(const float* x, float* out, size_t n, MathPrecision precision) {
+	size_t simdEnd = n - n % kSimdWidth;
+	for (size_t i = 0; i < simdEnd; i += kSimdWidth) {
+		simdStore(out + i, simdAcos(simdLoad(x + i), precision));
+	}
+	if (simdEnd < n) {
+		float temp[kSimdWidth] = {};
+		for (size_t i = simdEnd; i < n; ++i) {
+			temp[i - simdEnd] = x[i];
+		}
+		simdStore(temp, simdAcos(simdLoad(temp), precision));
+		for (size_t i = simdEnd; i < n; ++i) {
+			out[i] = temp[i - simdEnd];
+		}
+	}
+}
+
+void asinArray(const float* x, float* out, size_t n, MathPrecision precision) {
+	size_t simdEnd = n - n % kSimdWidth;
+	for (size_t i = 0; i < simdEnd; i += kSimdWidth) {
+		simdStore(out + i, simdAsin(simdLoad(x + i), precision));
+	}
+	if (simdEnd < n) {
+		float temp[kSimdWidth] = {};
+		for (size_t i = simdEnd; i < n; ++i) {
+			temp[i - simdEnd] = x[i];
+		}
+		simdStore(temp, simdAsin(simdLoad(temp), precision));
+		for (size_t i = simdEnd; i < n; ++i) {
+			out[i] = temp[i - simdEnd];
+		}
+	}
+}
+
+void atan2Array(const float* y, const float* x, float* out, size_t n, MathPrecision precision) {
+	size_t simdEnd = n - n % kSimdWidth;
+	for (size_t i = 0; i < simdEnd; i += kSimdWidth) {
+		simdStore(out + i, simdAtan2(simdLoad(y + i), simdLoad(x + i), precision));
+	}
+	if (simdEnd < n) {
+		float tempY[kSimdWidth] = {}, tempX[kSimdWidth] = {};
+		for (size_t i = simdEnd; i < n; ++i) {
+			tempY[i - simdEnd] = y[i];
+			tempX[i - simdEnd] = x[i];
+		}
+		simdStore(tempY, simdAtan2(simdLoad(tempY), simdLoad(tempX), precision));
+		for (size_t i = simdEnd; i < n; ++i) {
+			out[i] = tempY[i - simdEnd];
+		}
+	}
+}
+
+void warpPiArray(const float* theta, float* out, size_t n) {
+	size_t simdEnd = n - n % kSimdWidth;
+	for (size_t i = 0; i < simdEnd; i += kSimdWidth) {
+		simdStore(out + i, simdWarpPi(simdLoad(theta + i)));
+	}
+	for (size_t i = simdEnd; i < n; ++i) {
+		out[i] = warpPi(theta[i]);
+	}
+}
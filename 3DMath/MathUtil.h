@@ -4,6 +4,7 @@
 #define __MATHUTIL_H_INCLUDED__
 
 #include <math.h>
+#include <stddef.h>
 
 // ƣѧ
 // ߣcary
@@ -29,4 +30,37 @@ inline void sinCos(float* returnSin, float* returnCos, float theta) {
 	*returnCos = cos(theta);
 }
 
+// ѧľȵȼ
+// kPrecisionFull ͱ׼⺯floatȸԼ1e-7
+// kPrecisionMedium Լ1e-5ʺ϶һ̬
+// kPrecisionLow Լ1e-3ʺӡЧȶԾȲеĳ
+// ľSimdMath.h
+enum MathPrecision {
+	kPrecisionFull,
+	kPrecisionMedium,
+	kPrecisionLow
+};
+
+// Ǻ
+// kPrecisionFull ֱӵñ׼⺯ȼʹöʽ
+// fastAcos()fastAsin()safeAcos()һx[-1,1]ʱΪӽЧֵ
+extern void fastSinCos(float* returnSin, float* returnCos, float theta, MathPrecision precision);
+extern float fastAcos(float x, MathPrecision precision);
+extern float fastAsin(float x, MathPrecision precision);
+extern float fastAtan2(float y, float x, MathPrecision precision);
+// double汾ֱӵñ׼⺯precisiondoubleľģ
+inline void fastSinCos(double* returnSin, double* returnCos, double theta, MathPrecision) {
+	*returnSin = sin(theta);
+	*returnCos = cos(theta);
+}
+
+// 汾һδnֵʹSIMDָ
+// еȼkPrecisionFullʹöʽƣͶӦĵ汾һȫͬ
+// ͬһ
+extern void sinCosArray(const float* theta, float* returnSin, float* returnCos, size_t n, MathPrecision precision);
+extern void acosArray(const float* x, float* out, size_t n, MathPrecision precision);
+extern void asinArray(const float* x, float* out, size_t n, MathPrecision precision);
+extern void atan2Array(const float* y, const float* x, float* out, size_t n, MathPrecision precision);
+extern void warpPiArray(const float* theta, float* out, size_t n);
+
 #endif //#ifndef __MATHUTIL_H_INCLUDED__
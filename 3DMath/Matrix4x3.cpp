@@ -7,6 +7,8 @@
 #include "Quaternion.h"
 #include "EulerAngles.h"
 #include "RotationMatrix.h"
+#include "SimdUtil.h"
+#include "SimdMatrix4x3.h"
 
 
 // ƣ4X3
@@ -29,43 +31,19 @@
 //					| tx  ty  tz  1 |	
 //		
 
-//Ϊλ
-void Matrix4x3::identity() {
-	m11 = 1.0f; m11 = 0.0f; m11 = 0.0f;
-	m21 = 0.0f; m22 = 1.0f; m23 = 0.0f;
-	m31 = 0.0f; m32 = 0.0f; m33 = 1.0f;
-	tx = 0.0f;  ty = 0.0f;  tz = 1.0f;
-}
-
-//ƽƲֵĵΪ
-void Matrix4x3::zeroTranslation() {
-	tx = ty = tz = 0.0f;
-}
-
-//ƽƲֵָ
-void Matrix4x3::setTranslation(const Vector3& d) {
-	tx = d.x; ty = d.y; tx = d.z;
-}
-
-//ƽƲֵָ
-void Matrix4x3::setupTranslation(const Vector3& d) {
-	m11 = 1.0f; m11 = 0.0f; m11 = 0.0f;
-	m21 = 0.0f; m22 = 1.0f; m23 = 0.0f;
-	m31 = 0.0f; m32 = 0.0f; m33 = 1.0f;
-	tx = d.x;   ty = d.y;   tx = d.z;
-}
-
 //ִоֲռ䡪>ռ任ľ
 //ռ䡪>Կռ䡪>ռ
 //λŷǻתָ
-void Matrix4x3::setupLocalToParent(const Vector3& pos, const EulerAngles& orient) {
+template <typename T>
+void Matrix4x3T<T>::setupLocalToParent(const Vector3T<T>& pos, const EulerAngles& orient, MathPrecision precision) {
 	RotationMatrix orientMatrix;
-	orientMatrix.setup(orient);
+	orientMatrix.setup(orient, precision);
 	setupLocalToParent(pos, orientMatrix);
 }
 
 //ִоֲռ䡪>ռ任ľ
-void Matrix4x3::setupLocalToParent(const Vector3& pos, const RotationMatrix& orient) {
+template <typename T>
+void Matrix4x3T<T>::setupLocalToParent(const Vector3T<T>& pos, const RotationMatrix& orient) {
 	//תһ ԡ>  >ֲ
 	//Ҫתת
 	m11 = orient.m11; m12 = orient.m21; m13 = orient.m31;
@@ -80,14 +58,16 @@ void Matrix4x3::setupLocalToParent(const Vector3& pos, const RotationMatrix& ori
 //ռ䡪>Կռ䡪>ռ
 // ƽƾT  תR M = TR
 //λŷǻתָ
-void Matrix4x3::setupParentToLocal(const Vector3& pos, const EulerAngles& orient) {
+template <typename T>
+void Matrix4x3T<T>::setupParentToLocal(const Vector3T<T>& pos, const EulerAngles& orient, MathPrecision precision) {
 	RotationMatrix orientMatrix;
-	orientMatrix.setup(orient);
+	orientMatrix.setup(orient, precision);
 	setupParentToLocal(pos, orientMatrix);
 }
 
 //ִиռ䡪>ֲռ任ľ
-void Matrix4x3::setupParentToLocal(const Vector3& pos, const RotationMatrix& orient) {
+template <typename T>
+void Matrix4x3T<T>::setupParentToLocal(const Vector3T<T>& pos, const RotationMatrix& orient) {
 	//ֱӸƣҪת
 	m11 = orient.m11; m12 = orient.m12; m13 = orient.m31;
 	m21 = orient.m21; m22 = orient.m22; m23 = orient.m23;
@@ -105,9 +85,10 @@ void Matrix4x3::setupParentToLocal(const Vector3& pos, const RotationMatrix& ori
 //axis:ת
 //theta תĻȣַ
 //ƽƲ
-void Matrix4x3::setupRotate(AxisTypeEnum& axis, float theta) {
-	float s, c;
-	sinCos(&s, &c, theta);
+template <typename T>
+void Matrix4x3T<T>::setupRotate(AxisTypeEnum& axis, T theta, MathPrecision precision) {
+	T s, c;
+	fastSinCos(&s, &c, theta, precision);
 	switch (axis)
 	{
 	case AxisTypeEnum::x:
@@ -137,15 +118,16 @@ void Matrix4x3::setupRotate(AxisTypeEnum& axis, float theta) {
 //תͨԭ㣬תΪλ
 //theta תĻȣַ
 //ƽƲ
-void Matrix4x3::setupRotate(const Vector3& axis, float theta) {
+template <typename T>
+void Matrix4x3T<T>::setupRotate(const Vector3T<T>& axis, T theta, MathPrecision precision) {
 	//תǷΪλ
 	assert(fabs(axis * axis - 1.0f) < 0.01f);
-	float s, c;
-	sinCos(&s, &c, theta);
-	float a = 1 - c;
-	float ax = a * axis.x;
-	float ay = a * axis.y;
-	float az = a * axis.z;
+	T s, c;
+	fastSinCos(&s, &c, theta, precision);
+	T a = 1 - c;
+	T ax = a * axis.x;
+	T ay = a * axis.y;
+	T az = a * axis.z;
 
 	m11 = ax * axis.x + c;
 	m12 = ax * axis.y + axis.z * s;
@@ -153,7 +135,7 @@ void Matrix4x3::setupRotate(const Vector3& axis, float theta) {
 
 	m21 = ay * axis.x - axis.z * s;
 	m22 = ay * axis.y + c;
-	m23 = ay * axis.z + axis.z * s;
+	m23 = ay * axis.z + axis.x * s;
 
 	m31 = az * axis.x + axis.y * s;
 	m32 = az * axis.y - axis.x * s;
@@ -163,16 +145,17 @@ void Matrix4x3::setupRotate(const Vector3& axis, float theta) {
 }
 
 //ת󣬽λԪ
-void Matrix4x3::fromQuaternion(const Quaternion& q) {
-	float xx = 2.0f * q.x * q.x;
-	float yy = 2.0f * q.y * q.y;
-	float zz = 2.0f * q.z * q.z;
-	float xy = 2.0f * q.x * q.y;
-	float xz = 2.0f * q.x * q.z;
-	float yz = 2.0f * q.y * q.z;
-	float wx = 2.0f * q.w * q.x;
-	float wy = 2.0f * q.w * q.y;
-	float wz = 2.0f * q.w * q.z;
+template <typename T>
+void Matrix4x3T<T>::fromQuaternion(const Quaternion& q) {
+	T xx = T(2) * q.x * q.x;
+	T yy = T(2) * q.y * q.y;
+	T zz = T(2) * q.z * q.z;
+	T xy = T(2) * q.x * q.y;
+	T xz = T(2) * q.x * q.z;
+	T yz = T(2) * q.y * q.z;
+	T wx = T(2) * q.w * q.x;
+	T wy = T(2) * q.w * q.y;
+	T wz = T(2) * q.w * q.z;
 
 	m11 = 1.0f - yy - zz;
 	m12 = xy + wz;
@@ -189,26 +172,18 @@ void Matrix4x3::fromQuaternion(const Quaternion& q) {
 	tx = ty = tz = 0.0f;
 }
 
-//ŵľ
-void Matrix4x3::setupScale(const Vector3& s) {
-	m11 = s.x; m11 = 0.0f; m11 = 0.0f;
-	m21 = 0.0f; m22 = s.y; m23 = 0.0f;
-	m31 = 0.0f; m32 = 0.0f; m33 = s.z;
-
-	tx = ty = tz = 0.0f;
-}
-
 //ŵľ
-void Matrix4x3::setuoSacleAlongAxis(const Vector3& axis, float k) {
+template <typename T>
+void Matrix4x3T<T>::setuoSacleAlongAxis(const Vector3T<T>& axis, T k) {
 	//ǷΪλ
 	assert(fabs(axis * axis - 1.0f) < 1.0f);
-	float a = k - 1;
-	float xx = a * axis.x * axis.x;
-	float yy = a * axis.y * axis.y;
-	float zz = a * axis.z * axis.z;
-	float xy = a * axis.x * axis.y;
-	float xz = a * axis.x * axis.z;
-	float yz = a * axis.y * axis.z;
+	T a = k - 1;
+	T xx = a * axis.x * axis.x;
+	T yy = a * axis.y * axis.y;
+	T zz = a * axis.z * axis.z;
+	T xy = a * axis.x * axis.y;
+	T xz = a * axis.x * axis.z;
+	T yz = a * axis.y * axis.z;
 
 	m11 = 1.0f + xx;
 	m12 = xy;
@@ -226,7 +201,8 @@ void Matrix4x3::setuoSacleAlongAxis(const Vector3& axis, float k) {
 }
 
 //б
-void Matrix4x3::setupShear(AxisTypeEnum axis, float s, float t) {
+template <typename T>
+void Matrix4x3T<T>::setupShear(AxisTypeEnum axis, T s, T t) {
 	switch (axis)
 	{
 	case AxisTypeEnum::x:
@@ -253,7 +229,8 @@ void Matrix4x3::setupShear(AxisTypeEnum axis, float s, float t) {
 }
 
 //ͶӰͶӰƽԭ,Ҵֱڵλn
-void Matrix4x3::setupProject(const Vector3& n) {
+template <typename T>
+void Matrix4x3T<T>::setupProject(const Vector3T<T>& n) {
 	//ǷΪλ
 	assert(fabs(n * n - 1.0f) < 1.0f);
 
@@ -269,7 +246,8 @@ void Matrix4x3::setupProject(const Vector3& n) {
 }
 
 //췴
-void Matrix4x3::setupReflect(AxisTypeEnum axis, float k) {
+template <typename T>
+void Matrix4x3T<T>::setupReflect(AxisTypeEnum axis, T k) {
 	switch (axis)
 	{
 	case AxisTypeEnum::x:
@@ -300,13 +278,14 @@ void Matrix4x3::setupReflect(AxisTypeEnum axis, float k) {
 }
 
 //ƽ淴ľ
-void Matrix4x3::setupReflect(const Vector3& n) {
+template <typename T>
+void Matrix4x3T<T>::setupReflect(const Vector3T<T>& n) {
 	//ǷΪλ
 	assert(fabs(n * n - 1.0f) < 1.0f);
 
-	float ax = -2.0f * n.x;
-	float ay = -2.0f * n.y;
-	float az = -2.0f * n.z;
+	T ax = -2.0f * n.x;
+	T ay = -2.0f * n.y;
+	T az = -2.0f * n.z;
 
 	m11 = 1.0f + ax * n.x;
 	m22 = 1.0f + ay * n.y;
@@ -319,66 +298,74 @@ void Matrix4x3::setupReflect(const Vector3& n) {
 	tx = ty = tz = 0.0f;
 }
 
-//* 任Ӿ󣬳˷˳ر任˳
-//*
-Vector3 operator* (const Vector3& p, const Matrix4x3& m) {
-	return Vector3(
-		p.x * m.m11 + p.y * m.m21 + p.z * m.m31 + m.tx,
-		p.x * m.m12 + p.y * m.m22 + p.z * m.m32 + m.ty,
-		p.x * m.m13 + p.y * m.m23 + p.z * m.m33 + m.tz
-	);
-}
-
-//*
-Matrix4x3 operator* (const Matrix4x3& a, const Matrix4x3& b) {
-	Matrix4x3 r;
-
-	r.m11 = a.m11 * b.m11 + a.m12 * b.m21 + a.m13 * b.m31;
-	r.m12 = a.m11 * b.m12 + a.m12 * b.m22 + a.m13 * b.m32;
-	r.m13 = a.m11 * b.m13 + a.m12 * b.m23 + a.m13 * b.m33;
-
-	r.m21 = a.m21 * b.m11 + a.m22 * b.m21 + a.m23 * b.m31;
-	r.m22 = a.m21 * b.m12 + a.m22 * b.m22 + a.m23 * b.m32;
-	r.m23 = a.m21 * b.m13 + a.m22 * b.m23 + a.m23 * b.m33;
-
-	r.m31 = a.m31 * b.m11 + a.m32 * b.m21 + a.m33 * b.m31;
-	r.m32 = a.m31 * b.m12 + a.m32 * b.m22 + a.m33 * b.m32;
-	r.m33 = a.m31 * b.m13 + a.m32 * b.m23 + a.m33 * b.m33;
-
-	r.tx = a.tx * b.m11 + a.ty * b.m21 + a.tz * b.m31 + b.tx;
-	r.ty = a.tx * b.m12 + a.ty * b.m22 + a.tz * b.m32 + b.ty;
-	r.tz = a.tx * b.m13 + a.ty * b.m23 + a.tz * b.m33 + b.tz;
-
-	return r;
-}
-
-
-//*=ֺc++׼﷨һ
-Vector3& operator*= (Vector3& p, const Matrix4x3& m) {
-	p = p * m;
-	return p;
+//任㣬out[i] = in[i] * m
+//ÿζkSimdWidthתΪxyzĴ任תдأ
+//ͬһȶд in  out ͬһ
+//˳ operator* ͬλһ£һβֱӵ operator*
+void transformPoints(const Vector3* in, Vector3* out, size_t n, const Matrix4x3& m) {
+	const SimdFloat m11 = simdSet(m.m11), m12 = simdSet(m.m12), m13 = simdSet(m.m13);
+	const SimdFloat m21 = simdSet(m.m21), m22 = simdSet(m.m22), m23 = simdSet(m.m23);
+	const SimdFloat m31 = simdSet(m.m31), m32 = simdSet(m.m32), m33 = simdSet(m.m33);
+	const SimdFloat tx = simdSet(m.tx), ty = simdSet(m.ty), tz = simdSet(m.tz);
+
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat x, y, z;
+		simdLoadXYZ(&in[i].x, &x, &y, &z);
+		SimdFloat rx = simdAdd(simdAdd(simdAdd(simdMul(x, m11), simdMul(y, m21)), simdMul(z, m31)), tx);
+		SimdFloat ry = simdAdd(simdAdd(simdAdd(simdMul(x, m12), simdMul(y, m22)), simdMul(z, m32)), ty);
+		SimdFloat rz = simdAdd(simdAdd(simdAdd(simdMul(x, m13), simdMul(y, m23)), simdMul(z, m33)), tz);
+		simdStoreXYZ(&out[i].x, rx, ry, rz);
+	}
+	for (; i < n; ++i) {
+		out[i] = in[i] * m;
+	}
 }
 
-Matrix4x3& operator*= (Matrix4x3& a, const Matrix4x3& b) {
-	a = a * b;
-	return a;
+//任ֻתԲ֣ƽ
+void transformVectors(const Vector3* in, Vector3* out, size_t n, const Matrix4x3& m) {
+	const SimdFloat m11 = simdSet(m.m11), m12 = simdSet(m.m12), m13 = simdSet(m.m13);
+	const SimdFloat m21 = simdSet(m.m21), m22 = simdSet(m.m22), m23 = simdSet(m.m23);
+	const SimdFloat m31 = simdSet(m.m31), m32 = simdSet(m.m32), m33 = simdSet(m.m33);
+
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat x, y, z;
+		simdLoadXYZ(&in[i].x, &x, &y, &z);
+		SimdFloat rx = simdAdd(simdAdd(simdMul(x, m11), simdMul(y, m21)), simdMul(z, m31));
+		SimdFloat ry = simdAdd(simdAdd(simdMul(x, m12), simdMul(y, m22)), simdMul(z, m32));
+		SimdFloat rz = simdAdd(simdAdd(simdMul(x, m13), simdMul(y, m23)), simdMul(z, m33));
+		simdStoreXYZ(&out[i].x, rx, ry, rz);
+	}
+	for (; i < n; ++i) {
+		const Vector3& p = in[i];
+		out[i] = Vector3(
+			p.x * m.m11 + p.y * m.m21 + p.z * m.m31,
+			p.x * m.m12 + p.y * m.m22 + p.z * m.m32,
+			p.x * m.m13 + p.y * m.m23 + p.z * m.m33
+		);
+	}
 }
 
 //3x3ֵʽֵ
-float determinant(const Matrix4x3& m) {
+template <typename T>
+T determinant(const Matrix4x3T<T>& m) {
 	return m.m11 * (m.m22 * m.m33 - m.m23 * m.m32)
 		+ m.m12 * (m.m23 * m.m31 - m.m21 * m.m33)
 		+ m.m13 * (m.m21 * m.m32 - m.m22 * m.m31);
 }
 
 //
-Matrix4x3 inverse(const Matrix4x3& m) {
-	float det = determinant(m);
+template <typename T>
+Matrix4x3T<T> inverse(const Matrix4x3T<T>& m) {
+	T det = determinant(m);
 	//ʽΪ ģû
 	assert(fabs(det) > 0.000001f);
-	float oneOverDet = 1.0f / det;
+	T oneOverDet = T(1) / det;
 
-	Matrix4x3 r;
+	Matrix4x3T<T> r;
 	r.m11 = (m.m22 * m.m33 - m.m23 * m.m32) * oneOverDet;
 	r.m12 = (m.m13 * m.m32 - m.m12 * m.m33) * oneOverDet;
 	r.m13 = (m.m12 * m.m23 - m.m13 * m.m22) * oneOverDet;
@@ -388,25 +375,21 @@ Matrix4x3 inverse(const Matrix4x3& m) {
 	r.m23 = (m.m13 * m.m21 - m.m11 * m.m23) * oneOverDet;
 
 	r.m31 = (m.m21 * m.m32 - m.m22 * m.m31) * oneOverDet;
-	r.m32 = (m.m13 * m.m31 - m.m11 * m.m32) * oneOverDet;
+	r.m32 = (m.m12 * m.m31 - m.m11 * m.m32) * oneOverDet;
 	r.m33 = (m.m11 * m.m22 - m.m12 * m.m21) * oneOverDet;
 
-	r.tx = -(m.tx * r.m11 + m.ty + r.m21 + m.tz + r.m31);
-	r.tx = -(m.tx * r.m12 + m.ty + r.m22 + m.tz + r.m32);
-	r.tx = -(m.tx * r.m13 + m.ty + r.m23 + m.tz + r.m33);
+	r.tx = -(m.tx * r.m11 + m.ty * r.m21 + m.tz * r.m31);
+	r.ty = -(m.tx * r.m12 + m.ty * r.m22 + m.tz * r.m32);
+	r.tz = -(m.tx * r.m13 + m.ty * r.m23 + m.tz * r.m33);
 
 	return r;
 }
 
-//ȡƽƲ
-Vector3 getTranslation(const Matrix4x3& m) {
-	return Vector3(m.tx, m.ty, m.tz);
-}
-
 //Ӿлȡλ
 //Ӹ󡪡ֲлȡλ
-Vector3 getPositionFromParentToLocalMatrix(const Matrix4x3& m) {
-	return Vector3(
+template <typename T>
+Vector3T<T> getPositionFromParentToLocalMatrix(const Matrix4x3T<T>& m) {
+	return Vector3T<T>(
 		-(m.tx * m.m11 + m.ty * m.m12 + m.tz * m.m13),
 		-(m.tx * m.m21 + m.ty * m.m22 + m.tz * m.m23),
 		-(m.tx * m.m31 + m.ty * m.m32 + m.tz * m.m33)
@@ -414,7 +397,139 @@ Vector3 getPositionFromParentToLocalMatrix(const Matrix4x3& m) {
 }
 
 //Ӿֲءлȡλ
-Vector3 getPositionFromLocalToParentMatrix(const Matrix4x3& m){
-	return Vector3(m.tx, m.ty, m.tz);
+template <typename T>
+Vector3T<T> getPositionFromLocalToParentMatrix(const Matrix4x3T<T>& m){
+	return Vector3T<T>(m.tx, m.ty, m.tz);
+}
+
+//Ӿout[i] = a[i] * b[i]
+//kSimdWidthתóSoAһ㣬 operator* λһ
+void concatenate(const Matrix4x3* a, const Matrix4x3* b, Matrix4x3* out, size_t n) {
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdMatrix4x3 sa, sb, r;
+		simdLoadMatrices(a + i, &sa);
+		simdLoadMatrices(b + i, &sb);
+		simdConcatenate(sa, sb, &r);
+		simdStoreMatrices(out + i, r);
+	}
+	for (; i < n; ++i) {
+		out[i] = a[i] * b[i];
+	}
+}
+
+//߾ӣout[i] = a * b[i]
+void concatenate(const Matrix4x3& a, const Matrix4x3* b, Matrix4x3* out, size_t n) {
+	//a ܾ out еĳԪأȸһ
+	const Matrix4x3 left = a;
+	SimdMatrix4x3 sa;
+	simdSetMatrix(left, &sa);
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdMatrix4x3 sb, r;
+		simdLoadMatrices(b + i, &sb);
+		simdConcatenate(sa, sb, &r);
+		simdStoreMatrices(out + i, r);
+	}
+	for (; i < n; ++i) {
+		out[i] = left * b[i];
+	}
+}
+
+//ұ߾ӣout[i] = a[i] * b
+void concatenate(const Matrix4x3* a, const Matrix4x3& b, Matrix4x3* out, size_t n) {
+	//b ܾ out еĳԪأȸһ
+	const Matrix4x3 right = b;
+	SimdMatrix4x3 sb;
+	simdSetMatrix(right, &sb);
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdMatrix4x3 sa, r;
+		simdLoadMatrices(a + i, &sa);
+		simdConcatenate(sa, sb, &r);
+		simdStoreMatrices(out + i, r);
+	}
+	for (; i < n; ++i) {
+		out[i] = a[i] * right;
+	}
+}
+
+//composeTRS()composeTRSUniform()ʵ֣scaleuniformScaleһΪNULL
+static void composeTRS(const Quaternion* rotation, const Vector3* position, const Vector3* scale, const float* uniformScale,
+	Matrix4x3* out, size_t n, const Matrix4x3* inverseBindPose) {
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat qx, qy, qz, qw;
+		simdLoad4x(&rotation[i].x, 4, &qx, &qy, &qz, &qw);
+		SimdMatrix4x3 r;
+		simdFromQuaternion(qx, qy, qz, qw, &r);
+		//гԶӦ
+		SimdFloat sx, sy, sz;
+		if (scale != NULL) {
+			simdLoadXYZ(&scale[i].x, &sx, &sy, &sz);
+		}
+		else if (uniformScale != NULL) {
+			sx = sy = sz = simdLoad(uniformScale + i);
+		}
+		if (scale != NULL || uniformScale != NULL) {
+			r.m11 = simdMul(r.m11, sx); r.m12 = simdMul(r.m12, sx); r.m13 = simdMul(r.m13, sx);
+			r.m21 = simdMul(r.m21, sy); r.m22 = simdMul(r.m22, sy); r.m23 = simdMul(r.m23, sy);
+			r.m31 = simdMul(r.m31, sz); r.m32 = simdMul(r.m32, sz); r.m33 = simdMul(r.m33, sz);
+		}
+		simdLoadXYZ(&position[i].x, &r.tx, &r.ty, &r.tz);
+		if (inverseBindPose != NULL) {
+			SimdMatrix4x3 bind, skin;
+			simdLoadMatrices(inverseBindPose + i, &bind);
+			simdConcatenate(bind, r, &skin);
+			simdStoreMatrices(out + i, skin);
+		}
+		else {
+			simdStoreMatrices(out + i, r);
+		}
+	}
+	for (; i < n; ++i) {
+		Matrix4x3 m;
+		m.fromQuaternion(rotation[i]);
+		if (scale != NULL || uniformScale != NULL) {
+			float sx = scale != NULL ? scale[i].x : uniformScale[i];
+			float sy = scale != NULL ? scale[i].y : uniformScale[i];
+			float sz = scale != NULL ? scale[i].z : uniformScale[i];
+			m.m11 *= sx; m.m12 *= sx; m.m13 *= sx;
+			m.m21 *= sy; m.m22 *= sy; m.m23 *= sy;
+			m.m31 *= sz; m.m32 *= sz; m.m33 *= sz;
+		}
+		m.tx = position[i].x;
+		m.ty = position[i].y;
+		m.tz = position[i].z;
+		out[i] = inverseBindPose != NULL ? inverseBindPose[i] * m : m;
+	}
+}
+
+//TRS
+void composeTRS(const Quaternion* rotation, const Vector3* position, const Vector3* scale,
+	Matrix4x3* out, size_t n, const Matrix4x3* inverseBindPose) {
+	composeTRS(rotation, position, scale, NULL, out, n, inverseBindPose);
+}
+
+//TRS󣬾
+void composeTRSUniform(const Quaternion* rotation, const Vector3* position, const float* scale,
+	Matrix4x3* out, size_t n, const Matrix4x3* inverseBindPose) {
+	assert(n == 0 || scale != NULL);
+	composeTRS(rotation, position, NULL, scale, out, n, inverseBindPose);
 }
 
+//floatdouble汾ʵ
+template class Matrix4x3T<float>;
+template class Matrix4x3T<double>;
+template float determinant(const Matrix4x3&);
+template double determinant(const Matrix4x3d&);
+template Matrix4x3 inverse(const Matrix4x3&);
+template Matrix4x3d inverse(const Matrix4x3d&);
+template Vector3 getPositionFromParentToLocalMatrix(const Matrix4x3&);
+template Vector3d getPositionFromParentToLocalMatrix(const Matrix4x3d&);
+template Vector3 getPositionFromLocalToParentMatrix(const Matrix4x3&);
+template Vector3d getPositionFromLocalToParentMatrix(const Matrix4x3d&);
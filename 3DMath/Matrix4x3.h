@@ -2,7 +2,10 @@
 #ifndef __MATRIX4X3_H_INDECUDED__
 #define __MATRIX4X3_H_INDECUDED__
 
-class Vector3;
+#include <stddef.h>
+#include "MathUtil.h"
+#include "Vector3.h"
+
 class EulerAngles;
 class Quaternion;
 class RotationMatrix;
@@ -17,89 +20,228 @@ enum AxisTypeEnum
 // ƣ4X3
 // ߣcary
 // ʵ4X3ܹκ3D任
-//		
+//		ģMatrix4x3Ϊfloat汾Matrix4x3dΪdouble汾
+//		SIMDĺֻfloat汾double任CameraRelative.hеĺתΪfloat
+//		λƽơšӺ͵ı任constexpr
+//		̶ƫƺ;̬ı任ڱ
 
-class Matrix4x3
+template <typename T>
+class Matrix4x3T
 {
 public:
-	float m11, m12, m13;
-	float m21, m22, m23;
-	float m31, m32, m33;
-	float tx, ty, tz;
+	typedef T Scalar;
+
+	T m11, m12, m13;
+	T m21, m22, m23;
+	T m31, m32, m33;
+	T tx, ty, tz;
 
 	//Ϊλ
-	void identity();
+	constexpr void identity();
 
 	//ֱӷƽƲ
 	//ƽƲֵĵΪ
-	void zeroTranslation();
+	constexpr void zeroTranslation();
 	//ƽƲֵָ
-	void setTranslation(const Vector3& d);
-	void setupTranslation(const Vector3& d);
+	constexpr void setTranslation(const Vector3T<T>& d);
+	constexpr void setupTranslation(const Vector3T<T>& d);
 
 	//ִиռ<>ֲռ任ľ
-	void setupLocalToParent(const Vector3& pos, const EulerAngles& orient);
-	void setupLocalToParent(const Vector3& pos, const RotationMatrix& orient);
-	void setupParentToLocal(const Vector3& pos, const EulerAngles& orient);
-	void setupParentToLocal(const Vector3& pos, const RotationMatrix& orient);
+	//precisionѡsincosľȣMathUtil.h
+	void setupLocalToParent(const Vector3T<T>& pos, const EulerAngles& orient, MathPrecision precision = kPrecisionFull);
+	void setupLocalToParent(const Vector3T<T>& pos, const RotationMatrix& orient);
+	void setupParentToLocal(const Vector3T<T>& pos, const EulerAngles& orient, MathPrecision precision = kPrecisionFull);
+	void setupParentToLocal(const Vector3T<T>& pos, const RotationMatrix& orient);
 
 	//תľ
 	//axis:ת
 	//theta תĻȣַ
 	//ƽƲ
-	void setupRotate(AxisTypeEnum& axis, float theta);
+	//precisionѡsincosľȣMathUtil.h
+	void setupRotate(AxisTypeEnum& axis, T theta, MathPrecision precision = kPrecisionFull);
 
 	//תľ
 	//תͨԭ㣬תΪλ
 	//theta תĻȣַ
 	//ƽƲ
 	//
-	void setupRotate(const Vector3& axis, float theta);
+	void setupRotate(const Vector3T<T>& axis, T theta, MathPrecision precision = kPrecisionFull);
 
 	//ת󣬽λԪ
 	void fromQuaternion(const Quaternion& q);
 
 	//ŵľ
-	void setupScale(const Vector3& s);
+	constexpr void setupScale(const Vector3T<T>& s);
 
 	//ŵľ
-	void setuoSacleAlongAxis(const Vector3& axis, float k);
+	void setuoSacleAlongAxis(const Vector3T<T>& axis, T k);
 
 	//б
-	void setupShear(AxisTypeEnum axis, float s, float t);
+	void setupShear(AxisTypeEnum axis, T s, T t);
 
 	//ͶӰͶӰƽԭ,Ҵֱڵλn
-	void setupProject(const Vector3& n);
+	void setupProject(const Vector3T<T>& n);
 
 	//췴
-	void setupReflect(AxisTypeEnum axis, float k = 0.0f);
+	void setupReflect(AxisTypeEnum axis, T k = T(0));
 
 	//ƽ淴ľ
-	void setupReflect(const Vector3& n);
+	void setupReflect(const Vector3T<T>& n);
 };
 
-//* 任Ӿ󣬳˷˳ر任˳
-Vector3 operator* (const Vector3& p, const Matrix4x3& m);
-Matrix4x3 operator* (const Matrix4x3& a, const Matrix4x3& b);
+typedef Matrix4x3T<float> Matrix4x3;
+typedef Matrix4x3T<double> Matrix4x3d;
+
+//Ϊλ
+template <typename T>
+constexpr void Matrix4x3T<T>::identity() {
+	m11 = T(1); m12 = T(0); m13 = T(0);
+	m21 = T(0); m22 = T(1); m23 = T(0);
+	m31 = T(0); m32 = T(0); m33 = T(1);
+	tx = T(0);  ty = T(0);  tz = T(0);
+}
+
+//ƽƲֵĵΪ
+template <typename T>
+constexpr void Matrix4x3T<T>::zeroTranslation() {
+	tx = ty = tz = T(0);
+}
+
+//ƽƲֵָ
+template <typename T>
+constexpr void Matrix4x3T<T>::setTranslation(const Vector3T<T>& d) {
+	tx = d.x; ty = d.y; tz = d.z;
+}
+
+//ƽƲֵָ
+template <typename T>
+constexpr void Matrix4x3T<T>::setupTranslation(const Vector3T<T>& d) {
+	m11 = T(1); m12 = T(0); m13 = T(0);
+	m21 = T(0); m22 = T(1); m23 = T(0);
+	m31 = T(0); m32 = T(0); m33 = T(1);
+	tx = d.x;   ty = d.y;   tz = d.z;
+}
+
+//ŵľ
+template <typename T>
+constexpr void Matrix4x3T<T>::setupScale(const Vector3T<T>& s) {
+	m11 = s.x; m12 = T(0); m13 = T(0);
+	m21 = T(0); m22 = s.y; m23 = T(0);
+	m31 = T(0); m32 = T(0); m33 = s.z;
+
+	tx = ty = tz = T(0);
+}
+
+//ȫֵλ󣬱ڳ
+constexpr Matrix4x3 kMatrix4x3Identity = {
+	1.0f, 0.0f, 0.0f,
+	0.0f, 1.0f, 0.0f,
+	0.0f, 0.0f, 1.0f,
+	0.0f, 0.0f, 0.0f
+};
 
+//* 任Ӿ󣬳˷˳ر任˳
+//汾transformPoints()concatenate()ȣ˳ͬ޸ʱҪһ
+//*
+template <typename T>
+constexpr Vector3T<T> operator* (const Vector3T<T>& p, const Matrix4x3T<T>& m) {
+	return Vector3T<T>(
+		p.x * m.m11 + p.y * m.m21 + p.z * m.m31 + m.tx,
+		p.x * m.m12 + p.y * m.m22 + p.z * m.m32 + m.ty,
+		p.x * m.m13 + p.y * m.m23 + p.z * m.m33 + m.tz
+	);
+}
+
+//ʽ*
+template <typename E>
+constexpr Vector3T<typename E::Scalar> operator* (const Vector3Expression<E>& p, const Matrix4x3T<typename E::Scalar>& m) {
+	return Vector3T<typename E::Scalar>(p) * m;
+}
+
+//*
+template <typename T>
+constexpr Matrix4x3T<T> operator* (const Matrix4x3T<T>& a, const Matrix4x3T<T>& b) {
+	Matrix4x3T<T> r = {};
+
+	r.m11 = a.m11 * b.m11 + a.m12 * b.m21 + a.m13 * b.m31;
+	r.m12 = a.m11 * b.m12 + a.m12 * b.m22 + a.m13 * b.m32;
+	r.m13 = a.m11 * b.m13 + a.m12 * b.m23 + a.m13 * b.m33;
+
+	r.m21 = a.m21 * b.m11 + a.m22 * b.m21 + a.m23 * b.m31;
+	r.m22 = a.m21 * b.m12 + a.m22 * b.m22 + a.m23 * b.m32;
+	r.m23 = a.m21 * b.m13 + a.m22 * b.m23 + a.m23 * b.m33;
+
+	r.m31 = a.m31 * b.m11 + a.m32 * b.m21 + a.m33 * b.m31;
+	r.m32 = a.m31 * b.m12 + a.m32 * b.m22 + a.m33 * b.m32;
+	r.m33 = a.m31 * b.m13 + a.m32 * b.m23 + a.m33 * b.m33;
+
+	r.tx = a.tx * b.m11 + a.ty * b.m21 + a.tz * b.m31 + b.tx;
+	r.ty = a.tx * b.m12 + a.ty * b.m22 + a.tz * b.m32 + b.ty;
+	r.tz = a.tx * b.m13 + a.ty * b.m23 + a.tz * b.m33 + b.tz;
+
+	return r;
+}
 
 //*=ֺc++׼﷨һ
-Vector3& operator*= (Vector3& p, const Matrix4x3& m);
-Matrix4x3& operator*= (Matrix4x3& a, const Matrix4x3& b);
+template <typename T>
+constexpr Vector3T<T>& operator*= (Vector3T<T>& p, const Matrix4x3T<T>& m) {
+	p = p * m;
+	return p;
+}
+
+template <typename T>
+constexpr Matrix4x3T<T>& operator*= (Matrix4x3T<T>& a, const Matrix4x3T<T>& b) {
+	a = a * b;
+	return a;
+}
+
+//任㣬out[i] = in[i] * m
+//in  out ͬһ飨ԭر任n ֵ
+void transformPoints(const Vector3* in, Vector3* out, size_t n, const Matrix4x3& m);
+//任ֻתԲ֣ƽ
+void transformVectors(const Vector3* in, Vector3* out, size_t n, const Matrix4x3& m);
+
+//Ӿout[i] = a[i] * b[i]
+//out Ժ a  b ͬһ
+void concatenate(const Matrix4x3* a, const Matrix4x3* b, Matrix4x3* out, size_t n);
+//߾ӣout[i] = a * b[i]
+void concatenate(const Matrix4x3& a, const Matrix4x3* b, Matrix4x3* out, size_t n);
+//ұ߾ӣout[i] = a[i] * bֲľͬһ硪ľ
+void concatenate(const Matrix4x3* a, const Matrix4x3& b, Matrix4x3* out, size_t n);
+
+//TRSţתƽƣƤÿιkSimdWidth48
+//out[i] Ȱscale[i]ţٰrotation[i]תƽƵposition[i]
+//תֺMatrix4x3::fromQuaternion()ͬrotationӦΪλԪ
+//fromQuaternion()졢гԶӦšƽƣoperator*λһ
+//scale ѡΪNULLʱ
+//inverseBindPose ѡΪNULLʱ out[i] = inverseBindPose[i] * TRSȱ任ռ
+//out Ժ inverseBindPose ͬһ
+void composeTRS(const Quaternion* rotation, const Vector3* position, const Vector3* scale,
+	Matrix4x3* out, size_t n, const Matrix4x3* inverseBindPose = 0);
+//ţscale ΪNULL
+void composeTRSUniform(const Quaternion* rotation, const Vector3* position, const float* scale,
+	Matrix4x3* out, size_t n, const Matrix4x3* inverseBindPose = 0);
 
 //3x3ֵʽֵ
-float determinant(const Matrix4x3& m);
+template <typename T>
+T determinant(const Matrix4x3T<T>& m);
 
 //
-Matrix4x3 inverse(const Matrix4x3& m);
+template <typename T>
+Matrix4x3T<T> inverse(const Matrix4x3T<T>& m);
 
 //ȡƽƲ
-Vector3 getTranslation(const Matrix4x3& m);
+template <typename T>
+constexpr Vector3T<T> getTranslation(const Matrix4x3T<T>& m) {
+	return Vector3T<T>(m.tx, m.ty, m.tz);
+}
 
 //Ӿлȡλ
 //Ӹ󡪡ֲлȡλ
-Vector3 getPositionFromParentToLocalMatrix(const Matrix4x3& m);
+template <typename T>
+Vector3T<T> getPositionFromParentToLocalMatrix(const Matrix4x3T<T>& m);
 //Ӿֲءлȡλ
-Vector3 getPositionFromLocalToParentMatrix(const Matrix4x3& m);
+template <typename T>
+Vector3T<T> getPositionFromLocalToParentMatrix(const Matrix4x3T<T>& m);
 
 #endif // #ifdef __MATRIX4X3_H_INDECUDED__
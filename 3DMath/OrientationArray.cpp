@@ -0,0 +1,379 @@
+#include <assert.h>
+
+#include "OrientationArray.h"
+#include "Vector3.h"
+#include "Vector3Array.h"
+#include "EulerAngles.h"
+#include "Quaternion.h"
+#include "RotationMatrix.h"
+#include "Matrix4x3.h"
+#include "SimdUtil.h"
+#include "SimdMath.h"
+#include "SimdMatrix4x3.h"
+
+// ƣλת
+// ߣcary
+// תΪSoAļĴȫǶȵsincosٰ汾˳ϣתд
+//		kSimdWidthβ㣬дʱУֻЧ
+
+static_assert(sizeof(EulerAngles) == 3 * sizeof(float), "EulerAngles must be three packed floats");
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion must be four packed floats");
+static_assert(sizeof(RotationMatrix) == 9 * sizeof(float), "RotationMatrix must be nine packed floats");
+
+//ŷ룬aosΪNULLʱAoSSoA
+struct EulerSource {
+	const EulerAngles* aos;
+	const float* heading;
+	const float* pitch;
+	const float* bank;
+
+	//iʼһ
+	void load(size_t i, SimdFloat* h, SimdFloat* p, SimdFloat* b) const {
+		if (aos != NULL) {
+			simdLoadXYZ(&aos[i].heading, h, p, b);
+		}
+		else {
+			*h = simdLoad(heading + i);
+			*p = simdLoad(pitch + i);
+			*b = simdLoad(bank + i);
+		}
+	}
+
+	//iʼcountಹ
+	void loadTail(size_t i, size_t count, SimdFloat* h, SimdFloat* p, SimdFloat* b) const {
+		float th[kSimdWidth] = {}, tp[kSimdWidth] = {}, tb[kSimdWidth] = {};
+		for (size_t k = 0; k < count; ++k) {
+			th[k] = aos != NULL ? aos[i + k].heading : heading[i + k];
+			tp[k] = aos != NULL ? aos[i + k].pitch : pitch[i + k];
+			tb[k] = aos != NULL ? aos[i + k].bank : bank[i + k];
+		}
+		*h = simdLoad(th);
+		*p = simdLoad(tp);
+		*b = simdLoad(tb);
+	}
+};
+
+//ᡪ룬aosΪNULLʱAoSsoa
+struct AxisAngleSource {
+	const Vector3* aos;
+	const Vector3Array* soa;
+	const float* theta;
+
+	void load(size_t i, SimdFloat* x, SimdFloat* y, SimdFloat* z, SimdFloat* t) const {
+		if (aos != NULL) {
+			simdLoadXYZ(&aos[i].x, x, y, z);
+		}
+		else {
+			*x = simdLoad(soa->x + i);
+			*y = simdLoad(soa->y + i);
+			*z = simdLoad(soa->z + i);
+		}
+		*t = simdLoad(theta + i);
+	}
+
+	void loadTail(size_t i, size_t count, SimdFloat* x, SimdFloat* y, SimdFloat* z, SimdFloat* t) const {
+		float tx[kSimdWidth] = {}, ty[kSimdWidth] = {}, tz[kSimdWidth] = {}, tt[kSimdWidth] = {};
+		for (size_t k = 0; k < count; ++k) {
+			tx[k] = aos != NULL ? aos[i + k].x : soa->x[i + k];
+			ty[k] = aos != NULL ? aos[i + k].y : soa->y[i + k];
+			tz[k] = aos != NULL ? aos[i + k].z : soa->z[i + k];
+			tt[k] = theta[i + k];
+		}
+		*x = simdLoad(tx);
+		*y = simdLoad(ty);
+		*z = simdLoad(tz);
+		*t = simdLoad(tt);
+	}
+};
+
+//һŷǵsincos
+struct SimdEulerSinCos {
+	SimdFloat sh, ch, sp, cp, sb, cb;
+};
+
+//һŷǲsincosscaleΪǶȵţԪðǣ
+static inline void eulerSinCos(const EulerSource& src, size_t i, size_t count, float scale, MathPrecision precision,
+	SimdEulerSinCos* r) {
+	SimdFloat h, p, b;
+	if (count == kSimdWidth) {
+		src.load(i, &h, &p, &b);
+	}
+	else {
+		src.loadTail(i, count, &h, &p, &b);
+	}
+	const SimdFloat s = simdSet(scale);
+	simdSinCos(simdMul(p, s), &r->sp, &r->cp, precision);
+	simdSinCos(simdMul(b, s), &r->sb, &r->cb, precision);
+	simdSinCos(simdMul(h, s), &r->sh, &r->ch, precision);
+}
+
+//дkSimdWidthԪ
+static inline void simdStoreQuaternions(Quaternion* q, SimdFloat x, SimdFloat y, SimdFloat z, SimdFloat w) {
+	simdStore4x(&q->x, 4, x, y, z, w);
+}
+
+//дkSimdWidthתǰ8Ԫطתдm33д
+static inline void simdStoreRotationMatrices(RotationMatrix* m, const SimdMatrix4x3& r) {
+	float* p = &m->m11;
+	simdStore4x(p, 9, r.m11, r.m12, r.m13, r.m21);
+	simdStore4x(p + 4, 9, r.m22, r.m23, r.m31, r.m32);
+	float last[kSimdWidth];
+	simdStore(last, r.m33);
+	for (size_t k = 0; k < kSimdWidth; ++k) {
+		m[k].m33 = last[k];
+	}
+}
+
+//дһkSimdWidthʱдʱ
+template <typename T, typename Store>
+static inline void storeGroup(T* out, size_t count, Store store) {
+	if (count == kSimdWidth) {
+		store(out);
+	}
+	else {
+		T temp[kSimdWidth];
+		store(temp);
+		for (size_t k = 0; k < count; ++k) {
+			out[k] = temp[k];
+		}
+	}
+}
+
+//ÿһconvert(i, count)
+template <typename Convert>
+static inline void forEachGroup(size_t n, Convert convert) {
+	for (size_t i = 0; i < n; i += kSimdWidth) {
+		convert(i, n - i < kSimdWidth ? n - i : kSimdWidth);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// ŷ
+/////////////////////////////////////////////////////////////////////////////
+
+//˳Quaternion::setToRotationObjectToInertial()ͬ
+static void objectToInertialQuaternions(const EulerSource& src, Quaternion* out, size_t n, MathPrecision precision) {
+	forEachGroup(n, [&](size_t i, size_t count) {
+		SimdEulerSinCos e;
+		eulerSinCos(src, i, count, 0.5f, precision, &e);
+		SimdFloat w = simdAdd(simdMul(simdMul(e.ch, e.cp), e.cb), simdMul(simdMul(e.sh, e.sp), e.sb));
+		SimdFloat x = simdAdd(simdMul(simdMul(e.ch, e.sp), e.cb), simdMul(simdMul(e.sh, e.cp), e.sb));
+		SimdFloat y = simdAdd(simdMul(simdMul(simdNeg(e.ch), e.sp), e.sb), simdMul(simdMul(e.sh, e.cp), e.cb));
+		SimdFloat z = simdAdd(simdMul(simdMul(simdNeg(e.sh), e.sp), e.cb), simdMul(simdMul(e.ch, e.cp), e.sb));
+		storeGroup(out + i, count, [&](Quaternion* q) { simdStoreQuaternions(q, x, y, z, w); });
+	});
+}
+
+//˳Quaternion::setToRotationInertialToObject()ͬ
+static void inertialToObjectQuaternions(const EulerSource& src, Quaternion* out, size_t n, MathPrecision precision) {
+	forEachGroup(n, [&](size_t i, size_t count) {
+		SimdEulerSinCos e;
+		eulerSinCos(src, i, count, 0.5f, precision, &e);
+		SimdFloat w = simdAdd(simdMul(simdMul(e.ch, e.cp), e.cb), simdMul(simdMul(e.sh, e.sp), e.sb));
+		SimdFloat x = simdSub(simdMul(simdMul(simdNeg(e.ch), e.sp), e.cb), simdMul(simdMul(e.sh, e.cp), e.sb));
+		SimdFloat y = simdSub(simdMul(simdMul(e.ch, e.sp), e.sb), simdMul(simdMul(e.sh, e.cp), e.cb));
+		SimdFloat z = simdSub(simdMul(simdMul(e.sh, e.sp), e.cb), simdMul(simdMul(e.ch, e.cp), e.sb));
+		storeGroup(out + i, count, [&](Quaternion* q) { simdStoreQuaternions(q, x, y, z, w); });
+	});
+}
+
+//˳RotationMatrix::setup()ͬΪԡ
+static inline void simdSetupRotation(const SimdEulerSinCos& e, SimdMatrix4x3* r) {
+	r->m11 = simdAdd(simdMul(e.ch, e.cb), simdMul(simdMul(e.sh, e.sp), e.sb));
+	r->m12 = simdAdd(simdMul(simdNeg(e.ch), e.sb), simdMul(simdMul(e.sh, e.sp), e.cb));
+	r->m13 = simdMul(e.sh, e.cp);
+
+	r->m21 = simdMul(e.sb, e.cp);
+	r->m22 = simdMul(e.cb, e.cp);
+	r->m23 = simdNeg(e.sp);
+
+	r->m31 = simdAdd(simdMul(simdNeg(e.sh), e.cb), simdMul(simdMul(e.ch, e.sp), e.sb));
+	r->m32 = simdAdd(simdMul(e.sb, e.sh), simdMul(simdMul(e.ch, e.sp), e.cb));
+	r->m33 = simdMul(e.ch, e.cp);
+}
+
+static void setupRotationMatrices(const EulerSource& src, RotationMatrix* out, size_t n, MathPrecision precision) {
+	forEachGroup(n, [&](size_t i, size_t count) {
+		SimdEulerSinCos e;
+		eulerSinCos(src, i, count, 1.0f, precision, &e);
+		SimdMatrix4x3 r;
+		simdSetupRotation(e, &r);
+		storeGroup(out + i, count, [&](RotationMatrix* m) { simdStoreRotationMatrices(m, r); });
+	});
+}
+
+//Matrix4x3::setupLocalToParent()ͬתת
+static void setupLocalToParentMatrices(const EulerSource& src, Matrix4x3* out, size_t n, MathPrecision precision) {
+	forEachGroup(n, [&](size_t i, size_t count) {
+		SimdEulerSinCos e;
+		eulerSinCos(src, i, count, 1.0f, precision, &e);
+		SimdMatrix4x3 r, m;
+		simdSetupRotation(e, &r);
+		m.m11 = r.m11; m.m12 = r.m21; m.m13 = r.m31;
+		m.m21 = r.m12; m.m22 = r.m22; m.m23 = r.m32;
+		m.m31 = r.m13; m.m32 = r.m23; m.m33 = r.m33;
+		m.tx = m.ty = m.tz = simdZero();
+		storeGroup(out + i, count, [&](Matrix4x3* p) { simdStoreMatrices(p, m); });
+	});
+}
+
+static EulerSource eulerSource(const EulerAngles* orientation) {
+	EulerSource src = { orientation, NULL, NULL, NULL };
+	return src;
+}
+
+static EulerSource eulerSource(const float* heading, const float* pitch, const float* bank) {
+	EulerSource src = { NULL, heading, pitch, bank };
+	return src;
+}
+
+void setToRotationObjectToInertial(const EulerAngles* orientation, Quaternion* out, size_t n, MathPrecision precision) {
+	objectToInertialQuaternions(eulerSource(orientation), out, n, precision);
+}
+
+void setToRotationObjectToInertial(const float* heading, const float* pitch, const float* bank, Quaternion* out, size_t n,
+	MathPrecision precision) {
+	objectToInertialQuaternions(eulerSource(heading, pitch, bank), out, n, precision);
+}
+
+void setToRotationInertialToObject(const EulerAngles* orientation, Quaternion* out, size_t n, MathPrecision precision) {
+	inertialToObjectQuaternions(eulerSource(orientation), out, n, precision);
+}
+
+void setToRotationInertialToObject(const float* heading, const float* pitch, const float* bank, Quaternion* out, size_t n,
+	MathPrecision precision) {
+	inertialToObjectQuaternions(eulerSource(heading, pitch, bank), out, n, precision);
+}
+
+void setupRotationMatrices(const EulerAngles* orientation, RotationMatrix* out, size_t n, MathPrecision precision) {
+	setupRotationMatrices(eulerSource(orientation), out, n, precision);
+}
+
+void setupRotationMatrices(const float* heading, const float* pitch, const float* bank, RotationMatrix* out, size_t n,
+	MathPrecision precision) {
+	setupRotationMatrices(eulerSource(heading, pitch, bank), out, n, precision);
+}
+
+void setupLocalToParentMatrices(const EulerAngles* orientation, Matrix4x3* out, size_t n, MathPrecision precision) {
+	setupLocalToParentMatrices(eulerSource(orientation), out, n, precision);
+}
+
+void setupLocalToParentMatrices(const float* heading, const float* pitch, const float* bank, Matrix4x3* out, size_t n,
+	MathPrecision precision) {
+	setupLocalToParentMatrices(eulerSource(heading, pitch, bank), out, n, precision);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// ᡪ
+/////////////////////////////////////////////////////////////////////////////
+
+//һᡪǣsincos
+struct SimdAxisAngle {
+	SimdFloat x, y, z, s, c;
+};
+
+//һᡪǲsincosscaleΪǶȵţԪðǣ
+static inline void axisAngleSinCos(const AxisAngleSource& src, size_t i, size_t count, float scale, MathPrecision precision,
+	SimdAxisAngle* r) {
+	SimdFloat theta;
+	if (count == kSimdWidth) {
+		src.load(i, &r->x, &r->y, &r->z, &theta);
+	}
+	else {
+		src.loadTail(i, count, &r->x, &r->y, &r->z, &theta);
+	}
+	simdSinCos(simdMul(theta, simdSet(scale)), &r->s, &r->c, precision);
+}
+
+//˳Quaternion::setQutaernionAboutAxis()ͬ
+static void quaternionsAboutAxis(const AxisAngleSource& src, Quaternion* out, size_t n, MathPrecision precision) {
+	forEachGroup(n, [&](size_t i, size_t count) {
+		SimdAxisAngle a;
+		axisAngleSinCos(src, i, count, 0.5f, precision, &a);
+		SimdFloat x = simdMul(a.x, a.s);
+		SimdFloat y = simdMul(a.y, a.s);
+		SimdFloat z = simdMul(a.z, a.s);
+		storeGroup(out + i, count, [&](Quaternion* q) { simdStoreQuaternions(q, x, y, z, a.c); });
+	});
+}
+
+//˳Matrix4x3::setupRotate(const Vector3&, float)ͬƽƲ
+static inline void simdSetupRotate(const SimdAxisAngle& a, SimdMatrix4x3* r) {
+	SimdFloat t = simdSub(simdSet(1.0f), a.c);
+	SimdFloat ax = simdMul(t, a.x);
+	SimdFloat ay = simdMul(t, a.y);
+	SimdFloat az = simdMul(t, a.z);
+
+	r->m11 = simdAdd(simdMul(ax, a.x), a.c);
+	r->m12 = simdAdd(simdMul(ax, a.y), simdMul(a.z, a.s));
+	r->m13 = simdSub(simdMul(ax, a.z), simdMul(a.y, a.s));
+
+	r->m21 = simdSub(simdMul(ay, a.x), simdMul(a.z, a.s));
+	r->m22 = simdAdd(simdMul(ay, a.y), a.c);
+	r->m23 = simdAdd(simdMul(ay, a.z), simdMul(a.x, a.s));
+
+	r->m31 = simdAdd(simdMul(az, a.x), simdMul(a.y, a.s));
+	r->m32 = simdSub(simdMul(az, a.y), simdMul(a.x, a.s));
+	r->m33 = simdAdd(simdMul(az, a.z), a.c);
+
+	r->tx = r->ty = r->tz = simdZero();
+}
+
+static void setupRotateMatrices(const AxisAngleSource& src, Matrix4x3* out, size_t n, MathPrecision precision) {
+	forEachGroup(n, [&](size_t i, size_t count) {
+		SimdAxisAngle a;
+		axisAngleSinCos(src, i, count, 1.0f, precision, &a);
+		SimdMatrix4x3 r;
+		simdSetupRotate(a, &r);
+		storeGroup(out + i, count, [&](Matrix4x3* m) { simdStoreMatrices(m, r); });
+	});
+}
+
+static void setupRotateMatrices(const AxisAngleSource& src, RotationMatrix* out, size_t n, MathPrecision precision) {
+	forEachGroup(n, [&](size_t i, size_t count) {
+		SimdAxisAngle a;
+		axisAngleSinCos(src, i, count, 1.0f, precision, &a);
+		SimdMatrix4x3 r;
+		simdSetupRotate(a, &r);
+		storeGroup(out + i, count, [&](RotationMatrix* m) { simdStoreRotationMatrices(m, r); });
+	});
+}
+
+static AxisAngleSource axisAngleSource(const Vector3* axis, const float* theta) {
+	AxisAngleSource src = { axis, NULL, theta };
+	return src;
+}
+
+static AxisAngleSource axisAngleSource(const Vector3Array& axis, const float* theta, size_t n) {
+	assert(axis.size() >= n);
+	(void)n;
+	AxisAngleSource src = { NULL, &axis, theta };
+	return src;
+}
+
+void setQuaternionsAboutAxis(const Vector3* axis, const float* theta, Quaternion* out, size_t n, MathPrecision precision) {
+	quaternionsAboutAxis(axisAngleSource(axis, theta), out, n, precision);
+}
+
+void setQuaternionsAboutAxis(const Vector3Array& axis, const float* theta, Quaternion* out, size_t n,
+	MathPrecision precision) {
+	quaternionsAboutAxis(axisAngleSource(axis, theta, n), out, n, precision);
+}
+
+void setupRotateMatrices(const Vector3* axis, const float* theta, Matrix4x3* out, size_t n, MathPrecision precision) {
+	setupRotateMatrices(axisAngleSource(axis, theta), out, n, precision);
+}
+
+void setupRotateMatrices(const Vector3Array& axis, const float* theta, Matrix4x3* out, size_t n,
+	MathPrecision precision) {
+	setupRotateMatrices(axisAngleSource(axis, theta, n), out, n, precision);
+}
+
+void setupRotateMatrices(const Vector3* axis, const float* theta, RotationMatrix* out, size_t n, MathPrecision precision) {
+	setupRotateMatrices(axisAngleSource(axis, theta), out, n, precision);
+}
+
+void setupRotateMatrices(const Vector3Array& axis, const float* theta, RotationMatrix* out, size_t n,
+	MathPrecision precision) {
+	setupRotateMatrices(axisAngleSource(axis, theta, n), out, n, precision);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#ifndef __ORIENTATIONARRAY_H_INCLUDED__
+#define __ORIENTATIONARRAY_H_INCLUDED__
+
+#include <stddef.h>
+#include "MathUtil.h"
+
+template <typename T> class Vector3T;
+typedef Vector3T<float> Vector3;
+class Vector3Array;
+class EulerAngles;
+class Quaternion;
+class RotationMatrix;
+template <typename T> class Matrix4x3T;
+typedef Matrix4x3T<float> Matrix4x3;
+
+// ƣλת
+// ߣcary
+// һŷǻᡪתΪԪת4X3ÿתkSimdWidth48
+//		ÿsincosһSIMDsinCosͬʱٰӦĵ汾Ĺʽ
+//
+//		ŷǿAoSEulerAngles飩ҲSoAheadingpitchbankfloat飩
+//		ᡪǵAoSVector3飩ҲSoAVector3ArrayǶfloat飬ǵλ
+//
+//		sinCosArray()һоȵȼʹöʽƣ
+//		precisionkPrecisionFullʱ͵汾λһ£
+//		kPrecisionFullʱ汾ñ׼⺯1ulpҵĲ
+
+//ŷǼ塪ԵԪQuaternion::setToRotationObjectToInertial()ͬ
+void setToRotationObjectToInertial(const EulerAngles* orientation, Quaternion* out, size_t n,
+	MathPrecision precision = kPrecisionFull);
+void setToRotationObjectToInertial(const float* heading, const float* pitch, const float* bank, Quaternion* out, size_t n,
+	MathPrecision precision = kPrecisionFull);
+
+//ŷǼԡԪQuaternion::setToRotationInertialToObject()ͬ
+void setToRotationInertialToObject(const EulerAngles* orientation, Quaternion* out, size_t n,
+	MathPrecision precision = kPrecisionFull);
+void setToRotationInertialToObject(const float* heading, const float* pitch, const float* bank, Quaternion* out, size_t n,
+	MathPrecision precision = kPrecisionFull);
+
+//ŷǹת󣬺RotationMatrix::setup()ͬ
+void setupRotationMatrices(const EulerAngles* orientation, RotationMatrix* out, size_t n,
+	MathPrecision precision = kPrecisionFull);
+void setupRotationMatrices(const float* heading, const float* pitch, const float* bank, RotationMatrix* out, size_t n,
+	MathPrecision precision = kPrecisionFull);
+
+//ŷǹֲռı任ƽƲ
+//Matrix4x3::setupLocalToParent()λΪʱͬ
+void setupLocalToParentMatrices(const EulerAngles* orientation, Matrix4x3* out, size_t n,
+	MathPrecision precision = kPrecisionFull);
+void setupLocalToParentMatrices(const float* heading, const float* pitch, const float* bank, Matrix4x3* out, size_t n,
+	MathPrecision precision = kPrecisionFull);
+
+//תthetaԪQuaternion::setQutaernionAboutAxis()ͬ
+//汾ǵñ׼⺯1ulpҵĲ
+void setQuaternionsAboutAxis(const Vector3* axis, const float* theta, Quaternion* out, size_t n,
+	MathPrecision precision = kPrecisionFull);
+void setQuaternionsAboutAxis(const Vector3Array& axis, const float* theta, Quaternion* out, size_t n,
+	MathPrecision precision = kPrecisionFull);
+
+//תthetaľƽƲ㣬Matrix4x3::setupRotate(const Vector3&, float)ͬ
+void setupRotateMatrices(const Vector3* axis, const float* theta, Matrix4x3* out, size_t n,
+	MathPrecision precision = kPrecisionFull);
+void setupRotateMatrices(const Vector3Array& axis, const float* theta, Matrix4x3* out, size_t n,
+	MathPrecision precision = kPrecisionFull);
+
+//תthetaתԪغsetupRotateMatrices()3X3ͬ
+void setupRotateMatrices(const Vector3* axis, const float* theta, RotationMatrix* out, size_t n,
+	MathPrecision precision = kPrecisionFull);
+void setupRotateMatrices(const Vector3Array& axis, const float* theta, RotationMatrix* out, size_t n,
+	MathPrecision precision = kPrecisionFull);
+
+#endif // #ifndef __ORIENTATIONARRAY_H_INCLUDED__
@@ -5,6 +5,8 @@
 #include "MathUtil.h"
 #include "EulerAngles.h"
 #include "Vector3.h"
+#include "SimdUtil.h"
+#include "SimdQuaternion.h"
 
 
 // ƣԪ
@@ -12,11 +14,6 @@
 // ʵ3DбʾλƵԪ
 //	
 
-//ȫ֡λԪ
-const Quaternion kQuaternionIdentity = {
-	1.0f,0.0f,0.0f,0.0f
-};
-
 
 void Quaternion::setQuaternionAboutX(float theta) {
 	float thetaOver2 = theta * 0.5f;
@@ -55,12 +52,12 @@ void Quaternion::setQutaernionAboutAxis(const Vector3& axis, float theta) {
 }
 
 //ŷǼ塪ԵԪ
-void Quaternion::setToRotationObjectToInertial(const EulerAngles& orientation) {
+void Quaternion::setToRotationObjectToInertial(const EulerAngles& orientation, MathPrecision precision) {
 	float sinPitch, sinBank, sinHeading;
 	float cosPitch, cosBank, cosHeading;
-	sinCos(&sinPitch, &cosPitch, orientation.pitch * 0.5f);
-	sinCos(&sinBank, &cosBank, orientation.bank * 0.5f);
-	sinCos(&sinHeading, &cosHeading, orientation.heading * 0.5f);
+	fastSinCos(&sinPitch, &cosPitch, orientation.pitch * 0.5f, precision);
+	fastSinCos(&sinBank, &cosBank, orientation.bank * 0.5f, precision);
+	fastSinCos(&sinHeading, &cosHeading, orientation.heading * 0.5f, precision);
 
 	w = cosHeading * cosPitch * cosBank + sinHeading * sinPitch * sinBank;
 	x = cosHeading * sinPitch * cosBank + sinHeading * cosPitch * sinBank;
@@ -69,12 +66,12 @@ void Quaternion::setToRotationObjectToInertial(const EulerAngles& orientation) {
 }
 
 //ŷǼԡԪ
-void Quaternion::setToRotationInertialToObject(const EulerAngles& orientation) {
+void Quaternion::setToRotationInertialToObject(const EulerAngles& orientation, MathPrecision precision) {
 	float sinPitch, sinBank, sinHeading;
 	float cosPitch, cosBank, cosHeading;
-	sinCos(&sinPitch, &cosPitch, orientation.pitch * 0.5f);
-	sinCos(&sinBank, &cosBank, orientation.bank * 0.5f);
-	sinCos(&sinHeading, &cosHeading, orientation.heading * 0.5f);
+	fastSinCos(&sinPitch, &cosPitch, orientation.pitch * 0.5f, precision);
+	fastSinCos(&sinBank, &cosBank, orientation.bank * 0.5f, precision);
+	fastSinCos(&sinHeading, &cosHeading, orientation.heading * 0.5f, precision);
 
 	w = cosHeading * cosPitch * cosBank + sinHeading * sinPitch * sinBank;
 	x = -cosHeading * sinPitch * cosBank - sinHeading * cosPitch * sinBank;
@@ -82,30 +79,12 @@ void Quaternion::setToRotationInertialToObject(const EulerAngles& orientation) {
 	z = sinHeading * sinPitch * cosBank - cosHeading * cosPitch * sinBank;
 }
 
-//* ʵֲ
-Quaternion Quaternion::operator *(const Quaternion& a)const {
-	Quaternion result;
-
-	result.w = w * a.w - x * a.x - y * a.y - z * a.z;
-	result.x = w * a.w + x * a.x - y * a.y - z * a.z;
-	result.y = w * a.w + x * a.x + y * a.y - z * a.z;
-	result.z = w * a.w - x * a.x + y * a.y + z * a.z;
-
-	return result;
-}
-
-//*= ʵֲ˲ֵ
-Quaternion& Quaternion::operator *=(const Quaternion& a) {
-	*this = *this * a;
-	return *this;
-}
-
 //
 //ṩҪΪ˷ֹԪܵ
 void Quaternion::normalize() {
 	float mag = (float)sqrt(double(w) * double(w) + double(x) * double(x) + double(y) * double(y) + double(z) * double(z));
 	if (mag > 0.0f) {
-		float oneOverMag = mag / 1.0f;
+		float oneOverMag = 1.0f / mag;
 		w *= oneOverMag;
 		x *= oneOverMag;
 		y *= oneOverMag;
@@ -189,11 +168,11 @@ extern Quaternion slerp(const Quaternion& q0, const Quaternion& q1, float t) {
 		//sin^2(omega) + cos^2(omega)=  1
 		float sinOmega = sqrt(1.0f - double(cosOmega) * (double(cosOmega)));
 		float omega = atan2(sinOmega, cosOmega);
-		float oneOverOmega = 1.0f / omega;
+		float oneOverSinOmega = 1.0f / sinOmega;
 
 		//ֵ
-		k0 = sin(double(1.0 - double(t)) * double(omega)) * oneOverOmega;
-		k1 = sin(double(t) * double(omega)) * oneOverOmega;
+		k0 = sin(double(1.0 - double(t)) * double(omega)) * oneOverSinOmega;
+		k1 = sin(double(t) * double(omega)) * oneOverSinOmega;
 	}
 	Quaternion result;
 	result.w = k0 * q0.w + k1 * q1w;
@@ -203,6 +182,156 @@ extern Quaternion slerp(const Quaternion& q0, const Quaternion& q1, float t) {
 	return result;
 }
 
+//SIMDslerpõĶʽ
+
+//acos(x)x[0,1]֮
+//Abramowitz & Stegun 4.4.46acos(x) = sqrt(1-x) * P(x)С2e-8
+static inline SimdFloat simdAcosPositive(SimdFloat x) {
+	SimdFloat p = simdSet(-0.0012624911f);
+	p = simdAdd(simdMul(p, x), simdSet(0.0066700901f));
+	p = simdAdd(simdMul(p, x), simdSet(-0.0170881256f));
+	p = simdAdd(simdMul(p, x), simdSet(0.0308918810f));
+	p = simdAdd(simdMul(p, x), simdSet(-0.0501743046f));
+	p = simdAdd(simdMul(p, x), simdSet(0.0889789874f));
+	p = simdAdd(simdMul(p, x), simdSet(-0.2145988016f));
+	p = simdAdd(simdMul(p, x), simdSet(1.5707963050f));
+	return simdMul(simdSqrt(simdSub(simdSet(1.0f), x)), p);
+}
+
+//sin(x)x[0,pi/2]֮
+//̩չx^11pi/2ضС6e-8
+static inline SimdFloat simdSinHalfPi(SimdFloat x) {
+	SimdFloat x2 = simdMul(x, x);
+	SimdFloat p = simdSet(-2.5052108e-8f);
+	p = simdAdd(simdMul(p, x2), simdSet(2.7557319e-6f));
+	p = simdAdd(simdMul(p, x2), simdSet(-1.9841270e-4f));
+	p = simdAdd(simdMul(p, x2), simdSet(8.3333333e-3f));
+	p = simdAdd(simdMul(p, x2), simdSet(-1.6666667e-1f));
+	return simdAdd(x, simdMul(simdMul(x, x2), p));
+}
+
+//Quaternion x y z w ĸfloatһתóSoA
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion must be four packed floats");
+
+//Բֵ
+//slerp()
+//	ѡǡӽʱ˻ΪԲֵt[0,1]ʱض˵㣬ѡ֧
+//	acossinöʽƣȫfloat
+//Ԫͬ෴ͷǳӽԣ
+//slerp()֮ǶԼΪ 3.6e-7 
+extern void slerpBatch(const Quaternion* q0, const Quaternion* q1, const float* t, Quaternion* out, size_t n) {
+	const SimdFloat zero = simdZero();
+	const SimdFloat one = simdSet(1.0f);
+	const SimdFloat signMask = simdSet(-0.0f);
+	//slerp()ֵͬ
+	const SimdFloat linearThreshold = simdSet(0.9999f);
+
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat ax, ay, az, aw;
+		SimdFloat bx, by, bz, bw;
+		simdLoad4x(&q0[i].x, 4, &ax, &ay, &az, &aw);
+		simdLoad4x(&q1[i].x, 4, &bx, &by, &bz, &bw);
+		SimdFloat vt = simdLoad(t + i);
+
+		//õ˼нǵcosֵ˳dotProduct()ͬ
+		SimdFloat cosOmega = simdAdd(simdAdd(simdAdd(simdMul(aw, bw), simdMul(ax, bx)), simdMul(ay, by)), simdMul(az, bz));
+
+		//Ϊʱʹ-q1cosOmegaķλq1ÿ
+		SimdFloat sign = simdAnd(cosOmega, signMask);
+		SimdFloat fx = simdXor(bx, sign);
+		SimdFloat fy = simdXor(by, sign);
+		SimdFloat fz = simdXor(bz, sign);
+		SimdFloat fw = simdXor(bw, sign);
+		cosOmega = simdMin(simdXor(cosOmega, sign), one);
+
+		//sin(omega) = sqrt((1-cos)(1+cos))sqrt(1-cos^2)cosӽ1ʱȷ
+		SimdFloat sinOmega = simdSqrt(simdMul(simdSub(one, cosOmega), simdAdd(one, cosOmega)));
+		SimdFloat omega = simdAcosPositive(cosOmega);
+		SimdFloat oneOverSinOmega = simdDiv(one, sinOmega);
+		SimdFloat k0 = simdMul(simdSinHalfPi(simdMul(simdSub(one, vt), omega)), oneOverSinOmega);
+		SimdFloat k1 = simdMul(simdSinHalfPi(simdMul(vt, omega)), oneOverSinOmega);
+
+		//ǳӽʱԲֵsinOmegaΪЧֵҲﱻ
+		SimdFloat nearlyLinear = simdCmpGt(cosOmega, linearThreshold);
+		k0 = simdSelect(nearlyLinear, simdSub(one, vt), k0);
+		k1 = simdSelect(nearlyLinear, vt, k1);
+
+		SimdFloat rx = simdAdd(simdMul(k0, ax), simdMul(k1, fx));
+		SimdFloat ry = simdAdd(simdMul(k0, ay), simdMul(k1, fy));
+		SimdFloat rz = simdAdd(simdMul(k0, az), simdMul(k1, fz));
+		SimdFloat rw = simdAdd(simdMul(k0, aw), simdMul(k1, fw));
+
+		//tΧʱֱӷض˵
+		SimdFloat atStart = simdCmpLe(vt, zero);
+		SimdFloat atEnd = simdCmpGe(vt, one);
+		rx = simdSelect(atStart, ax, simdSelect(atEnd, bx, rx));
+		ry = simdSelect(atStart, ay, simdSelect(atEnd, by, ry));
+		rz = simdSelect(atStart, az, simdSelect(atEnd, bz, rz));
+		rw = simdSelect(atStart, aw, simdSelect(atEnd, bw, rw));
+
+		simdStore4x(&out[i].x, 4, rx, ry, rz, rw);
+	}
+	for (; i < n; ++i) {
+		out[i] = slerp(q0[i], q1[i], t[i]);
+	}
+}
+
+//ˣout[i] = a[i] * b[i]
+extern void multiplyBatch(const Quaternion* a, const Quaternion* b, Quaternion* out, size_t n) {
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat px, py, pz, pw;
+		SimdFloat ax, ay, az, aw;
+		simdLoad4x(&a[i].x, 4, &px, &py, &pz, &pw);
+		simdLoad4x(&b[i].x, 4, &ax, &ay, &az, &aw);
+		SimdFloat rx, ry, rz, rw;
+		simdMultiply(px, py, pz, pw, ax, ay, az, aw, &rx, &ry, &rz, &rw);
+		simdStore4x(&out[i].x, 4, rx, ry, rz, rw);
+	}
+	for (; i < n; ++i) {
+		out[i] = a[i] * b[i];
+	}
+}
+
+//ظڵתout[i] = local[i] * out[parent[i]]
+extern void composeHierarchy(const Quaternion* local, const int* parent, Quaternion* out, size_t n) {
+	assert(n == 0 || local != out);
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		//ڵ㶼ѾòҲǸڵʱѸڵĽռת
+		bool independent = true;
+		for (size_t j = 0; j < kSimdWidth; ++j) {
+			assert(parent[i + j] < (int)(i + j));
+			independent = independent && parent[i + j] >= 0 && parent[i + j] < (int)i;
+		}
+		if (!independent) {
+			for (size_t j = i; j < i + kSimdWidth; ++j) {
+				out[j] = parent[j] < 0 ? local[j] : local[j] * out[parent[j]];
+			}
+			continue;
+		}
+		Quaternion parents[kSimdWidth];
+		for (size_t j = 0; j < kSimdWidth; ++j) {
+			parents[j] = out[parent[i + j]];
+		}
+		SimdFloat px, py, pz, pw;
+		SimdFloat ax, ay, az, aw;
+		simdLoad4x(&local[i].x, 4, &px, &py, &pz, &pw);
+		simdLoad4x(&parents[0].x, 4, &ax, &ay, &az, &aw);
+		SimdFloat rx, ry, rz, rw;
+		simdMultiply(px, py, pz, pw, ax, ay, az, aw, &rx, &ry, &rz, &rw);
+		simdStore4x(&out[i].x, 4, rx, ry, rz, rw);
+	}
+	for (; i < n; ++i) {
+		assert(parent[i] < (int)i);
+		out[i] = parent[i] < 0 ? local[i] : local[i] * out[parent[i]];
+	}
+}
+
 //Ԫ
 //ԭԪת෴Ԫ
 extern Quaternion conjugate(const Quaternion& q) {
@@ -2,13 +2,16 @@
 #ifndef __QUATERNION_H_INCLUDEED__
 #define __QUATERNION_H_INCLUDEED__
 
+#include <stddef.h>
+#include "MathUtil.h"
+#include "SimdUtil.h"
+#include "Vector3.h"
 
 // ƣԪ
 // ߣcary
 // ʵ3DбʾλƵԪ
 //		
 
-class Vector3;
 class EulerAngles;
 
 class Quaternion
@@ -17,8 +20,9 @@ public:
 	float x, y, z, w;
 
 	//ΪԪԪ
-	void identity(){
-		w = x = y = z = 0.0f;
+	constexpr void identity(){
+		w = 1.0f;
+		x = y = z = 0.0f;
 	}
 
 	void setQuaternionAboutX(float theta);
@@ -27,11 +31,13 @@ public:
 	void setQutaernionAboutAxis(const Vector3& axis, float theta);
 
 	//ŷǼ塪ԵԪ
-	void setToRotationObjectToInertial(const EulerAngles& orientation);
+	//precisionѡsincosľȣMathUtil.h
+	void setToRotationObjectToInertial(const EulerAngles& orientation, MathPrecision precision = kPrecisionFull);
 	//ŷǼԡԪ
-	void setToRotationInertialToObject(const EulerAngles& orientation);
+	void setToRotationInertialToObject(const EulerAngles& orientation, MathPrecision precision = kPrecisionFull);
 
-	//* ʵֲ
+	//* ʵֲˣp * a ʾȽpתٽaת
+	//SSEʱһ4·ĳ˼ɣͱ汾λһ
 	Quaternion operator *(const Quaternion& a) const;
 	//*= ʵֲ˲ֵ
 	Quaternion& operator *=(const Quaternion& a);
@@ -45,8 +51,62 @@ public:
 	Vector3 getRotaionAxis() const;
 };
 
-//ȫ֡λԪ
-extern const Quaternion kQuaternionIdentity;
+//ˣ (w * a + ڶ) +  -  ˳ۼӣSSE汾ÿһһ4·ĳ˷
+//汾ͬ˳λһ
+//	r.x = w * a.x + x * a.w + z * a.y - y * a.z
+//	r.y = w * a.y + y * a.w + x * a.z - z * a.x
+//	r.z = w * a.z + z * a.w + y * a.x - x * a.y
+//	r.w = w * a.w - x * a.x - y * a.y - z * a.z
+#if defined(MATH_SIMD_SSE) || defined(MATH_SIMD_AVX)
+
+inline __m128 quaternionMultiplySse(__m128 p, __m128 a) {
+	//ڶ͵wȡ
+	const __m128 negateW = _mm_set_ps(-0.0f, 0.0f, 0.0f, 0.0f);
+	__m128 r = _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3)), a);
+	//x y z x * w w w x
+	__m128 t = _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 2, 1, 0)), _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 3, 3, 3)));
+	r = _mm_add_ps(r, _mm_xor_ps(t, negateW));
+	//z x y y * y z x y
+	t = _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 0, 2)), _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 2, 1)));
+	r = _mm_add_ps(r, _mm_xor_ps(t, negateW));
+	//y z x z * z x y z
+	t = _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 0, 2, 1)), _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 1, 0, 2)));
+	return _mm_sub_ps(r, t);
+}
+
+inline Quaternion Quaternion::operator *(const Quaternion& a) const {
+	Quaternion result;
+	_mm_storeu_ps(&result.x, quaternionMultiplySse(_mm_loadu_ps(&x), _mm_loadu_ps(&a.x)));
+	return result;
+}
+
+inline Quaternion& Quaternion::operator *=(const Quaternion& a) {
+	_mm_storeu_ps(&x, quaternionMultiplySse(_mm_loadu_ps(&x), _mm_loadu_ps(&a.x)));
+	return *this;
+}
+
+#else
+
+inline Quaternion Quaternion::operator *(const Quaternion& a) const {
+	Quaternion result;
+	result.x = w * a.x + x * a.w + z * a.y - y * a.z;
+	result.y = w * a.y + y * a.w + x * a.z - z * a.x;
+	result.z = w * a.z + z * a.w + y * a.x - x * a.y;
+	result.w = w * a.w - x * a.x - y * a.y - z * a.z;
+	return result;
+}
+
+inline Quaternion& Quaternion::operator *=(const Quaternion& a) {
+	*this = *this * a;
+	return *this;
+}
+
+#endif
+
+//ȫ֡λԪԱ˳Ϊxyzwڳ
+constexpr Quaternion kQuaternionIdentity = {
+	0.0f, 0.0f, 0.0f, 1.0f
+};
 
 //Ԫ
 extern float dotProduct(const Quaternion& a, const Quaternion& b);
@@ -54,9 +114,41 @@ extern float dotProduct(const Quaternion& a, const Quaternion& b);
 //Բֵ
 extern Quaternion slerp(const Quaternion& q0, const Quaternion& q1, float t);
 
+//Բֵout[i] = slerp(q0[i], q1[i], t[i])
+//޷֧SIMDʵ֣slerp()ǶԼΪ 4e-7 
+//out Ժ q0  q1 ͬһ
+extern void slerpBatch(const Quaternion* q0, const Quaternion* q1, const float* t, Quaternion* out, size_t n);
+
+//ˣout[i] = a[i] * b[i]ÿμkSimdWidth48operator*λһ
+//out Ժ a  b ͬһ
+extern void multiplyBatch(const Quaternion* a, const Quaternion* b, Quaternion* out, size_t n);
+
+//ظڵתڹΣ
+//	parent[i] < 0 ʱ out[i] = local[i] out[i] = local[i] * out[parent[i]]
+//	ȽйԸתٽиתoperator*λһ
+//ڵӽڵ֮ǰparent[i] < i
+//һkSimdWidthĸڵ㶼һ֮ǰʱSIMD㣬һ㣬
+//ԹͬһĹڣʱЧ
+//out ܺ local ͬһ
+extern void composeHierarchy(const Quaternion* local, const int* parent, Quaternion* out, size_t n);
+
 //Ԫ
 extern Quaternion conjugate(const Quaternion& q);
 
+//õλԪת v * mmMatrix4x3::fromQuaternion(q)죩ֻͬĲ
+//ҪȹֻתʱʹãתʱȹtransformVectors()
+//t = 2 * cross(q.xyz, v)v' = v + w * t + cross(q.xyz, t)SIMD汾SimdQuaternion.h˳ͬ
+inline Vector3 rotate(const Quaternion& q, const Vector3& v) {
+	float tx = 2.0f * (q.y * v.z - q.z * v.y);
+	float ty = 2.0f * (q.z * v.x - q.x * v.z);
+	float tz = 2.0f * (q.x * v.y - q.y * v.x);
+	return Vector3(
+		(v.x + q.w * tx) + (q.y * tz - q.z * ty),
+		(v.y + q.w * ty) + (q.z * tx - q.x * tz),
+		(v.z + q.w * tz) + (q.x * ty - q.y * tx)
+	);
+}
+
 //Ԫ
 extern Quaternion pow(const Quaternion& q, float exponent);
 
@@ -3,6 +3,7 @@
 #include "EulerAngles.h"
 #include "MathUtil.h"
 #include "Quaternion.h"
+#include "SimdUtil.h"
 
 // ƣת
 // ߣcary
@@ -36,13 +37,13 @@ void RotationMatrix::identity() {
 }
 
 //ŷǹ
-void RotationMatrix::setup(const EulerAngles& orientation) {
+void RotationMatrix::setup(const EulerAngles& orientation, MathPrecision precision) {
 	float sinh, cosh, sinp, cosp, sinb, cosb;
-	sinCos(&sinh, &cosh, orientation.heading);
-	sinCos(&sinp, &cosp, orientation.pitch);
-	sinCos(&sinb, &cosb, orientation.bank);
+	fastSinCos(&sinh, &cosh, orientation.heading, precision);
+	fastSinCos(&sinp, &cosp, orientation.pitch, precision);
+	fastSinCos(&sinb, &cosb, orientation.bank, precision);
 
-	m11 = cosh * cosb + sinh + sinp, sinb;
+	m11 = cosh * cosb + sinh * sinp * sinb;
 	m12 = -cosh * sinb + sinh * sinp * cosb;
 	m13 = sinh * cosp;
 
@@ -113,3 +114,64 @@ Vector3 RotationMatrix::objectToIntertial(const Vector3& v)const {
 	);
 }
 
+
+//Ԫ˳formIntertialToObjectQuaternion()ͬ
+//塪ԾתãtransposeΪtrueʱתд
+static void formQuaternions(const Quaternion* q, RotationMatrix* out, size_t n, bool transpose) {
+	const SimdFloat one = simdSet(1.0f);
+	const SimdFloat two = simdSet(2.0f);
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat x, y, z, w;
+		simdLoad4x(&q[i].x, 4, &x, &y, &z, &w);
+		SimdFloat xx = simdMul(x, x), xy = simdMul(x, y), xz = simdMul(x, z);
+		SimdFloat yy = simdMul(y, y), yz = simdMul(y, z), zz = simdMul(z, z);
+		SimdFloat wx = simdMul(w, x), wy = simdMul(w, y), wz = simdMul(w, z);
+
+		SimdFloat m11 = simdSub(one, simdMul(two, simdAdd(yy, zz)));
+		SimdFloat m12 = simdMul(two, simdAdd(xy, wz));
+		SimdFloat m13 = simdMul(two, simdSub(xz, wy));
+
+		SimdFloat m21 = simdMul(two, simdSub(xy, wz));
+		SimdFloat m22 = simdSub(one, simdMul(two, simdAdd(xx, zz)));
+		SimdFloat m23 = simdMul(two, simdAdd(yz, wx));
+
+		SimdFloat m31 = simdMul(two, simdAdd(xz, wy));
+		SimdFloat m32 = simdMul(two, simdSub(yz, wx));
+		SimdFloat m33 = simdSub(one, simdMul(two, simdAdd(xx, yy)));
+
+		if (transpose) {
+			SimdFloat t = m12; m12 = m21; m21 = t;
+			t = m13; m13 = m31; m31 = t;
+			t = m23; m23 = m32; m32 = t;
+		}
+		//ÿ9Ԫأǰ8תдm33д
+		float* p = &out[i].m11;
+		simdStore4x(p, 9, m11, m12, m13, m21);
+		simdStore4x(p + 4, 9, m22, m23, m31, m32);
+		float last[kSimdWidth];
+		simdStore(last, m33);
+		for (size_t k = 0; k < kSimdWidth; ++k) {
+			out[i + k].m33 = last[k];
+		}
+	}
+	for (; i < n; ++i) {
+		if (transpose) {
+			out[i].formObjectToIntertialQuaternion(q[i]);
+		}
+		else {
+			out[i].formIntertialToObjectQuaternion(q[i]);
+		}
+	}
+}
+
+//ݹԡתԪ
+void formIntertialToObjectQuaternions(const Quaternion* q, RotationMatrix* out, size_t n) {
+	formQuaternions(q, out, n, false);
+}
+
+//塪תԪ
+void formObjectToIntertialQuaternions(const Quaternion* q, RotationMatrix* out, size_t n) {
+	formQuaternions(q, out, n, true);
+}
@@ -2,9 +2,13 @@
 #ifndef _ROTATIONMATRIX_N_INCLUDED
 #define _ROTATIONMATRIX_N_INCLUDED
 
+#include <stddef.h>
+#include "MathUtil.h"
+
 class EulerAngles;
 class Quaternion;
-class Vector3;
+template <typename T> class Vector3T;
+typedef Vector3T<float> Vector3;
 
 // ƣת
 // ߣcary
@@ -23,7 +27,8 @@ public:
 
 	//ָ
 	//ŷǹ
-	void setup(const EulerAngles& orientation);
+	//precisionѡsincosľȣMathUtil.h
+	void setup(const EulerAngles& orientation, MathPrecision precision = kPrecisionFull);
 
 	//Ԫ󣬸Ԫָı任
 	//ݹԡתԪ
@@ -39,4 +44,10 @@ public:
 
 };
 
+//ԪÿιkSimdWidth48öӦĳԱλһ
+//out[i].formIntertialToObjectQuaternion(q[i])
+void formIntertialToObjectQuaternions(const Quaternion* q, RotationMatrix* out, size_t n);
+//out[i].formObjectToIntertialQuaternion(q[i])
+void formObjectToIntertialQuaternions(const Quaternion* q, RotationMatrix* out, size_t n);
+
 #endif // #ifndef _ROTATIONMATRIX_N_INCLUDED
\ No newline at end of file
@@ -0,0 +1,205 @@
+#pragma once
+
+#ifndef __SIMDMATH_H_INCLUDED__
+#define __SIMDMATH_H_INCLUDED__
+
+#include "MathUtil.h"
+#include "SimdUtil.h"
+
+// ƣSIMDѧ
+// ߣcary
+// ǺͷǺSIMDʽƣÿμkSimdWidthֵ
+//		MathPrecisionѡ񣨸ȼ[-1e4,1e4]ĽǶȷΧڲԣ
+//		              sin/cos     acos/asin    atan2
+//		kPrecisionFull    9e-8        3e-7         3e-7
+//		kPrecisionMedium  1e-6        5e-6         2e-6
+//		kPrecisionLow     2e-4        4e-4         7e-4
+//		precision һǳ֧ᱻ
+
+// ڲʹõpiMathUtilеkPi༸λЧ
+const float kSimdPi = 3.14159265358979f;
+const float kSimdPiOver2 = 1.57079632679490f;
+
+// sincos[-pi/4,pi/4]ϵĶʽ
+inline SimdFloat simdSinPoly(SimdFloat x, SimdFloat x2, MathPrecision precision) {
+	SimdFloat p;
+	switch (precision) {
+	case kPrecisionLow:
+		return simdMul(x, simdAdd(simdSet(9.9903144806e-1f), simdMul(x2, simdSet(-1.6034406687e-1f))));
+	case kPrecisionMedium:
+		p = simdAdd(simdMul(x2, simdSet(8.1529919654e-3f)), simdSet(-1.6662833786e-1f));
+		break;
+	default:
+		//cephes sinf
+		p = simdAdd(simdMul(x2, simdSet(-1.9515295891e-4f)), simdSet(8.3321608736e-3f));
+		p = simdAdd(simdMul(p, x2), simdSet(-1.6666654611e-1f));
+		break;
+	}
+	return simdAdd(x, simdMul(simdMul(x, x2), p));
+}
+
+inline SimdFloat simdCosPoly(SimdFloat x2, MathPrecision precision) {
+	const SimdFloat one = simdSet(1.0f);
+	SimdFloat p;
+	switch (precision) {
+	case kPrecisionLow:
+		p = simdAdd(simdMul(x2, simdSet(4.0488936813e-2f)), simdSet(-4.9977630756e-1f));
+		return simdAdd(one, simdMul(x2, p));
+	case kPrecisionMedium:
+		p = simdAdd(simdMul(x2, simdSet(-1.3652449420e-3f)), simdSet(4.1661278581e-2f));
+		break;
+	default:
+		//cephes cosf
+		p = simdAdd(simdMul(x2, simdSet(2.443315711809948e-5f)), simdSet(-1.388731625493765e-3f));
+		p = simdAdd(simdMul(p, x2), simdSet(4.166664568298827e-2f));
+		break;
+	}
+	return simdAdd(simdSub(one, simdMul(x2, simdSet(0.5f))), simdMul(simdMul(x2, x2), p));
+}
+
+// ͬʱsincos
+// Ȱpi/2ѽǶȹԼ[-pi/4,pi/4]ٸ޽sin/cos
+// pi/2ֳCody-Waite|theta|1e4ʱԼԺ
+inline void simdSinCos(SimdFloat theta, SimdFloat* returnSin, SimdFloat* returnCos, MathPrecision precision) {
+	const SimdFloat one = simdSet(1.0f);
+	const SimdFloat two = simdSet(2.0f);
+	SimdFloat j = simdRound(simdMul(theta, simdSet(0.636619772367581f)));
+	SimdFloat x = simdSub(theta, simdMul(j, simdSet(1.5703125f)));
+	x = simdSub(x, simdMul(j, simdSet(4.837512969970703125e-4f)));
+	x = simdSub(x, simdMul(j, simdSet(7.54978995489188216e-8f)));
+	SimdFloat x2 = simdMul(x, x);
+	SimdFloat s = simdSinPoly(x, x2, precision);
+	SimdFloat c = simdCosPoly(x2, precision);
+
+	// q = j mod 4øõAVX1ûеָ
+	SimdFloat q = simdSub(j, simdMul(simdFloor(simdMul(j, simdSet(0.25f))), simdSet(4.0f)));
+	//޽sincos
+	SimdFloat odd = simdCmpEq(simdSub(q, simdMul(simdFloor(simdMul(q, simdSet(0.5f))), two)), one);
+	SimdFloat rs = simdSelect(odd, c, s);
+	SimdFloat rc = simdSelect(odd, s, c);
+	//sinڵ23Ϊcosڵ12Ϊ
+	SimdFloat signMask = simdSet(-0.0f);
+	SimdFloat sinNeg = simdCmpGe(q, two);
+	SimdFloat cosNeg = simdAnd(simdCmpGe(q, one), simdCmpLe(q, two));
+	*returnSin = simdXor(rs, simdAnd(sinNeg, signMask));
+	*returnCos = simdXor(rc, simdAnd(cosNeg, signMask));
+}
+
+// asin(x)x[-1,1]֮䣬Χʱֵ߽
+inline SimdFloat simdAsin(SimdFloat x, MathPrecision precision);
+
+// acos(x)x[-1,1]֮䣬Χʱֵ߽[0,pi]safeAcos()һ
+inline SimdFloat simdAcos(SimdFloat x, MathPrecision precision) {
+	const SimdFloat one = simdSet(1.0f);
+	SimdFloat a = simdMin(simdAbs(x), one);
+	SimdFloat negative = simdCmpLt(x, simdZero());
+	SimdFloat r;
+	if (precision == kPrecisionFull) {
+		//cephes acosfasin
+		//|x| > 0.5: acos(|x|) = 2 * asin(sqrt((1 - |x|) / 2))
+		//|x| <= 0.5: acos(x) = pi/2 - asin(x)
+		SimdFloat big = simdCmpGt(a, simdSet(0.5f));
+		SimdFloat z = simdSqrt(simdMul(simdSet(0.5f), simdSub(one, a)));
+		SimdFloat asinBig = simdMul(simdSet(2.0f), simdAsin(z, kPrecisionFull));
+		SimdFloat fromBig = simdSelect(negative, simdSub(simdSet(kSimdPi), asinBig), asinBig);
+		SimdFloat fromSmall = simdSub(simdSet(kSimdPiOver2), simdAsin(x, kPrecisionFull));
+		return simdSelect(big, fromBig, fromSmall);
+	}
+	//acos(|x|) = sqrt(1 - |x|) * P(|x|)
+	SimdFloat p;
+	if (precision == kPrecisionMedium) {
+		p = simdSet(9.7328794171e-3f);
+		p = simdAdd(simdMul(p, a), simdSet(-3.7618062804e-2f));
+		p = simdAdd(simdMul(p, a), simdSet(8.5638297145e-2f));
+		p = simdAdd(simdMul(p, a), simdSet(-2.1428059801e-1f));
+		p = simdAdd(simdMul(p, a), simdSet(1.5707915337f));
+	}
+	else {
+		p = simdSet(5.1389198961e-2f);
+		p = simdAdd(simdMul(p, a), simdSet(-2.0549729861e-1f));
+		p = simdAdd(simdMul(p, a), simdSet(1.5704702426f));
+	}
+	r = simdMul(simdSqrt(simdSub(one, a)), p);
+	//acos(-x) = pi - acos(x)
+	return simdSelect(negative, simdSub(simdSet(kSimdPi), r), r);
+}
+
+inline SimdFloat simdAsin(SimdFloat x, MathPrecision precision) {
+	if (precision != kPrecisionFull) {
+		//asin(x) = pi/2 - acos(x)acosͬ
+		return simdSub(simdSet(kSimdPiOver2), simdAcos(x, precision));
+	}
+	//cephes asinf
+	//|x| > 0.5ʱz = (1 - |x|) / 2asin(|x|) = pi/2 - 2 * asin(sqrt(z))
+	const SimdFloat one = simdSet(1.0f);
+	const SimdFloat half = simdSet(0.5f);
+	SimdFloat signMask = simdSet(-0.0f);
+	SimdFloat sign = simdAnd(x, signMask);
+	SimdFloat a = simdMin(simdAbs(x), one);
+	SimdFloat big = simdCmpGt(a, half);
+	SimdFloat zBig = simdMul(half, simdSub(one, a));
+	SimdFloat z = simdSelect(big, zBig, simdMul(a, a));
+	SimdFloat s = simdSelect(big, simdSqrt(zBig), a);
+	SimdFloat p = simdSet(4.2163199048e-2f);
+	p = simdAdd(simdMul(p, z), simdSet(2.4181311049e-2f));
+	p = simdAdd(simdMul(p, z), simdSet(4.5470025998e-2f));
+	p = simdAdd(simdMul(p, z), simdSet(7.4953002686e-2f));
+	p = simdAdd(simdMul(p, z), simdSet(1.6666752422e-1f));
+	p = simdAdd(simdMul(simdMul(p, z), s), s);
+	p = simdSelect(big, simdSub(simdSet(kSimdPiOver2), simdAdd(p, p)), p);
+	return simdXor(p, sign);
+}
+
+// atan2(y, x)[-pi,pi]
+//  atan(min(|x|,|y|) / max(|x|,|y|))ٰڵİ˷֮һ޻ԭ
+// xyΪʱ
+inline SimdFloat simdAtan2(SimdFloat y, SimdFloat x, MathPrecision precision) {
+	SimdFloat ax = simdAbs(x);
+	SimdFloat ay = simdAbs(y);
+	SimdFloat mx = simdMax(ax, ay);
+	SimdFloat mn = simdMin(ax, ay);
+	SimdFloat zero = simdZero();
+	SimdFloat a = simdSelect(simdCmpGt(mx, zero), simdDiv(mn, mx), zero);
+	SimdFloat a2 = simdMul(a, a);
+	SimdFloat p;
+	switch (precision) {
+	case kPrecisionLow:
+		p = simdSet(7.9338938869e-2f);
+		p = simdAdd(simdMul(p, a2), simdSet(-2.8869015711e-1f));
+		p = simdAdd(simdMul(p, a2), simdSet(9.9535796065e-1f));
+		break;
+	case kPrecisionMedium:
+		p = simdSet(-1.1719137482e-2f);
+		p = simdAdd(simdMul(p, a2), simdSet(5.2647369006e-2f));
+		p = simdAdd(simdMul(p, a2), simdSet(-1.1642651697e-1f));
+		p = simdAdd(simdMul(p, a2), simdSet(1.9354040262e-1f));
+		p = simdAdd(simdMul(p, a2), simdSet(-3.3262283592e-1f));
+		p = simdAdd(simdMul(p, a2), simdSet(9.9997721982e-1f));
+		break;
+	default:
+		p = simdSet(2.4272989331e-3f);
+		p = simdAdd(simdMul(p, a2), simdSet(-1.4275572292e-2f));
+		p = simdAdd(simdMul(p, a2), simdSet(3.9559621435e-2f));
+		p = simdAdd(simdMul(p, a2), simdSet(-7.2141188223e-2f));
+		p = simdAdd(simdMul(p, a2), simdSet(1.0487877070e-1f));
+		p = simdAdd(simdMul(p, a2), simdSet(-1.4157871686e-1f));
+		p = simdAdd(simdMul(p, a2), simdSet(1.9985365419e-1f));
+		p = simdAdd(simdMul(p, a2), simdSet(-3.3332557717e-1f));
+		p = simdAdd(simdMul(p, a2), simdSet(9.9999987802e-1f));
+		break;
+	}
+	SimdFloat r = simdMul(a, p);
+	r = simdSelect(simdCmpGt(ay, ax), simdSub(simdSet(kSimdPiOver2), r), r);
+	r = simdSelect(simdCmpLt(x, zero), simdSub(simdSet(kSimdPi), r), r);
+	return simdXor(r, simdAnd(y, simdSet(-0.0f)));
+}
+
+// ͨʵ2piǶ[-pi,pi]warpPi()ͬ
+inline SimdFloat simdWarpPi(SimdFloat theta) {
+	SimdFloat pi = simdSet(kPi);
+	theta = simdAdd(theta, pi);
+	theta = simdSub(theta, simdMul(simdFloor(simdMul(theta, simdSet(k1Over2Pi))), simdSet(k2Pi)));
+	return simdSub(theta, pi);
+}
+
+#endif // #ifndef __SIMDMATH_H_INCLUDED__
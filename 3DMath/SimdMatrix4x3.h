@@ -0,0 +1,96 @@
+#pragma once
+
+#ifndef __SIMDMATRIX4X3_H_INCLUDED__
+#define __SIMDMATRIX4X3_H_INCLUDED__
+
+#include "Matrix4x3.h"
+#include "SimdUtil.h"
+
+// ƣSIMD
+// ߣcary
+// ڲʹõSoAʽ4X3һδkSimdWidth
+//		˳Matrix4x3ĶӦͬλһ
+
+//SIMDõSoAÿԪռһĴk·Ϊk
+struct SimdMatrix4x3
+{
+	SimdFloat m11, m12, m13;
+	SimdFloat m21, m22, m23;
+	SimdFloat m31, m32, m33;
+	SimdFloat tx, ty, tz;
+};
+
+//Matrix4x312float4һת
+static_assert(sizeof(Matrix4x3) == 12 * sizeof(float), "Matrix4x3 must be twelve packed floats");
+
+//kSimdWidthľ
+inline void simdLoadMatrices(const Matrix4x3* m, SimdMatrix4x3* r) {
+	const float* p = &m->m11;
+	simdLoad4x(p, 12, &r->m11, &r->m12, &r->m13, &r->m21);
+	simdLoad4x(p + 4, 12, &r->m22, &r->m23, &r->m31, &r->m32);
+	simdLoad4x(p + 8, 12, &r->m33, &r->tx, &r->ty, &r->tz);
+}
+
+//дkSimdWidthľ
+inline void simdStoreMatrices(Matrix4x3* m, const SimdMatrix4x3& r) {
+	float* p = &m->m11;
+	simdStore4x(p, 12, r.m11, r.m12, r.m13, r.m21);
+	simdStore4x(p + 4, 12, r.m22, r.m23, r.m31, r.m32);
+	simdStore4x(p + 8, 12, r.m33, r.tx, r.ty, r.tz);
+}
+
+//һ㲥·
+inline void simdSetMatrix(const Matrix4x3& m, SimdMatrix4x3* r) {
+	r->m11 = simdSet(m.m11); r->m12 = simdSet(m.m12); r->m13 = simdSet(m.m13);
+	r->m21 = simdSet(m.m21); r->m22 = simdSet(m.m22); r->m23 = simdSet(m.m23);
+	r->m31 = simdSet(m.m31); r->m32 = simdSet(m.m32); r->m33 = simdSet(m.m33);
+	r->tx = simdSet(m.tx); r->ty = simdSet(m.ty); r->tz = simdSet(m.tz);
+}
+
+//r = a * b˳ operator*(Matrix4x3, Matrix4x3) ͬ
+inline void simdConcatenate(const SimdMatrix4x3& a, const SimdMatrix4x3& b, SimdMatrix4x3* r) {
+	r->m11 = simdAdd(simdAdd(simdMul(a.m11, b.m11), simdMul(a.m12, b.m21)), simdMul(a.m13, b.m31));
+	r->m12 = simdAdd(simdAdd(simdMul(a.m11, b.m12), simdMul(a.m12, b.m22)), simdMul(a.m13, b.m32));
+	r->m13 = simdAdd(simdAdd(simdMul(a.m11, b.m13), simdMul(a.m12, b.m23)), simdMul(a.m13, b.m33));
+
+	r->m21 = simdAdd(simdAdd(simdMul(a.m21, b.m11), simdMul(a.m22, b.m21)), simdMul(a.m23, b.m31));
+	r->m22 = simdAdd(simdAdd(simdMul(a.m21, b.m12), simdMul(a.m22, b.m22)), simdMul(a.m23, b.m32));
+	r->m23 = simdAdd(simdAdd(simdMul(a.m21, b.m13), simdMul(a.m22, b.m23)), simdMul(a.m23, b.m33));
+
+	r->m31 = simdAdd(simdAdd(simdMul(a.m31, b.m11), simdMul(a.m32, b.m21)), simdMul(a.m33, b.m31));
+	r->m32 = simdAdd(simdAdd(simdMul(a.m31, b.m12), simdMul(a.m32, b.m22)), simdMul(a.m33, b.m32));
+	r->m33 = simdAdd(simdAdd(simdMul(a.m31, b.m13), simdMul(a.m32, b.m23)), simdMul(a.m33, b.m33));
+
+	r->tx = simdAdd(simdAdd(simdAdd(simdMul(a.tx, b.m11), simdMul(a.ty, b.m21)), simdMul(a.tz, b.m31)), b.tx);
+	r->ty = simdAdd(simdAdd(simdAdd(simdMul(a.tx, b.m12), simdMul(a.ty, b.m22)), simdMul(a.tz, b.m32)), b.ty);
+	r->tz = simdAdd(simdAdd(simdAdd(simdMul(a.tx, b.m13), simdMul(a.ty, b.m23)), simdMul(a.tz, b.m33)), b.tz);
+}
+
+//ӵλԪת֣˳Matrix4x3::fromQuaternion()ͬ
+inline void simdFromQuaternion(SimdFloat x, SimdFloat y, SimdFloat z, SimdFloat w, SimdMatrix4x3* r) {
+	const SimdFloat one = simdSet(1.0f);
+	const SimdFloat two = simdSet(2.0f);
+	SimdFloat xx = simdMul(simdMul(two, x), x);
+	SimdFloat yy = simdMul(simdMul(two, y), y);
+	SimdFloat zz = simdMul(simdMul(two, z), z);
+	SimdFloat xy = simdMul(simdMul(two, x), y);
+	SimdFloat xz = simdMul(simdMul(two, x), z);
+	SimdFloat yz = simdMul(simdMul(two, y), z);
+	SimdFloat wx = simdMul(simdMul(two, w), x);
+	SimdFloat wy = simdMul(simdMul(two, w), y);
+	SimdFloat wz = simdMul(simdMul(two, w), z);
+
+	r->m11 = simdSub(simdSub(one, yy), zz);
+	r->m12 = simdAdd(xy, wz);
+	r->m13 = simdSub(xz, wy);
+
+	r->m21 = simdSub(xy, wz);
+	r->m22 = simdSub(simdSub(one, xx), zz);
+	r->m23 = simdAdd(yz, wx);
+
+	r->m31 = simdAdd(xz, wy);
+	r->m32 = simdSub(yz, wx);
+	r->m33 = simdSub(simdSub(one, xx), yy);
+}
+
+#endif // #ifndef __SIMDMATRIX4X3_H_INCLUDED__
@@ -0,0 +1,38 @@
+#pragma once
+
+#ifndef __SIMDQUATERNION_H_INCLUDED__
+#define __SIMDQUATERNION_H_INCLUDED__
+
+#include "SimdUtil.h"
+
+// ƣSIMDԪ
+// ߣcary
+// ڲʹõSoAʽԪ㣬ÿռһĴһδkSimdWidthԪ
+//		˳QuaternionĶӦͬλһ
+
+//SoAʽĲˣÿһ·operator*˳ͬ
+inline void simdMultiply(
+	SimdFloat px, SimdFloat py, SimdFloat pz, SimdFloat pw,
+	SimdFloat ax, SimdFloat ay, SimdFloat az, SimdFloat aw,
+	SimdFloat* rx, SimdFloat* ry, SimdFloat* rz, SimdFloat* rw) {
+	*rx = simdSub(simdAdd(simdAdd(simdMul(pw, ax), simdMul(px, aw)), simdMul(pz, ay)), simdMul(py, az));
+	*ry = simdSub(simdAdd(simdAdd(simdMul(pw, ay), simdMul(py, aw)), simdMul(px, az)), simdMul(pz, ax));
+	*rz = simdSub(simdAdd(simdAdd(simdMul(pw, az), simdMul(pz, aw)), simdMul(py, ax)), simdMul(px, ay));
+	*rw = simdSub(simdSub(simdSub(simdMul(pw, aw), simdMul(px, ax)), simdMul(py, ay)), simdMul(pz, az));
+}
+
+//SoAʽתÿһ·rotate(Quaternion, Vector3)˳ͬ
+inline void simdRotate(
+	SimdFloat qx, SimdFloat qy, SimdFloat qz, SimdFloat qw,
+	SimdFloat vx, SimdFloat vy, SimdFloat vz,
+	SimdFloat* rx, SimdFloat* ry, SimdFloat* rz) {
+	const SimdFloat two = simdSet(2.0f);
+	SimdFloat tx = simdMul(two, simdSub(simdMul(qy, vz), simdMul(qz, vy)));
+	SimdFloat ty = simdMul(two, simdSub(simdMul(qz, vx), simdMul(qx, vz)));
+	SimdFloat tz = simdMul(two, simdSub(simdMul(qx, vy), simdMul(qy, vx)));
+	*rx = simdAdd(simdAdd(vx, simdMul(qw, tx)), simdSub(simdMul(qy, tz), simdMul(qz, ty)));
+	*ry = simdAdd(simdAdd(vy, simdMul(qw, ty)), simdSub(simdMul(qz, tx), simdMul(qx, tz)));
+	*rz = simdAdd(simdAdd(vz, simdMul(qw, tz)), simdSub(simdMul(qx, ty), simdMul(qy, tx)));
+}
+
+#endif // #ifndef __SIMDQUATERNION_H_INCLUDED__
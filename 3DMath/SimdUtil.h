@@ -0,0 +1,416 @@
+#pragma once
+
+#ifndef __SIMDUTIL_H_INCLUDED__
+#define __SIMDUTIL_H_INCLUDED__
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ƣSIMD
+// ߣcary
+// װõSIMDָ
+//		ݱѡѡ AVX(8·) / SSE(4·) / (1·) ʵ֣
+//		ֻͨsimdXXXʼĴkSimdWidth
+//		 MATH_SIMD_DISABLE ǿʹñʵ
+
+#if !defined(MATH_SIMD_DISABLE) && defined(__AVX__)
+#define MATH_SIMD_AVX
+#elif !defined(MATH_SIMD_DISABLE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MATH_SIMD_SSE
+#endif
+
+#if defined(MATH_SIMD_AVX)
+#include <immintrin.h>
+#elif defined(MATH_SIMD_SSE)
+#include <emmintrin.h>
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+// ڴ
+/////////////////////////////////////////////////////////////////////////////
+
+// ĶֽAVXҪ
+const size_t kSimdAlignment = 32;
+
+// 䰴kSimdAlignmentڴ棬alignedFreeͷ
+inline void* alignedAlloc(size_t bytes) {
+	//һЩռ䣬ڶַǰ汣ԭʼָ
+	void* raw = malloc(bytes + kSimdAlignment + sizeof(void*));
+	if (raw == NULL) {
+		return NULL;
+	}
+	size_t addr = (size_t)raw + sizeof(void*);
+	addr = (addr + kSimdAlignment - 1) & ~(kSimdAlignment - 1);
+	((void**)addr)[-1] = raw;
+	return (void*)addr;
+}
+
+inline void alignedFree(void* p) {
+	if (p != NULL) {
+		free(((void**)p)[-1]);
+	}
+}
+
+// ԤȡpڵĻУǰȡʵݣʵвκ
+inline void simdPrefetch(const void* p) {
+#if defined(MATH_SIMD_AVX) || defined(MATH_SIMD_SSE)
+	_mm_prefetch((const char*)p, _MM_HINT_T0);
+#else
+	(void)p;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// λģʽ
+/////////////////////////////////////////////////////////////////////////////
+
+// floatλģʽ֮ת
+inline unsigned int simdFloatToBits(float a) {
+	unsigned int r;
+	memcpy(&r, &a, sizeof(r));
+	return r;
+}
+
+inline float simdBitsToFloat(unsigned int a) {
+	float r;
+	memcpy(&r, &a, sizeof(r));
+	return r;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// SIMDĴ
+//
+// SimdFloat ΪһĴȵfloatȽϽҲSimdFloatУ
+// ÿһ·ȫ1ʾ棬ȫ0ʾ
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(MATH_SIMD_AVX)
+
+typedef __m256 SimdFloat;
+const size_t kSimdWidth = 8;
+
+inline SimdFloat simdZero() { return _mm256_setzero_ps(); }
+inline SimdFloat simdSet(float a) { return _mm256_set1_ps(a); }
+inline SimdFloat simdLoad(const float* p) { return _mm256_loadu_ps(p); }
+inline SimdFloat simdLoadAligned(const float* p) { return _mm256_load_ps(p); }
+inline void simdStore(float* p, SimdFloat a) { _mm256_storeu_ps(p, a); }
+inline void simdStoreAligned(float* p, SimdFloat a) { _mm256_store_ps(p, a); }
+
+inline SimdFloat simdAdd(SimdFloat a, SimdFloat b) { return _mm256_add_ps(a, b); }
+inline SimdFloat simdSub(SimdFloat a, SimdFloat b) { return _mm256_sub_ps(a, b); }
+inline SimdFloat simdMul(SimdFloat a, SimdFloat b) { return _mm256_mul_ps(a, b); }
+inline SimdFloat simdDiv(SimdFloat a, SimdFloat b) { return _mm256_div_ps(a, b); }
+inline SimdFloat simdSqrt(SimdFloat a) { return _mm256_sqrt_ps(a); }
+inline SimdFloat simdMin(SimdFloat a, SimdFloat b) { return _mm256_min_ps(a, b); }
+inline SimdFloat simdMax(SimdFloat a, SimdFloat b) { return _mm256_max_ps(a, b); }
+
+inline SimdFloat simdCmpLt(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+inline SimdFloat simdCmpLe(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+inline SimdFloat simdCmpGt(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+inline SimdFloat simdCmpGe(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+inline SimdFloat simdCmpEq(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+inline SimdFloat simdCmpNeq(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+
+inline SimdFloat simdAnd(SimdFloat a, SimdFloat b) { return _mm256_and_ps(a, b); }
+inline SimdFloat simdOr(SimdFloat a, SimdFloat b) { return _mm256_or_ps(a, b); }
+inline SimdFloat simdXor(SimdFloat a, SimdFloat b) { return _mm256_xor_ps(a, b); }
+// (~a) & b
+inline SimdFloat simdAndNot(SimdFloat a, SimdFloat b) { return _mm256_andnot_ps(a, b); }
+// maskΪ·ȡaȡb
+inline SimdFloat simdSelect(SimdFloat mask, SimdFloat a, SimdFloat b) { return _mm256_blendv_ps(b, a, mask); }
+// ÿһ·ķλɵλ
+inline int simdMoveMask(SimdFloat mask) { return _mm256_movemask_ps(mask); }
+// 뵽
+inline SimdFloat simdRound(SimdFloat a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+// ȡ
+inline SimdFloat simdFloor(SimdFloat a) { return _mm256_floor_ps(a); }
+// ȡ0·
+inline float simdFirst(SimdFloat a) { return _mm256_cvtss_f32(a); }
+
+#elif defined(MATH_SIMD_SSE)
+
+typedef __m128 SimdFloat;
+const size_t kSimdWidth = 4;
+
+inline SimdFloat simdZero() { return _mm_setzero_ps(); }
+inline SimdFloat simdSet(float a) { return _mm_set1_ps(a); }
+inline SimdFloat simdLoad(const float* p) { return _mm_loadu_ps(p); }
+inline SimdFloat simdLoadAligned(const float* p) { return _mm_load_ps(p); }
+inline void simdStore(float* p, SimdFloat a) { _mm_storeu_ps(p, a); }
+inline void simdStoreAligned(float* p, SimdFloat a) { _mm_store_ps(p, a); }
+
+inline SimdFloat simdAdd(SimdFloat a, SimdFloat b) { return _mm_add_ps(a, b); }
+inline SimdFloat simdSub(SimdFloat a, SimdFloat b) { return _mm_sub_ps(a, b); }
+inline SimdFloat simdMul(SimdFloat a, SimdFloat b) { return _mm_mul_ps(a, b); }
+inline SimdFloat simdDiv(SimdFloat a, SimdFloat b) { return _mm_div_ps(a, b); }
+inline SimdFloat simdSqrt(SimdFloat a) { return _mm_sqrt_ps(a); }
+inline SimdFloat simdMin(SimdFloat a, SimdFloat b) { return _mm_min_ps(a, b); }
+inline SimdFloat simdMax(SimdFloat a, SimdFloat b) { return _mm_max_ps(a, b); }
+
+inline SimdFloat simdCmpLt(SimdFloat a, SimdFloat b) { return _mm_cmplt_ps(a, b); }
+inline SimdFloat simdCmpLe(SimdFloat a, SimdFloat b) { return _mm_cmple_ps(a, b); }
+inline SimdFloat simdCmpGt(SimdFloat a, SimdFloat b) { return _mm_cmpgt_ps(a, b); }
+inline SimdFloat simdCmpGe(SimdFloat a, SimdFloat b) { return _mm_cmpge_ps(a, b); }
+inline SimdFloat simdCmpEq(SimdFloat a, SimdFloat b) { return _mm_cmpeq_ps(a, b); }
+inline SimdFloat simdCmpNeq(SimdFloat a, SimdFloat b) { return _mm_cmpneq_ps(a, b); }
+
+inline SimdFloat simdAnd(SimdFloat a, SimdFloat b) { return _mm_and_ps(a, b); }
+inline SimdFloat simdOr(SimdFloat a, SimdFloat b) { return _mm_or_ps(a, b); }
+inline SimdFloat simdXor(SimdFloat a, SimdFloat b) { return _mm_xor_ps(a, b); }
+// (~a) & b
+inline SimdFloat simdAndNot(SimdFloat a, SimdFloat b) { return _mm_andnot_ps(a, b); }
+// maskΪ·ȡaȡb
+inline SimdFloat simdSelect(SimdFloat mask, SimdFloat a, SimdFloat b) {
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+// ÿһ·ķλɵλ
+inline int simdMoveMask(SimdFloat mask) { return _mm_movemask_ps(mask); }
+// 뵽SSE2ûָתʵ֣Ҫ|a| < 2^31
+inline SimdFloat simdRound(SimdFloat a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+// ȡҪ|a| < 2^31
+inline SimdFloat simdFloor(SimdFloat a) {
+	SimdFloat r = simdRound(a);
+	return _mm_sub_ps(r, _mm_and_ps(_mm_cmpgt_ps(r, a), _mm_set1_ps(1.0f)));
+}
+// ȡ0·
+inline float simdFirst(SimdFloat a) { return _mm_cvtss_f32(a); }
+
+#else
+
+typedef float SimdFloat;
+const size_t kSimdWidth = 1;
+
+//ʵλģȽ
+inline float simdMaskFromBool(bool b) { return simdBitsToFloat(b ? 0xffffffffu : 0u); }
+
+inline SimdFloat simdZero() { return 0.0f; }
+inline SimdFloat simdSet(float a) { return a; }
+inline SimdFloat simdLoad(const float* p) { return *p; }
+inline SimdFloat simdLoadAligned(const float* p) { return *p; }
+inline void simdStore(float* p, SimdFloat a) { *p = a; }
+inline void simdStoreAligned(float* p, SimdFloat a) { *p = a; }
+
+inline SimdFloat simdAdd(SimdFloat a, SimdFloat b) { return a + b; }
+inline SimdFloat simdSub(SimdFloat a, SimdFloat b) { return a - b; }
+inline SimdFloat simdMul(SimdFloat a, SimdFloat b) { return a * b; }
+inline SimdFloat simdDiv(SimdFloat a, SimdFloat b) { return a / b; }
+inline SimdFloat simdSqrt(SimdFloat a) { return sqrtf(a); }
+// SSEminps/maxpsͬȽʱb
+inline SimdFloat simdMin(SimdFloat a, SimdFloat b) { return a < b ? a : b; }
+inline SimdFloat simdMax(SimdFloat a, SimdFloat b) { return a > b ? a : b; }
+
+inline SimdFloat simdCmpLt(SimdFloat a, SimdFloat b) { return simdMaskFromBool(a < b); }
+inline SimdFloat simdCmpLe(SimdFloat a, SimdFloat b) { return simdMaskFromBool(a <= b); }
+inline SimdFloat simdCmpGt(SimdFloat a, SimdFloat b) { return simdMaskFromBool(a > b); }
+inline SimdFloat simdCmpGe(SimdFloat a, SimdFloat b) { return simdMaskFromBool(a >= b); }
+inline SimdFloat simdCmpEq(SimdFloat a, SimdFloat b) { return simdMaskFromBool(a == b); }
+inline SimdFloat simdCmpNeq(SimdFloat a, SimdFloat b) { return simdMaskFromBool(!(a == b)); }
+
+inline SimdFloat simdAnd(SimdFloat a, SimdFloat b) { return simdBitsToFloat(simdFloatToBits(a) & simdFloatToBits(b)); }
+inline SimdFloat simdOr(SimdFloat a, SimdFloat b) { return simdBitsToFloat(simdFloatToBits(a) | simdFloatToBits(b)); }
+inline SimdFloat simdXor(SimdFloat a, SimdFloat b) { return simdBitsToFloat(simdFloatToBits(a) ^ simdFloatToBits(b)); }
+// (~a) & b
+inline SimdFloat simdAndNot(SimdFloat a, SimdFloat b) { return simdBitsToFloat(~simdFloatToBits(a) & simdFloatToBits(b)); }
+// maskΪ·ȡaȡb
+inline SimdFloat simdSelect(SimdFloat mask, SimdFloat a, SimdFloat b) { return simdFloatToBits(mask) ? a : b; }
+// ÿһ·ķλɵλ
+inline int simdMoveMask(SimdFloat mask) { return (int)(simdFloatToBits(mask) >> 31); }
+// 뵽
+inline SimdFloat simdRound(SimdFloat a) { return floorf(a + 0.5f); }
+// ȡ
+inline SimdFloat simdFloor(SimdFloat a) { return floorf(a); }
+// ȡ0·
+inline float simdFirst(SimdFloat a) { return a; }
+
+#endif
+
+// ·ΪʱsimdMoveMaskķֵ
+const int kSimdAllTrue = (1 << kSimdWidth) - 1;
+
+// ֵ
+inline SimdFloat simdAbs(SimdFloat a) { return simdAndNot(simdSet(-0.0f), a); }
+// ȡ
+inline SimdFloat simdNeg(SimdFloat a) { return simdXor(simdSet(-0.0f), a); }
+
+/////////////////////////////////////////////////////////////////////////////
+// AoS <> SoA ת
+/////////////////////////////////////////////////////////////////////////////
+
+//  x y z x y z ... жȡkSimdWidthԪ飬ΪxyzĴ
+inline void simdLoadXYZ(const float* p, SimdFloat* x, SimdFloat* y, SimdFloat* z) {
+#if defined(MATH_SIMD_AVX)
+	//128λŵ0-3Ԫ飬128λŵ4-7Ԫ飬֮SSEͬ
+	__m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 0)), _mm_loadu_ps(p + 12), 1);
+	__m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+	__m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+	__m256 xy = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+	__m256 yz = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+	*x = _mm256_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+	*y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+	*z = _mm256_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+#elif defined(MATH_SIMD_SSE)
+	// a = x0 y0 z0 x1
+	// b = y1 z1 x2 y2
+	// c = z2 x3 y3 z3
+	__m128 a = _mm_loadu_ps(p + 0);
+	__m128 b = _mm_loadu_ps(p + 4);
+	__m128 c = _mm_loadu_ps(p + 8);
+	// xy = x2 y2 x3 y3
+	__m128 xy = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+	// yz = y0 z0 y1 z1
+	__m128 yz = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+	*x = _mm_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+	*y = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+	*z = _mm_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+#else
+	*x = p[0];
+	*y = p[1];
+	*z = p[2];
+#endif
+}
+
+// simdLoadXYZ㣬xyzдΪkSimdWidthԪ
+inline void simdStoreXYZ(float* p, SimdFloat x, SimdFloat y, SimdFloat z) {
+#if defined(MATH_SIMD_AVX)
+	__m256 xy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+	__m256 yz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+	__m256 zx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+	__m256 a = _mm256_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0));
+	__m256 b = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+	__m256 c = _mm256_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1));
+	_mm_storeu_ps(p + 0, _mm256_castps256_ps128(a));
+	_mm_storeu_ps(p + 4, _mm256_castps256_ps128(b));
+	_mm_storeu_ps(p + 8, _mm256_castps256_ps128(c));
+	_mm_storeu_ps(p + 12, _mm256_extractf128_ps(a, 1));
+	_mm_storeu_ps(p + 16, _mm256_extractf128_ps(b, 1));
+	_mm_storeu_ps(p + 20, _mm256_extractf128_ps(c, 1));
+#elif defined(MATH_SIMD_SSE)
+	// xy = x0 x2 y0 y2
+	__m128 xy = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+	// yz = y1 y3 z1 z3
+	__m128 yz = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+	// zx = z0 z2 x1 x3
+	__m128 zx = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+	_mm_storeu_ps(p + 0, _mm_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0)));
+	_mm_storeu_ps(p + 4, _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0)));
+	_mm_storeu_ps(p + 8, _mm_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1)));
+#else
+	p[0] = x;
+	p[1] = y;
+	p[2] = z;
+#endif
+}
+
+// ȡkSimdWidth顢ÿ4floatstridefloat
+// תúr[j]ĵk·Ϊkĵjfloat
+// ڰMatrix4x3QuaternionAoSṹ4floatһתΪSoA
+inline void simdLoad4x(const float* p, size_t stride, SimdFloat* r0, SimdFloat* r1, SimdFloat* r2, SimdFloat* r3) {
+#if defined(MATH_SIMD_AVX)
+	//128λΪ0-3飬128λΪ4-7飬4x4ת
+	__m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + stride * 4), 1);
+	__m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + stride)), _mm_loadu_ps(p + stride * 5), 1);
+	__m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + stride * 2)), _mm_loadu_ps(p + stride * 6), 1);
+	__m256 d = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + stride * 3)), _mm_loadu_ps(p + stride * 7), 1);
+	__m256 t0 = _mm256_unpacklo_ps(a, b);
+	__m256 t1 = _mm256_unpackhi_ps(a, b);
+	__m256 t2 = _mm256_unpacklo_ps(c, d);
+	__m256 t3 = _mm256_unpackhi_ps(c, d);
+	*r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+	*r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+	*r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+	*r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+#elif defined(MATH_SIMD_SSE)
+	__m128 a = _mm_loadu_ps(p);
+	__m128 b = _mm_loadu_ps(p + stride);
+	__m128 c = _mm_loadu_ps(p + stride * 2);
+	__m128 d = _mm_loadu_ps(p + stride * 3);
+	_MM_TRANSPOSE4_PS(a, b, c, d);
+	*r0 = a;
+	*r1 = b;
+	*r2 = c;
+	*r3 = d;
+#else
+	(void)stride;
+	*r0 = p[0];
+	*r1 = p[1];
+	*r2 = p[2];
+	*r3 = p[3];
+#endif
+}
+
+// simdLoad4x
+inline void simdStore4x(float* p, size_t stride, SimdFloat r0, SimdFloat r1, SimdFloat r2, SimdFloat r3) {
+#if defined(MATH_SIMD_AVX)
+	__m256 t0 = _mm256_unpacklo_ps(r0, r1);
+	__m256 t1 = _mm256_unpackhi_ps(r0, r1);
+	__m256 t2 = _mm256_unpacklo_ps(r2, r3);
+	__m256 t3 = _mm256_unpackhi_ps(r2, r3);
+	__m256 a = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 b = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+	__m256 c = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+	__m256 d = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+	_mm_storeu_ps(p, _mm256_castps256_ps128(a));
+	_mm_storeu_ps(p + stride, _mm256_castps256_ps128(b));
+	_mm_storeu_ps(p + stride * 2, _mm256_castps256_ps128(c));
+	_mm_storeu_ps(p + stride * 3, _mm256_castps256_ps128(d));
+	_mm_storeu_ps(p + stride * 4, _mm256_extractf128_ps(a, 1));
+	_mm_storeu_ps(p + stride * 5, _mm256_extractf128_ps(b, 1));
+	_mm_storeu_ps(p + stride * 6, _mm256_extractf128_ps(c, 1));
+	_mm_storeu_ps(p + stride * 7, _mm256_extractf128_ps(d, 1));
+#elif defined(MATH_SIMD_SSE)
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	_mm_storeu_ps(p, r0);
+	_mm_storeu_ps(p + stride, r1);
+	_mm_storeu_ps(p + stride * 2, r2);
+	_mm_storeu_ps(p + stride * 3, r3);
+#else
+	(void)stride;
+	p[0] = r0;
+	p[1] = r1;
+	p[2] = r2;
+	p[3] = r3;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// ֶ
+//
+// ڽѹݣֶζתΪfloat֮㶼SimdFloatн
+// ֶβ24λתǾȷ
+/////////////////////////////////////////////////////////////////////////////
+
+// ȡkSimdWidthuint32k·Ϊ (p[k] >> shift) & mask
+inline SimdFloat simdLoadBitField(const uint32_t* p, int shift, uint32_t mask) {
+#if defined(MATH_SIMD_AVX)
+	//ûAVX2ʱû256λ㣬ֱSSE2λ
+	const __m128i count = _mm_cvtsi32_si128(shift);
+	const __m128i m = _mm_set1_epi32((int)mask);
+	__m128i lo = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128((const __m128i*)p), count), m);
+	__m128i hi = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128((const __m128i*)(p + 4)), count), m);
+	return _mm256_cvtepi32_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1));
+#elif defined(MATH_SIMD_SSE)
+	__m128i v = _mm_srl_epi32(_mm_loadu_si128((const __m128i*)p), _mm_cvtsi32_si128(shift));
+	return _mm_cvtepi32_ps(_mm_and_si128(v, _mm_set1_epi32((int)mask)));
+#else
+	return (float)((p[0] >> shift) & mask);
+#endif
+}
+
+// ȡkSimdWidthuint16strideԪأk·Ϊ p[k * stride]
+inline SimdFloat simdLoadUint16(const uint16_t* p, size_t stride) {
+#if defined(MATH_SIMD_AVX)
+	return _mm256_cvtepi32_ps(_mm256_setr_epi32(p[0], p[stride], p[stride * 2], p[stride * 3],
+		p[stride * 4], p[stride * 5], p[stride * 6], p[stride * 7]));
+#elif defined(MATH_SIMD_SSE)
+	return _mm_cvtepi32_ps(_mm_setr_epi32(p[0], p[stride], p[stride * 2], p[stride * 3]));
+#else
+	(void)stride;
+	return (float)p[0];
+#endif
+}
+
+#endif // #ifndef __SIMDUTIL_H_INCLUDED__
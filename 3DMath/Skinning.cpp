@@ -0,0 +1,218 @@
+#include <assert.h>
+#include <thread>
+#include <vector>
+
+#include "Skinning.h"
+#include "DualQuaternion.h"
+#include "Matrix4x3.h"
+#include "SimdUtil.h"
+#include "SimdMatrix4x3.h"
+#include "SimdQuaternion.h"
+
+// ƣƤ
+// ߣcary
+// ÿδkSimdWidth㣬ÿӰȰѸĹռתΪSoA
+//		֮Ļϡ򻯺ͱ任SoAģżԪʱķѡ֧
+//		㰴AoSֻתһεڷŵķ֧Ԥʧܣ
+//		kSimdWidthĶ㸴ƵʱУһͬ
+//		㰴kSimdWidthıֶΣÿνһ̣߳εص
+
+//SkinWeightsȨصļfloatΪλ
+const size_t kWeightStride = sizeof(SkinWeights) / sizeof(float);
+static_assert(sizeof(SkinWeights) == 6 * sizeof(float), "SkinWeights must be six packed floats");
+
+//һkSimdWidth
+struct SkinBlock {
+	const SkinWeights* weights;
+	const Vector3* positions;
+	const Vector3* normals;
+	Vector3* outPositions;
+	Vector3* outNormals;
+};
+
+//һ鶥ľɫƤ
+static void skinLinearBlendBlock(const Matrix4x3* palette, const SkinBlock& b) {
+	SimdFloat w[4];
+	simdLoad4x(&b.weights[0].weight[0], kWeightStride, &w[0], &w[1], &w[2], &w[3]);
+
+	//Ԫذ w0 * m0 + w1 * m1 + w2 * m2 + w3 * m3 ˳
+	SimdMatrix4x3 m;
+	for (int k = 0; k < 4; ++k) {
+		Matrix4x3 gathered[kSimdWidth];
+		for (size_t j = 0; j < kSimdWidth; ++j) {
+			gathered[j] = palette[b.weights[j].bone[k]];
+		}
+		SimdMatrix4x3 bone;
+		simdLoadMatrices(gathered, &bone);
+		SimdFloat* acc = &m.m11;
+		const SimdFloat* e = &bone.m11;
+		for (int j = 0; j < 12; ++j) {
+			acc[j] = k == 0 ? simdMul(w[0], e[j]) : simdAdd(acc[j], simdMul(w[k], e[j]));
+		}
+	}
+
+	SimdFloat px, py, pz;
+	simdLoadXYZ(&b.positions[0].x, &px, &py, &pz);
+	simdStoreXYZ(&b.outPositions[0].x,
+		simdAdd(simdAdd(simdAdd(simdMul(px, m.m11), simdMul(py, m.m21)), simdMul(pz, m.m31)), m.tx),
+		simdAdd(simdAdd(simdAdd(simdMul(px, m.m12), simdMul(py, m.m22)), simdMul(pz, m.m32)), m.ty),
+		simdAdd(simdAdd(simdAdd(simdMul(px, m.m13), simdMul(py, m.m23)), simdMul(pz, m.m33)), m.tz));
+	if (b.normals != NULL) {
+		SimdFloat nx, ny, nz;
+		simdLoadXYZ(&b.normals[0].x, &nx, &ny, &nz);
+		simdStoreXYZ(&b.outNormals[0].x,
+			simdAdd(simdAdd(simdMul(nx, m.m11), simdMul(ny, m.m21)), simdMul(nz, m.m31)),
+			simdAdd(simdAdd(simdMul(nx, m.m12), simdMul(ny, m.m22)), simdMul(nz, m.m32)),
+			simdAdd(simdAdd(simdMul(nx, m.m13), simdMul(ny, m.m23)), simdMul(nz, m.m33)));
+	}
+}
+
+//һ鶥ĶżԪƤ˳blend()operator*(Vector3, DualQuaternion)ͬ
+static void skinDualQuaternionBlock(const DualQuaternion* bones, const SkinBlock& b) {
+	SimdFloat w[4];
+	simdLoad4x(&b.weights[0].weight[0], kWeightStride, &w[0], &w[1], &w[2], &w[3]);
+
+	//realdual8
+	SimdFloat q[8], first[8];
+	for (int k = 0; k < 4; ++k) {
+		DualQuaternion gathered[kSimdWidth];
+		for (size_t j = 0; j < kSimdWidth; ++j) {
+			gathered[j] = bones[b.weights[j].bone[k]];
+		}
+		SimdFloat d[8];
+		simdLoad4x(&gathered[0].real.x, 8, &d[0], &d[1], &d[2], &d[3]);
+		simdLoad4x(&gathered[0].dual.x, 8, &d[4], &d[5], &d[6], &d[7]);
+		if (k == 0) {
+			for (int j = 0; j < 8; ++j) {
+				first[j] = d[j];
+				q[j] = simdMul(w[0], d[j]);
+			}
+			continue;
+		}
+		//͵һתΪʱȨȡ˳dotProduct()ͬѡ֧
+		SimdFloat dot = simdAdd(simdAdd(simdAdd(simdMul(d[3], first[3]), simdMul(d[0], first[0])),
+			simdMul(d[1], first[1])), simdMul(d[2], first[2]));
+		SimdFloat wk = simdSelect(simdCmpLt(dot, simdZero()), simdNeg(w[k]), w[k]);
+		for (int j = 0; j < 8; ++j) {
+			q[j] = simdAdd(q[j], simdMul(wk, d[j]));
+		}
+	}
+
+	//
+	SimdFloat magSq = simdAdd(simdAdd(simdAdd(simdMul(q[3], q[3]), simdMul(q[0], q[0])),
+		simdMul(q[1], q[1])), simdMul(q[2], q[2]));
+	SimdFloat oneOverMag = simdDiv(simdSet(1.0f), simdSqrt(magSq));
+	for (int j = 0; j < 8; ++j) {
+		q[j] = simdMul(q[j], oneOverMag);
+	}
+	const SimdFloat rx = q[0], ry = q[1], rz = q[2], rw = q[3];
+	const SimdFloat dx = q[4], dy = q[5], dz = q[6], dw = q[7];
+
+	//ƽƣDualQuaternion::getTranslation()ͬ
+	const SimdFloat two = simdSet(2.0f);
+	SimdFloat tx = simdMul(two, simdAdd(simdSub(simdMul(rw, dx), simdMul(dw, rx)), simdSub(simdMul(ry, dz), simdMul(rz, dy))));
+	SimdFloat ty = simdMul(two, simdAdd(simdSub(simdMul(rw, dy), simdMul(dw, ry)), simdSub(simdMul(rz, dx), simdMul(rx, dz))));
+	SimdFloat tz = simdMul(two, simdAdd(simdSub(simdMul(rw, dz), simdMul(dw, rz)), simdSub(simdMul(rx, dy), simdMul(ry, dx))));
+
+	SimdFloat px, py, pz;
+	simdLoadXYZ(&b.positions[0].x, &px, &py, &pz);
+	simdRotate(rx, ry, rz, rw, px, py, pz, &px, &py, &pz);
+	simdStoreXYZ(&b.outPositions[0].x, simdAdd(px, tx), simdAdd(py, ty), simdAdd(pz, tz));
+	if (b.normals != NULL) {
+		SimdFloat nx, ny, nz;
+		simdLoadXYZ(&b.normals[0].x, &nx, &ny, &nz);
+		simdRotate(rx, ry, rz, rw, nx, ny, nz, &nx, &ny, &nz);
+		simdStoreXYZ(&b.outNormals[0].x, nx, ny, nz);
+	}
+}
+
+//[first, last)еĶskinBlock()firstΪkSimdWidthı
+template <typename SkinBlockFunc>
+static void skinRange(const SkinBlock& all, size_t first, size_t last, SkinBlockFunc skinBlock) {
+	const size_t simdEnd = last - (last - first) % kSimdWidth;
+	size_t i = first;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SkinBlock b = {
+			all.weights + i, all.positions + i, all.normals != NULL ? all.normals + i : NULL,
+			all.outPositions + i, all.outNormals != NULL ? all.outNormals + i : NULL
+		};
+		skinBlock(b);
+	}
+	if (i < last) {
+		//ʣµĶ㸴ƵʱУһ
+		SkinWeights weights[kSimdWidth];
+		Vector3 positions[kSimdWidth], normals[kSimdWidth];
+		Vector3 outPositions[kSimdWidth], outNormals[kSimdWidth];
+		const size_t count = last - i;
+		for (size_t j = 0; j < kSimdWidth; ++j) {
+			size_t src = i + (j < count ? j : count - 1);
+			weights[j] = all.weights[src];
+			positions[j] = all.positions[src];
+			if (all.normals != NULL) {
+				normals[j] = all.normals[src];
+			}
+		}
+		SkinBlock b = { weights, positions, all.normals != NULL ? normals : NULL, outPositions, outNormals };
+		skinBlock(b);
+		for (size_t j = 0; j < count; ++j) {
+			all.outPositions[i + j] = outPositions[j];
+			if (all.normals != NULL) {
+				all.outNormals[i + j] = outNormals[j];
+			}
+		}
+	}
+}
+
+//[0, n)kSimdWidthıֳɼΣÿkMinSkinVerticesPerThread㣬
+//һڵǰ̴߳ĸһ߳
+template <typename SkinBlockFunc>
+static void skinParallel(const SkinBlock& all, size_t n, unsigned threadCount, SkinBlockFunc skinBlock) {
+	assert((all.normals == NULL) == (all.outNormals == NULL));
+	if (threadCount == 0) {
+		threadCount = std::thread::hardware_concurrency();
+		if (threadCount == 0) {
+			threadCount = 1;
+		}
+	}
+	size_t maxThreads = n / kMinSkinVerticesPerThread;
+	size_t segmentCount = threadCount < maxThreads ? threadCount : maxThreads;
+	if (segmentCount <= 1) {
+		skinRange(all, 0, n, skinBlock);
+		return;
+	}
+	size_t segment = (n + segmentCount - 1) / segmentCount;
+	segment = (segment + kSimdWidth - 1) / kSimdWidth * kSimdWidth;
+
+	std::vector<std::thread> workers;
+	workers.reserve(segmentCount - 1);
+	for (size_t first = segment; first < n; first += segment) {
+		size_t last = first + segment < n ? first + segment : n;
+		workers.push_back(std::thread([&all, first, last, skinBlock]() {
+			skinRange(all, first, last, skinBlock);
+		}));
+	}
+	skinRange(all, 0, segment, skinBlock);
+	for (size_t t = 0; t < workers.size(); ++t) {
+		workers[t].join();
+	}
+}
+
+//ɫƤ
+void skinLinearBlend(const Matrix4x3* palette, const SkinWeights* weights,
+	const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals,
+	size_t n, unsigned threadCount) {
+	SkinBlock all = { weights, positions, normals, outPositions, outNormals };
+	skinParallel(all, n, threadCount, [palette](const SkinBlock& b) {
+		skinLinearBlendBlock(palette, b);
+	});
+}
+
+//żԪƤ
+void skinDualQuaternion(const DualQuaternion* bones, const SkinWeights* weights,
+	const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals,
+	size_t n, unsigned threadCount) {
+	SkinBlock all = { weights, positions, normals, outPositions, outNormals };
+	skinParallel(all, n, threadCount, [bones](const SkinBlock& b) {
+		skinDualQuaternionBlock(bones, b);
+	});
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#ifndef __SKINNING_H_INCLUDED__
+#define __SKINNING_H_INCLUDED__
+
+#include <stddef.h>
+#include <stdint.h>
+
+template <typename T> class Vector3T;
+typedef Vector3T<float> Vector3;
+template <typename T> class Matrix4x3T;
+typedef Matrix4x3T<float> Matrix4x3;
+class DualQuaternion;
+
+// ƣƤ
+// ߣcary
+// ÿ4ӰƤÿδkSimdWidth48㣬
+//		ֳɼν̴߳
+//		ɫ壨ԻϣLBSľȨӺ任㣬
+//			ÿ48ֽڣؽʱ
+//		żԪDLBĶżԪȨӡ򻯺任㣬
+//			ÿ32ֽڣǸ任ûǲ֧
+//		ֻתԲ֣û
+
+//ÿĹӰ죬õӰȨΪ0±ҪЧȡ0
+//ȨصĺӦΪ1
+struct SkinWeights {
+	uint16_t bone[4];
+	float weight[4];
+};
+
+//ڸֵʱٷ̵ָ̣߳߳۱Ƥ
+const size_t kMinSkinVerticesPerThread = 4096;
+
+//Ƥn
+//positions, outPositions λãnԪ
+//normals, outNormals ѡΪNULLʱ
+//threadCount ʹõ߳0ʾʹȫӲ߳
+//Ժͬһ
+
+//ɫƤpalette[b] ΪbƤ * ľֲ
+//ÿľ w0 * m0 + w1 * m1 + w2 * m2 + w3 * m3 ˳Ԫ
+void skinLinearBlend(const Matrix4x3* palette, const SkinWeights* weights,
+	const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals,
+	size_t n, unsigned threadCount = 0);
+
+//żԪƤbones[b] ΪbƤ任ӦΪλżԪ
+//ÿĽ positions[i] * blend(, Ȩ, 4) λһ
+void skinDualQuaternion(const DualQuaternion* bones, const SkinWeights* weights,
+	const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals,
+	size_t n, unsigned threadCount = 0);
+
+#endif // #ifndef __SKINNING_H_INCLUDED__
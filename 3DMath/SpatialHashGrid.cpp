@@ -0,0 +1,345 @@
+#include <assert.h>
+#include <math.h>
+
+#include "SpatialHashGrid.h"
+
+// ƣռϣ
+// ߣcary
+// ÿԪ񱣴Ǽе飬ͬʱ¼ÿԪеλã
+//		ɾʱһԪƵճλã±ƶ¼λãO(1)
+//
+//		ԪÿѰַĹϣңɾʱѺͬһ̽еԪǰƣҪɾ
+//
+//		ԪΪ floor( / ߳)ǵģ
+//		߽ӴAABBһͬĵԪ񣬺intersectAABBs()ѽӴཻһ
+
+//ԪķΧɹϣʱÿһάռ21λ
+const int kMaxCellCoord = 1 << 20;
+//ϣСС
+const size_t kMinCellTableSize = 64;
+
+SpatialHashGrid::SpatialHashGrid(float cellSize)
+	: cellSize(cellSize), oneOverCellSize(1.0f / cellSize), entryCount(0), usedCellCount(0), cellTableShift(64)
+{
+	assert(cellSize > 0.0f);
+	resizeCellTable(kMinCellTableSize);
+}
+
+//ı䵥Ԫ߳ȫµǼ
+void SpatialHashGrid::setCellSize(float newCellSize)
+{
+	assert(newCellSize > 0.0f);
+	cellSize = newCellSize;
+	oneOverCellSize = 1.0f / newCellSize;
+	cells.clear();
+	freeCells.clear();
+	usedCellCount = 0;
+	resizeCellTable(kMinCellTableSize);
+	for (size_t i = 0; i < entries.size(); ++i) {
+		entries[i].occupancies.clear();
+		if (entries[i].active) {
+			insertEntry((int)i);
+		}
+	}
+}
+
+//AABBؾ
+int SpatialHashGrid::add(const AABB3& box)
+{
+	assert(!box.isEmpty());
+	int handle;
+	if (!freeHandles.empty()) {
+		handle = freeHandles.back();
+		freeHandles.pop_back();
+	}
+	else {
+		handle = (int)entries.size();
+		entries.resize(entries.size() + 1);
+	}
+	Entry& entry = entries[handle];
+	entry.box = box;
+	entry.active = true;
+	insertEntry(handle);
+	++entryCount;
+	return handle;
+}
+
+//ӵ㣬minmaxͬAABB
+int SpatialHashGrid::add(const Vector3& p)
+{
+	AABB3 box;
+	box.min = box.max = p;
+	return add(box);
+}
+
+//ɾ
+void SpatialHashGrid::remove(int handle)
+{
+	assert(handle >= 0 && handle < (int)entries.size());
+	assert(entries[handle].active);
+	removeEntry(handle);
+	entries[handle].active = false;
+	freeHandles.push_back(handle);
+	--entryCount;
+}
+
+//ƶ壬ԭĵԪʱֻAABB
+void SpatialHashGrid::update(int handle, const AABB3& box)
+{
+	assert(handle >= 0 && handle < (int)entries.size());
+	assert(entries[handle].active);
+	assert(!box.isEmpty());
+	Entry& entry = entries[handle];
+	CellRange range = cellRange(box);
+	entry.box = box;
+	bool sameCells = true;
+	for (int k = 0; k < 3; ++k) {
+		sameCells = sameCells && range.min[k] == entry.range.min[k] && range.max[k] == entry.range.max[k];
+	}
+	if (!sameCells) {
+		removeEntry(handle);
+		insertEntry(handle);
+	}
+}
+
+//ƶ
+void SpatialHashGrid::update(int handle, const Vector3& p)
+{
+	AABB3 box;
+	box.min = box.max = p;
+	update(handle, box);
+}
+
+//Ұp
+void SpatialHashGrid::queryPoint(const Vector3& p, std::vector<int>* result) const
+{
+	AABB3 bounds;
+	bounds.min = bounds.max = p;
+	query(bounds, [&](const AABB3& box) { return box.contains(p); }, result);
+}
+
+//Һཻ
+void SpatialHashGrid::querySphere(const Vector3& center, float radius, std::vector<int>* result) const
+{
+	AABB3 bounds;
+	bounds.min = center - Vector3(radius, radius, radius);
+	bounds.max = center + Vector3(radius, radius, radius);
+	query(bounds, [&](const AABB3& box) { return box.intersectsSphere(center, radius); }, result);
+}
+
+//Һboxཻ
+void SpatialHashGrid::queryAABB(const AABB3& box, std::vector<int>* result) const
+{
+	query(box, [&](const AABB3& other) { return intersectAABBs(box, other); }, result);
+}
+
+//AABBǵĵԪΧ
+SpatialHashGrid::CellRange SpatialHashGrid::cellRange(const AABB3& box) const
+{
+	const float* boxMin = &box.min.x;
+	const float* boxMax = &box.max.x;
+	CellRange range;
+	for (int k = 0; k < 3; ++k) {
+		float lo = floorf(boxMin[k] * oneOverCellSize);
+		float hi = floorf(boxMax[k] * oneOverCellSize);
+		assert(lo >= -kMaxCellCoord && hi < kMaxCellCoord);
+		range.min[k] = (int)lo;
+		range.max[k] = (int)hi;
+	}
+	return range;
+}
+
+//Ԫɹϣ
+uint64_t SpatialHashGrid::cellKey(int x, int y, int z)
+{
+	const uint64_t mask = (1u << 21) - 1;
+	return ((uint64_t)(x + kMaxCellCoord) & mask)
+		| (((uint64_t)(y + kMaxCellCoord) & mask) << 21)
+		| (((uint64_t)(z + kMaxCellCoord) & mask) << 42);
+}
+
+//ڹϣеʼλãԻƽָȡλ
+size_t SpatialHashGrid::hashSlot(uint64_t key) const
+{
+	return (size_t)((key * 0x9E3779B97F4A7C15ull) >> cellTableShift);
+}
+
+//ҵԪ񣬲ʱ-1
+int SpatialHashGrid::findCell(uint64_t key) const
+{
+	const size_t mask = cellTable.size() - 1;
+	for (size_t slot = hashSlot(key);; slot = (slot + 1) & mask) {
+		int cellIndex = cellTable[slot];
+		if (cellIndex < 0 || cells[cellIndex].key == key) {
+			return cellIndex;
+		}
+	}
+}
+
+//cells[cellIndex]ϣļѾڱ
+void SpatialHashGrid::insertCell(int cellIndex)
+{
+	if ((usedCellCount + 1) * 2 > cellTable.size()) {
+		resizeCellTable(cellTable.size() * 2);
+	}
+	const size_t mask = cellTable.size() - 1;
+	size_t slot = hashSlot(cells[cellIndex].key);
+	while (cellTable[slot] >= 0) {
+		slot = (slot + 1) & mask;
+	}
+	cellTable[slot] = cellIndex;
+	++usedCellCount;
+}
+
+//ӹϣɾԪ
+//ճλ֮ͬһ̽ʼλò(λ, ǰλ]֮ԪǰƵλ
+void SpatialHashGrid::eraseCell(uint64_t key)
+{
+	const size_t mask = cellTable.size() - 1;
+	size_t hole = hashSlot(key);
+	while (cells[cellTable[hole]].key != key) {
+		hole = (hole + 1) & mask;
+	}
+	for (size_t slot = (hole + 1) & mask; cellTable[slot] >= 0; slot = (slot + 1) & mask) {
+		size_t home = hashSlot(cells[cellTable[slot]].key);
+		//ʼλõǰλõľ벻СڿλǰλõľʱƵλ
+		if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+			cellTable[hole] = cellTable[slot];
+			hole = slot;
+		}
+	}
+	cellTable[hole] = -1;
+	--usedCellCount;
+}
+
+//ıϣĴСsizeΪ2ݣ²ȫԪ
+void SpatialHashGrid::resizeCellTable(size_t size)
+{
+	cellTable.assign(size, -1);
+	cellTableShift = 64;
+	for (size_t s = size; s > 1; s >>= 1) {
+		--cellTableShift;
+	}
+	const size_t mask = size - 1;
+	for (size_t c = 0; c < cells.size(); ++c) {
+		if (cells[c].items.empty()) {
+			continue;
+		}
+		size_t slot = hashSlot(cells[c].key);
+		while (cellTable[slot] >= 0) {
+			slot = (slot + 1) & mask;
+		}
+		cellTable[slot] = (int)c;
+	}
+}
+
+//ǼǵAABBǵеԪ
+void SpatialHashGrid::insertEntry(int handle)
+{
+	Entry& entry = entries[handle];
+	entry.range = cellRange(entry.box);
+	const CellRange& range = entry.range;
+	for (int z = range.min[2]; z <= range.max[2]; ++z) {
+		for (int y = range.min[1]; y <= range.max[1]; ++y) {
+			for (int x = range.min[0]; x <= range.max[0]; ++x) {
+				uint64_t key = cellKey(x, y, z);
+				int cellIndex = findCell(key);
+				if (cellIndex < 0) {
+					if (!freeCells.empty()) {
+						cellIndex = freeCells.back();
+						freeCells.pop_back();
+					}
+					else {
+						cellIndex = (int)cells.size();
+						cells.resize(cells.size() + 1);
+					}
+					Cell& cell = cells[cellIndex];
+					cell.key = key;
+					cell.coord[0] = x;
+					cell.coord[1] = y;
+					cell.coord[2] = z;
+					insertCell(cellIndex);
+				}
+				std::vector<Item>& items = cells[cellIndex].items;
+				Item item = { handle, (int)entry.occupancies.size() };
+				Occupancy occupancy = { cellIndex, (int)items.size() };
+				items.push_back(item);
+				entry.occupancies.push_back(occupancy);
+			}
+		}
+	}
+}
+
+//ӵǼǹеԪɾ
+void SpatialHashGrid::removeEntry(int handle)
+{
+	Entry& entry = entries[handle];
+	for (size_t i = 0; i < entry.occupancies.size(); ++i) {
+		const Occupancy& occupancy = entry.occupancies[i];
+		Cell& cell = cells[occupancy.cell];
+		//һԪƵճλ
+		Item last = cell.items.back();
+		cell.items[occupancy.position] = last;
+		entries[last.handle].occupancies[last.slot].position = occupancy.position;
+		cell.items.pop_back();
+		if (cell.items.empty()) {
+			eraseCell(cell.key);
+			freeCells.push_back(occupancy.cell);
+		}
+	}
+	entry.occupancies.clear();
+}
+
+//ҳboundsǵĵԪ񣬶еtest()
+//ֻboundsͬǵĵһԪÿһάСвԣûظ
+//boundsǵĵԪȷǿյĵԪ񻹶ʱΪзǿյĵԪ
+template <typename Test>
+void SpatialHashGrid::query(const AABB3& bounds, Test test, std::vector<int>* result) const
+{
+	const CellRange range = cellRange(bounds);
+	double rangeCellCount = 1.0;
+	for (int k = 0; k < 3; ++k) {
+		rangeCellCount *= (double)range.max[k] - range.min[k] + 1.0;
+	}
+
+	//һԪе
+	auto testCell = [&](const Cell& cell) {
+		for (size_t i = 0; i < cell.items.size(); ++i) {
+			int handle = cell.items[i].handle;
+			const Entry& entry = entries[handle];
+			bool first = true;
+			for (int k = 0; k < 3; ++k) {
+				int firstCoord = entry.range.min[k] > range.min[k] ? entry.range.min[k] : range.min[k];
+				first = first && cell.coord[k] == firstCoord;
+			}
+			if (first && test(entry.box)) {
+				result->push_back(handle);
+			}
+		}
+	};
+
+	if (rangeCellCount <= (double)usedCellCount) {
+		for (int z = range.min[2]; z <= range.max[2]; ++z) {
+			for (int y = range.min[1]; y <= range.max[1]; ++y) {
+				for (int x = range.min[0]; x <= range.max[0]; ++x) {
+					int cellIndex = findCell(cellKey(x, y, z));
+					if (cellIndex >= 0) {
+						testCell(cells[cellIndex]);
+					}
+				}
+			}
+		}
+	}
+	else {
+		for (size_t c = 0; c < cells.size(); ++c) {
+			const Cell& cell = cells[c];
+			bool inside = !cell.items.empty();
+			for (int k = 0; k < 3; ++k) {
+				inside = inside && cell.coord[k] >= range.min[k] && cell.coord[k] <= range.max[k];
+			}
+			if (inside) {
+				testCell(cell);
+			}
+		}
+	}
+}
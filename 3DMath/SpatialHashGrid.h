@@ -0,0 +1,121 @@
+#pragma once
+
+#ifndef __SPATIALHASHGRID_H_INCLUDED__
+#define __SPATIALHASHGRID_H_INCLUDED__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "AABB3.h"
+
+// ƣռϣ
+// ߣcary
+// ѿռ仮ֳɱ߳ͬ嵥ԪÿǼAABBǵеԪУ
+//		ֻзǿյĵԪŻ䣬ùϣԪңԿռûб߽
+//		ĴС͵ԪʱӡɾƶO(1)ģƶû뿪ԭĵԪʱֻAABB
+//		ֲȽϾʱṹµĴСö
+//
+//		Ԫ߳һȡĵʹС
+//		̫СʱһҪǼںܶ൥ԪУ̫ʱÿԪе̫
+//
+//		ѯصĽǾȷģҳѯΧǵĵԪAABB3ĺе
+//		һֻͲѯΧͬǵĵһԪбԣԽûظ
+
+class SpatialHashGrid
+{
+public:
+	//cellSize Ԫ߳
+	explicit SpatialHashGrid(float cellSize = 1.0f);
+
+	//ı䵥Ԫ߳ȫµǼ
+	void setCellSize(float cellSize);
+	float getCellSize() const { return cellSize; }
+
+	//AABBߵ㣬ؾɾľᱻظʹ
+	//AABBΪգ޵ֵÿһάĵԪ겻ܳ2^20
+	int add(const AABB3& box);
+	int add(const Vector3& p);
+	void remove(int handle);
+	//ƶ壬ԭĵԪʱֻAABB
+	void update(int handle, const AABB3& box);
+	void update(int handle, const Vector3& p);
+
+	const AABB3& getBox(int handle) const { return entries[handle].box; }
+	//
+	size_t size() const { return entryCount; }
+	//ǿյĵԪ
+	size_t cellCount() const { return usedCellCount; }
+
+	//ҰpAABB3::contains()壬׷ӵresultĩβ
+	void queryPoint(const Vector3& p, std::vector<int>* result) const;
+	//ҺཻAABB3::intersectsSphere()壬׷ӵresultĩβ
+	void querySphere(const Vector3& center, float radius, std::vector<int>* result) const;
+	//ҺboxཻintersectAABBs()壬׷ӵresultĩβ
+	void queryAABB(const AABB3& box, std::vector<int>* result) const;
+
+private:
+	//ԪķΧ
+	struct CellRange {
+		int min[3];
+		int max[3];
+	};
+
+	//һԪеĵǼ
+	struct Occupancy {
+		//Ԫcellsе±
+		int cell;
+		//ڸõԪitemsе±
+		int position;
+	};
+
+	struct Entry {
+		AABB3 box;
+		CellRange range;
+		//ǼǹĵԪ񣬺rangeеĵԪһһӦ
+		std::vector<Occupancy> occupancies;
+		bool active;
+	};
+
+	//Ԫеһ
+	struct Item {
+		int handle;
+		//õԪoccupanciesе±
+		int slot;
+	};
+
+	struct Cell {
+		uint64_t key;
+		int coord[3];
+		std::vector<Item> items;
+	};
+
+	float cellSize;
+	float oneOverCellSize;
+
+	std::vector<Entry> entries;
+	std::vector<int> freeHandles;
+	size_t entryCount;
+
+	//ԪأյĵԪŻfreeCellsitems
+	std::vector<Cell> cells;
+	std::vector<int> freeCells;
+	size_t usedCellCount;
+	//Ԫꡪ>cellsе±ĹϣѰַ̽⣬λΪ-1
+	//СΪ2ݣװʲ1/2
+	std::vector<int> cellTable;
+	int cellTableShift;
+
+	CellRange cellRange(const AABB3& box) const;
+	static uint64_t cellKey(int x, int y, int z);
+	size_t hashSlot(uint64_t key) const;
+	int findCell(uint64_t key) const;
+	void insertCell(int cellIndex);
+	void eraseCell(uint64_t key);
+	void resizeCellTable(size_t size);
+	void insertEntry(int handle);
+	void removeEntry(int handle);
+	template <typename Test>
+	void query(const AABB3& bounds, Test test, std::vector<int>* result) const;
+};
+
+#endif // #ifndef __SPATIALHASHGRID_H_INCLUDED__
@@ -0,0 +1,515 @@
+#include <assert.h>
+#include <math.h>
+#include <algorithm>
+
+#include "SweepAndPrune.h"
+#include "Vector3.h"
+#include "SimdUtil.h"
+
+// ƣɨͼ
+// ߣcary
+// ɨͼsweep and pruneײ
+//
+//		˵˳Ȱֵֵͬʱmin˵max˵֮ǰ
+//		AABBһصҽԵmin˵㶼ڶԷmax˵֮ǰ
+//		intersectAABBs()ѱ߽ӴҲཻһµ
+//
+//		ģʽУصǺͶ˵е˳һ£
+//		ֻһAABBmin˵һAABBmax˵㽻λʱϵص״̬Żı䣺
+//			max˵Ƶmin˵֮ǰʼصҲصʱص
+//			min˵Ƶmax˵֮ǰصҲصʱǰصԣɾص
+//		ǷصȽ϶˵бAABBϵķΧEndpoint::otherMin/otherMax
+//		ǺĶ˵е걣һ£ƶAABBƶ˵㣬
+//		ƶk֮ǰֻǰѾƶдkĶ˵㣬ȫƶ֮ٸж˵
+//
+//		һAABB˵ʱֻʶ˵飬ProxyҲ¶˵±꣬
+//		ƶAABBûڴ
+//		endpointIndexֻ¼һ֪±꣬ƶAABBʱ￪ʼ߲ң
+//		ϴƶ˵ԽٴξҪҶԶֲʱһܽ
+//
+//		ӵAABBźٺԭĶ˵ϲȻɨһҳйصص
+//		ɾAABBѹ˵ʱһȥ
+//
+//		ÿĶ˵˸һΪڱƶ˵ʱҪ±Խ
+
+static inline bool isMaxEndpoint(int data) {
+	return (data & 1) != 0;
+}
+
+//˵˳򣬼ļͷ˵
+static inline bool endpointLess(float aValue, int aData, float bValue, int bData) {
+	return aValue < bValue || (aValue == bValue && !isMaxEndpoint(aData) && isMaxEndpoint(bData));
+}
+
+//˵endpointIndexеλãAABB * 6 +  * 2 + (ǷΪmax˵)
+static inline size_t endpointSlot(int data, int axis) {
+	return (size_t)(data >> 1) * 6 + axis * 2 + (data & 1);
+}
+
+static inline uint64_t pairKey(int a, int b) {
+	if (a > b) {
+		std::swap(a, b);
+	}
+	return ((uint64_t)(uint32_t)a << 32) | (uint32_t)b;
+}
+
+static inline SweepAndPrune::Pair pairFromKey(uint64_t key) {
+	SweepAndPrune::Pair pair;
+	pair.a = (int)(key >> 32);
+	pair.b = (int)(key & 0xffffffff);
+	return pair;
+}
+
+static inline float axisValue(const Vector3& v, int axis) {
+	return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+SweepAndPrune::SweepAndPrune(Mode mode, int sortAxis) :
+	mode(mode), proxyCount(0), multiAxisPairCount(0)
+{
+	assert(sortAxis >= 0 && sortAxis < 3);
+	if (mode == kMultiAxis) {
+		axisCount = 3;
+		axisOf[0] = 0;
+		axisOf[1] = 1;
+		axisOf[2] = 2;
+	}
+	else {
+		axisCount = 1;
+		axisOf[0] = sortAxis;
+	}
+	for (int axis = 0; axis < axisCount; ++axis) {
+		//ڱ˵㽻ķΧõ
+		Endpoint lower = { -HUGE_VALF, -1, { 0.0f, 0.0f }, { 0.0f, 0.0f } };
+		Endpoint upper = { HUGE_VALF, -1, { 0.0f, 0.0f }, { 0.0f, 0.0f } };
+		endpoints[axis].push_back(lower);
+		endpoints[axis].push_back(upper);
+	}
+}
+
+int SweepAndPrune::add(const AABB3& box)
+{
+	assert(!box.isEmpty());
+	int handle;
+	if (freeHandles.empty()) {
+		handle = (int)proxies.size();
+		proxies.push_back(Proxy());
+		endpointIndex.resize(proxies.size() * 6);
+		if (mode == kMultiAxis) {
+			proxyPairs.resize(proxies.size());
+		}
+	}
+	else {
+		handle = freeHandles.back();
+		freeHandles.pop_back();
+	}
+	Proxy& proxy = proxies[handle];
+	proxy.box = box;
+	proxy.state = kAdded;
+	proxy.moved = false;
+	added.push_back(handle);
+	++proxyCount;
+	return handle;
+}
+
+void SweepAndPrune::remove(int handle)
+{
+	Proxy& proxy = proxies[handle];
+	assert(proxy.state == kActive || proxy.state == kAdded);
+	if (proxy.state == kAdded) {
+		//ûв룬ֱӻ
+		added.erase(std::find(added.begin(), added.end(), handle));
+		proxy.state = kFree;
+		freeHandles.push_back(handle);
+	}
+	else {
+		proxy.state = kRemoved;
+		removed.push_back(handle);
+	}
+	--proxyCount;
+}
+
+void SweepAndPrune::update(int handle, const AABB3& box)
+{
+	assert(!box.isEmpty());
+	Proxy& proxy = proxies[handle];
+	assert(proxy.state == kActive || proxy.state == kAdded);
+	proxy.box = box;
+	if (proxy.state == kActive && !proxy.moved) {
+		proxy.moved = true;
+		moved.push_back(handle);
+	}
+}
+
+void SweepAndPrune::updatePairs(std::vector<Pair>* addedPairs, std::vector<Pair>* removedPairs)
+{
+	if (!removed.empty()) {
+		removeProxies();
+	}
+	for (size_t i = 0; i < moved.size(); ++i) {
+		//ƶAABBеλģǰԤȡAABB
+		//ȡi + 4ProxyͶ˵±꣬±굽֮ȡi + 2ڸϵĶ˵
+		if (i + 4 < moved.size()) {
+			simdPrefetch(&proxies[moved[i + 4]]);
+			simdPrefetch(endpointIndex.data() + (size_t)moved[i + 4] * 6);
+		}
+		if (i + 2 < moved.size() && proxies[moved[i + 2]].state == kActive) {
+			const int* index = endpointIndex.data() + (size_t)moved[i + 2] * 6;
+			for (int axis = 0; axis < axisCount; ++axis) {
+				simdPrefetch(endpoints[axis].data() + index[axis * 2]);
+				simdPrefetch(endpoints[axis].data() + index[axis * 2 + 1]);
+			}
+		}
+		if (proxies[moved[i]].state == kActive) {
+			moveProxy(moved[i]);
+		}
+		proxies[moved[i]].moved = false;
+	}
+	moved.clear();
+	if (!added.empty()) {
+		insertProxies();
+	}
+
+	if (mode == kMultiAxis) {
+		for (std::unordered_map<uint64_t, int>::const_iterator it = pairChanges.begin(); it != pairChanges.end(); ++it) {
+			if (it->second > 0 && addedPairs != NULL) {
+				addedPairs->push_back(pairFromKey(it->first));
+			}
+			else if (it->second < 0 && removedPairs != NULL) {
+				removedPairs->push_back(pairFromKey(it->first));
+			}
+		}
+		pairChanges.clear();
+	}
+	else {
+		//ģʽɨ裬һεĽȽ
+		std::vector<uint64_t> pairs;
+		sweep(&pairs, false);
+		std::sort(pairs.begin(), pairs.end());
+		size_t i = 0, j = 0;
+		while (i < pairs.size() || j < sortedPairs.size()) {
+			if (j == sortedPairs.size() || (i < pairs.size() && pairs[i] < sortedPairs[j])) {
+				if (addedPairs != NULL) {
+					addedPairs->push_back(pairFromKey(pairs[i]));
+				}
+				++i;
+			}
+			else if (i == pairs.size() || sortedPairs[j] < pairs[i]) {
+				if (removedPairs != NULL) {
+					removedPairs->push_back(pairFromKey(sortedPairs[j]));
+				}
+				++j;
+			}
+			else {
+				++i;
+				++j;
+			}
+		}
+		sortedPairs.swap(pairs);
+	}
+
+	//صԶѾ棬ɾľظʹ
+	for (size_t i = 0; i < removed.size(); ++i) {
+		proxies[removed[i]].state = kFree;
+		freeHandles.push_back(removed[i]);
+	}
+	removed.clear();
+}
+
+void SweepAndPrune::getPairs(std::vector<Pair>* pairs) const
+{
+	if (mode == kMultiAxis) {
+		for (size_t a = 0; a < proxyPairs.size(); ++a) {
+			const std::vector<int>& list = proxyPairs[a];
+			for (size_t j = 0; j < list.size(); ++j) {
+				if ((int)a < list[j]) {
+					pairs->push_back(pairFromKey(pairKey((int)a, list[j])));
+				}
+			}
+		}
+	}
+	else {
+		for (size_t i = 0; i < sortedPairs.size(); ++i) {
+			pairs->push_back(pairFromKey(sortedPairs[i]));
+		}
+	}
+}
+
+size_t SweepAndPrune::pairCount() const
+{
+	return mode == kMultiAxis ? multiAxisPairCount : sortedPairs.size();
+}
+
+//ӵAABBĶ˵ź֮ԭĶ˵ϲ
+//ģʽɨһ飬ҳӵAABBص
+void SweepAndPrune::insertProxies()
+{
+	std::vector<Endpoint> newPoints(added.size() * 2);
+	std::vector<Endpoint> merged;
+	for (int axis = 0; axis < axisCount; ++axis) {
+		int k = axisOf[axis];
+		for (size_t i = 0; i < added.size(); ++i) {
+			const AABB3& box = proxies[added[i]].box;
+			newPoints[i * 2].value = axisValue(box.min, k);
+			newPoints[i * 2].data = added[i] * 2;
+			newPoints[i * 2 + 1].value = axisValue(box.max, k);
+			newPoints[i * 2 + 1].data = added[i] * 2 + 1;
+			if (mode == kMultiAxis) {
+				setOtherAxes(newPoints[i * 2], box, axis, 3);
+				setOtherAxes(newPoints[i * 2 + 1], box, axis, 3);
+			}
+		}
+		std::sort(newPoints.begin(), newPoints.end(), [](const Endpoint& a, const Endpoint& b) {
+			return endpointLess(a.value, a.data, b.value, b.data);
+		});
+
+		//ϲ鶼ڱ
+		std::vector<Endpoint>& e = endpoints[axis];
+		merged.resize(e.size() + newPoints.size());
+		merged[0] = e[0];
+		size_t i = 1, j = 0, count = 1;
+		while (i + 1 < e.size() || j < newPoints.size()) {
+			if (j == newPoints.size() || (i + 1 < e.size() &&
+				!endpointLess(newPoints[j].value, newPoints[j].data, e[i].value, e[i].data))) {
+				merged[count++] = e[i++];
+			}
+			else {
+				merged[count++] = newPoints[j++];
+			}
+		}
+		merged[count] = e.back();
+		e.swap(merged);
+
+		int* index = endpointIndex.data();
+		for (size_t n = 1; n + 1 < e.size(); ++n) {
+			index[endpointSlot(e[n].data, axis)] = (int)n;
+		}
+	}
+
+	if (mode == kMultiAxis) {
+		std::vector<uint64_t> pairs;
+		sweep(&pairs, true);
+		for (size_t i = 0; i < pairs.size(); ++i) {
+			Pair pair = pairFromKey(pairs[i]);
+			addPair(pair.a, pair.b);
+		}
+	}
+	for (size_t i = 0; i < added.size(); ++i) {
+		proxies[added[i]].state = kActive;
+	}
+	added.clear();
+}
+
+//ɾAABBصԣѹ˵飬ȥɾAABBĶ˵
+void SweepAndPrune::removeProxies()
+{
+	if (mode == kMultiAxis) {
+		for (size_t i = 0; i < removed.size(); ++i) {
+			std::vector<int>& list = proxyPairs[removed[i]];
+			while (!list.empty()) {
+				removePair(removed[i], list.back());
+			}
+		}
+	}
+	int* index = endpointIndex.data();
+	for (int axis = 0; axis < axisCount; ++axis) {
+		std::vector<Endpoint>& e = endpoints[axis];
+		size_t count = 1;
+		for (size_t i = 1; i + 1 < e.size(); ++i) {
+			if (proxies[e[i].data >> 1].state == kRemoved) {
+				continue;
+			}
+			index[endpointSlot(e[i].data, axis)] = (int)count;
+			e[count++] = e[i];
+		}
+		e[count++] = e.back();
+		e.resize(count);
+	}
+}
+
+//¶˵ٰ꣬Ѷ˵Ƶȷλ
+//ƶ˳֤min˵㲻ᱻԼûƶmax˵㵲ס֮Ȼ
+//һ˵ƶʱԽĶ˵㶼λ֮䣬ıͬһAABBһ˵±
+void SweepAndPrune::moveProxy(int handle)
+{
+	const AABB3& box = proxies[handle].box;
+	int* index = endpointIndex.data() + (size_t)handle * 6;
+	for (int axis = 0; axis < axisCount; ++axis) {
+		int k = axisOf[axis];
+		Endpoint* e = endpoints[axis].data();
+		int minIndex = findEndpoint(axis, handle * 2);
+		int maxIndex = findEndpoint(axis, handle * 2 + 1);
+		e[minIndex].value = axisValue(box.min, k);
+		e[maxIndex].value = axisValue(box.max, k);
+		if (mode == kMultiAxis) {
+			//ǰѾµ꣬ỹǾɵ
+			setOtherAxes(e[minIndex], box, axis, axis);
+			setOtherAxes(e[maxIndex], box, axis, axis);
+		}
+		maxIndex = sortUp(axis, maxIndex);
+		minIndex = sortDown(axis, minIndex);
+		minIndex = sortUp(axis, minIndex);
+		maxIndex = sortDown(axis, maxIndex);
+		index[axis * 2] = minIndex;
+		index[axis * 2 + 1] = maxIndex;
+	}
+	if (mode == kMultiAxis) {
+		//ȫᶼѾƶЩ˵ոշʹڻ
+		for (int axis = 0; axis < axisCount; ++axis) {
+			setOtherAxes(endpoints[axis][index[axis * 2]], box, axis, 3);
+			setOtherAxes(endpoints[axis][index[axis * 2 + 1]], box, axis, 3);
+		}
+	}
+}
+
+//һ֪±꿪ʼ߲Ҷ˵㣬ڵ±
+int SweepAndPrune::findEndpoint(int axis, int data) const
+{
+	const Endpoint* e = endpoints[axis].data();
+	const int last = (int)endpoints[axis].size() - 2;
+	const int start = endpointIndex[endpointSlot(data, axis)];
+	assert(start >= 1 && start <= last);
+	if (e[start].data == data) {
+		return start;
+	}
+	for (int d = 1; ; ++d) {
+		assert(start + d <= last || start - d >= 1);
+		if (start + d <= last && e[start + d].data == data) {
+			return start + d;
+		}
+		if (start - d >= 1 && e[start - d].data == data) {
+			return start - d;
+		}
+	}
+}
+
+//Ѷ˵ǰƵȷλãµ±
+int SweepAndPrune::sortDown(int axis, int index)
+{
+	Endpoint* e = endpoints[axis].data();
+	const bool multiAxis = mode == kMultiAxis;
+	while (endpointLess(e[index].value, e[index].data, e[index - 1].value, e[index - 1].data)) {
+		swapEndpoints(e, index - 1, multiAxis);
+		--index;
+	}
+	return index;
+}
+
+//Ѷ˵Ƶȷλãµ±
+int SweepAndPrune::sortUp(int axis, int index)
+{
+	Endpoint* e = endpoints[axis].data();
+	const bool multiAxis = mode == kMultiAxis;
+	while (endpointLess(e[index + 1].value, e[index + 1].data, e[index].value, e[index].data)) {
+		swapEndpoints(e, index, multiAxis);
+		++index;
+	}
+	return index;
+}
+
+//e[index]e[index + 1]multiAxisΪtrueʱص
+void SweepAndPrune::swapEndpoints(Endpoint* e, int index, bool multiAxis)
+{
+	Endpoint lo = e[index];
+	Endpoint hi = e[index + 1];
+	e[index] = hi;
+	e[index + 1] = lo;
+
+	//ֻmin˵max˵㽻ʱص״̬Żı
+	bool loMax = isMaxEndpoint(lo.data);
+	if (multiAxis && loMax != isMaxEndpoint(hi.data) && overlapOtherAxes(lo, hi)) {
+		if (loMax) {
+			//min˵Ƶmax˵֮ǰʼص
+			addPair(lo.data >> 1, hi.data >> 1);
+		}
+		else {
+			//max˵Ƶmin˵֮ǰص
+			removePair(lo.data >> 1, hi.data >> 1);
+		}
+	}
+}
+
+//ģʽһصԣAABB¼һ
+void SweepAndPrune::addPair(int a, int b)
+{
+	proxyPairs[a].push_back(b);
+	proxyPairs[b].push_back(a);
+	++multiAxisPairCount;
+	++pairChanges[pairKey(a, b)];
+}
+
+//ģʽɾһصԣÿAABBصԺ٣ֱӲңһԪλ
+void SweepAndPrune::removePair(int a, int b)
+{
+	std::vector<int>& listA = proxyPairs[a];
+	std::vector<int>::iterator it = std::find(listA.begin(), listA.end(), b);
+	assert(it != listA.end());
+	*it = listA.back();
+	listA.pop_back();
+	std::vector<int>& listB = proxyPairs[b];
+	it = std::find(listB.begin(), listB.end(), a);
+	assert(it != listB.end());
+	*it = listB.back();
+	listB.pop_back();
+	--multiAxisPairCount;
+	--pairChanges[pairKey(a, b)];
+}
+
+//boxaxisϵķΧд˵㣬ֻдСsortedAxes
+void SweepAndPrune::setOtherAxes(Endpoint& e, const AABB3& box, int axis, int sortedAxes)
+{
+	for (int i = 0; i < 2; ++i) {
+		int other = (axis + 1 + i) % 3;
+		if (other < sortedAxes) {
+			e.otherMin[i] = axisValue(box.min, other);
+			e.otherMax[i] = axisValue(box.max, other);
+		}
+	}
+}
+
+//ж˵AABBǷصֻڶģʽʹ
+//˵еķΧͶ˵еһ£ͬʱmin˵max˵֮ǰԺͰ˵˳жϵĽͬ
+//ǲصûйɣȽϽ&ϲ÷֧
+bool SweepAndPrune::overlapOtherAxes(const Endpoint& a, const Endpoint& b)
+{
+	return (a.otherMin[0] <= b.otherMax[0]) & (b.otherMin[0] <= a.otherMax[0])
+		& (a.otherMin[1] <= b.otherMax[1]) & (b.otherMin[1] <= a.otherMax[1]);
+}
+
+//endpoints[0]ɨ裬ҳȫص
+//صAABBintersectAABBs()жǷཻ
+//addedOnly ֻҳһAABBӵص
+void SweepAndPrune::sweep(std::vector<uint64_t>* pairs, bool addedOnly) const
+{
+	const std::vector<Endpoint>& e = endpoints[0];
+	//ɨϵAABBԼÿAABBеλ
+	//addedOnlyʱԭеAABBactive[0]ӵķactive[1]
+	std::vector<int> active[2];
+	std::vector<int> activePosition(proxies.size());
+	for (size_t i = 1; i + 1 < e.size(); ++i) {
+		int handle = e[i].data >> 1;
+		int group = (addedOnly && proxies[handle].state == kAdded) ? 1 : 0;
+		std::vector<int>& list = active[group];
+		if (isMaxEndpoint(e[i].data)) {
+			int position = activePosition[handle];
+			int last = list.back();
+			list[position] = last;
+			activePosition[last] = position;
+			list.pop_back();
+		}
+		else {
+			const AABB3& box = proxies[handle].box;
+			//ԭеAABB֮صԲ
+			for (int other = addedOnly && group == 0 ? 1 : 0; other < 2; ++other) {
+				const std::vector<int>& otherList = active[other];
+				for (size_t j = 0; j < otherList.size(); ++j) {
+					if (intersectAABBs(box, proxies[otherList[j]].box)) {
+						pairs->push_back(pairKey(handle, otherList[j]));
+					}
+				}
+			}
+			activePosition[handle] = (int)list.size();
+			list.push_back(handle);
+		}
+	}
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#ifndef __SWEEPANDPRUNE_H_INCLUDED__
+#define __SWEEPANDPRUNE_H_INCLUDED__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include <unordered_map>
+#include "AABB3.h"
+
+// ƣɨͼ
+// ߣcary
+// ɨͼsweep and pruneײ
+//		ÿAABBϵ˵㱣źУ֮֡֡䱣
+//		ƶֻòĶ˵ƵµλãƶԽٴԽС
+//		AABBཻжϺintersectAABBs()߽ͬӴҲཻ
+//
+//		ģʽ
+//		kSingleAxis ֻһÿupdatePairs()ظɨһ飬ҳȫص
+//			ۺԼڸصĶȣʺϴ󲿷嶼ƶ
+//		kMultiAxis ϶򣬶˵㽻ʱֱӻɾصԣҪɨ
+//			ֻƶԼĴȣʺϴ󲿷徲ֹ
+
+class SweepAndPrune
+{
+public:
+	enum Mode {
+		kSingleAxis,
+		kMultiAxis
+	};
+
+	//һصԣa < badd()صľ
+	struct Pair {
+		int a;
+		int b;
+	};
+
+	//sortAxis ģʽᣬ012ֱΪxyzһѡֲɢ
+	explicit SweepAndPrune(Mode mode = kMultiAxis, int sortAxis = 0);
+
+	//ӣɾƶAABB
+	//ЩֻǱ¼һupdatePairs()ʱ
+	//ӺɾҪѶ˵ϲѹһ飬ӻɾһ֡ۺAABB
+	//AABBΪգ޵ֵ
+	//AABBؾɾľupdatePairs()֮ᱻظʹ
+	int add(const AABB3& box);
+	void remove(int handle);
+	void update(int handle, const AABB3& box);
+
+	const AABB3& getBox(int handle) const { return proxies[handle].box; }
+	//AABBûд
+	size_t size() const { return proxyCount; }
+
+	//һεȫ仯
+	//³ֵص׷ӵaddedĩβʧص׷ӵremovedĩβΪNULL
+	//ɾAABBصԶremoved
+	void updatePairs(std::vector<Pair>* added, std::vector<Pair>* removed);
+
+	//ǰȫصԣ׷ӵpairsĩβֻѾı仯
+	void getPairs(std::vector<Pair>* pairs) const;
+	size_t pairCount() const;
+
+private:
+	struct Endpoint {
+		float value;
+		// * 2 + (ǷΪmax˵)ڱΪ-1
+		int data;
+		//ģʽAABBϵķΧĶ˵еһ
+		//iԪضӦΪ (axis + 1 + i) % 3˵ʱֱӱȽϣҪProxy
+		float otherMin[2];
+		float otherMax[2];
+	};
+
+	enum ProxyState {
+		kFree,
+		kActive,
+		kAdded,
+		kRemoved
+	};
+
+	struct Proxy {
+		AABB3 box;
+		int state;
+		//Ѿmoved
+		bool moved;
+	};
+
+	Mode mode;
+	//ÿӦ
+	int axisCount;
+	int axisOf[3];
+	//źĶ˵㣬˸һڱ
+	std::vector<Endpoint> endpoints[3];
+	//ÿ˵һ֪±꣬ÿAABBminmax˵㣬6intendpointSlot()
+	//˵ʱ£ƶAABBʱ￪ʼڸңfindEndpoint()
+	std::vector<int> endpointIndex;
+
+	std::vector<Proxy> proxies;
+	std::vector<int> freeHandles;
+	size_t proxyCount;
+
+	//ȴı仯
+	std::vector<int> added;
+	std::vector<int> moved;
+	std::vector<int> removed;
+
+	//ģʽصԣAABBproxyPairs[a]ǺaصAABBÿص߸¼һ
+	//ɾAABBʱֻҪԼص
+	//صǺͶ˵е˳һ£϶صAABBص
+	std::vector<std::vector<int> > proxyPairs;
+	size_t multiAxisPairCount;
+	//updatePairs()صԵı仯+1Ϊ-1Ϊʧ
+	std::unordered_map<uint64_t, int> pairChanges;
+	//ģʽصԣ
+	std::vector<uint64_t> sortedPairs;
+
+	void insertProxies();
+	void removeProxies();
+	void moveProxy(int handle);
+	int findEndpoint(int axis, int data) const;
+	int sortDown(int axis, int index);
+	int sortUp(int axis, int index);
+	void swapEndpoints(Endpoint* e, int index, bool multiAxis);
+	void addPair(int a, int b);
+	void removePair(int a, int b);
+	static void setOtherAxes(Endpoint& e, const AABB3& box, int axis, int sortedAxes);
+	static bool overlapOtherAxes(const Endpoint& a, const Endpoint& b);
+	void sweep(std::vector<uint64_t>* pairs, bool addedOnly) const;
+};
+
+#endif // #ifndef __SWEEPANDPRUNE_H_INCLUDED__
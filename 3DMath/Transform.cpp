@@ -0,0 +1,144 @@
+#include <assert.h>
+
+#include "Transform.h"
+#include "Matrix4x3.h"
+#include "SimdUtil.h"
+#include "SimdMatrix4x3.h"
+#include "SimdQuaternion.h"
+
+// ƣ任
+// ߣcary
+// 汾ÿζkSimdWidthTransformÿTransform8float
+//		 rotation  translation + scale θ4floatתΪSoA˳͵汾ͬ
+
+//Ϊλ任
+void Transform::identity() {
+	rotation.identity();
+	translation = Vector3(0.0f, 0.0f, 0.0f);
+	scale = 1.0f;
+}
+
+//˳composeTRSUniform()ͬ
+Matrix4x3 Transform::toMatrix() const {
+	Matrix4x3 m;
+	m.fromQuaternion(rotation);
+	m.m11 *= scale; m.m12 *= scale; m.m13 *= scale;
+	m.m21 *= scale; m.m22 *= scale; m.m23 *= scale;
+	m.m31 *= scale; m.m32 *= scale; m.m33 *= scale;
+	m.tx = translation.x;
+	m.ty = translation.y;
+	m.tz = translation.z;
+	return m;
+}
+
+//任㣬ʱԪתĳ˷
+void transformPoints(const Vector3* in, Vector3* out, size_t n, const Transform& t) {
+	transformPoints(in, out, n, t.toMatrix());
+}
+
+//kSimdWidthı任
+static inline void simdLoadTransforms(const Transform* t,
+	SimdFloat* qx, SimdFloat* qy, SimdFloat* qz, SimdFloat* qw,
+	SimdFloat* tx, SimdFloat* ty, SimdFloat* tz, SimdFloat* s) {
+	simdLoad4x(&t->rotation.x, 8, qx, qy, qz, qw);
+	simdLoad4x(&t->translation.x, 8, tx, ty, tz, s);
+}
+
+//SoAʽӣÿһ·operator*˳ͬдout[0..kSimdWidth)
+static inline void simdConcatenate(const Transform* a, const Transform* b, Transform* out) {
+	SimdFloat aqx, aqy, aqz, aqw, atx, aty, atz, as;
+	SimdFloat bqx, bqy, bqz, bqw, btx, bty, btz, bs;
+	simdLoadTransforms(a, &aqx, &aqy, &aqz, &aqw, &atx, &aty, &atz, &as);
+	simdLoadTransforms(b, &bqx, &bqy, &bqz, &bqw, &btx, &bty, &btz, &bs);
+
+	SimdFloat rqx, rqy, rqz, rqw;
+	simdMultiply(aqx, aqy, aqz, aqw, bqx, bqy, bqz, bqw, &rqx, &rqy, &rqz, &rqw);
+	SimdFloat rtx, rty, rtz;
+	simdRotate(bqx, bqy, bqz, bqw, simdMul(atx, bs), simdMul(aty, bs), simdMul(atz, bs), &rtx, &rty, &rtz);
+
+	simdStore4x(&out->rotation.x, 8, rqx, rqy, rqz, rqw);
+	simdStore4x(&out->translation.x, 8, simdAdd(rtx, btx), simdAdd(rty, bty), simdAdd(rtz, btz), simdMul(as, bs));
+}
+
+//ӱ任out[i] = a[i] * b[i]
+void concatenate(const Transform* a, const Transform* b, Transform* out, size_t n) {
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		simdConcatenate(a + i, b + i, out + i);
+	}
+	for (; i < n; ++i) {
+		out[i] = a[i] * b[i];
+	}
+}
+
+//任˳inverse(const Transform&)ͬ
+void inverse(const Transform* in, Transform* out, size_t n) {
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat qx, qy, qz, qw, tx, ty, tz, s;
+		simdLoadTransforms(in + i, &qx, &qy, &qz, &qw, &tx, &ty, &tz, &s);
+		//Ԫȡֻıλͱȡͬ
+		qx = simdNeg(qx);
+		qy = simdNeg(qy);
+		qz = simdNeg(qz);
+		SimdFloat rs = simdDiv(simdSet(1.0f), s);
+		SimdFloat rtx, rty, rtz;
+		simdRotate(qx, qy, qz, qw, simdNeg(tx), simdNeg(ty), simdNeg(tz), &rtx, &rty, &rtz);
+		simdStore4x(&out[i].rotation.x, 8, qx, qy, qz, qw);
+		simdStore4x(&out[i].translation.x, 8, simdMul(rtx, rs), simdMul(rty, rs), simdMul(rtz, rs), rs);
+	}
+	for (; i < n; ++i) {
+		out[i] = inverse(in[i]);
+	}
+}
+
+//ظڵϱ任out[i] = local[i] * out[parent[i]]
+void composeHierarchy(const Transform* local, const int* parent, Transform* out, size_t n) {
+	assert(n == 0 || local != out);
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		//ڵ㶼ѾòҲǸڵʱѸڵĽռת
+		bool independent = true;
+		for (size_t j = 0; j < kSimdWidth; ++j) {
+			assert(parent[i + j] < (int)(i + j));
+			independent = independent && parent[i + j] >= 0 && parent[i + j] < (int)i;
+		}
+		if (!independent) {
+			for (size_t j = i; j < i + kSimdWidth; ++j) {
+				out[j] = parent[j] < 0 ? local[j] : local[j] * out[parent[j]];
+			}
+			continue;
+		}
+		Transform parents[kSimdWidth];
+		for (size_t j = 0; j < kSimdWidth; ++j) {
+			parents[j] = out[parent[i + j]];
+		}
+		simdConcatenate(local + i, parents, out + i);
+	}
+	for (; i < n; ++i) {
+		assert(parent[i] < (int)i);
+		out[i] = parent[i] < 0 ? local[i] : local[i] * out[parent[i]];
+	}
+}
+
+//תΪ˳toMatrix()ͬ
+void toMatrices(const Transform* in, Matrix4x3* out, size_t n) {
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat qx, qy, qz, qw, s;
+		SimdMatrix4x3 r;
+		simdLoadTransforms(in + i, &qx, &qy, &qz, &qw, &r.tx, &r.ty, &r.tz, &s);
+		simdFromQuaternion(qx, qy, qz, qw, &r);
+		r.m11 = simdMul(r.m11, s); r.m12 = simdMul(r.m12, s); r.m13 = simdMul(r.m13, s);
+		r.m21 = simdMul(r.m21, s); r.m22 = simdMul(r.m22, s); r.m23 = simdMul(r.m23, s);
+		r.m31 = simdMul(r.m31, s); r.m32 = simdMul(r.m32, s); r.m33 = simdMul(r.m33, s);
+		simdStoreMatrices(out + i, r);
+	}
+	for (; i < n; ++i) {
+		out[i] = in[i].toMatrix();
+	}
+}
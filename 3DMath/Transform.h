@@ -0,0 +1,111 @@
+#pragma once
+
+#ifndef __TRANSFORM_H_INCLUDED__
+#define __TRANSFORM_H_INCLUDED__
+
+#include <stddef.h>
+#include <assert.h>
+#include "Quaternion.h"
+#include "Vector3.h"
+
+template <typename T> class Matrix4x3T;
+typedef Matrix4x3T<float> Matrix4x3;
+
+// ƣ任
+// ߣcary
+// תƽƺ;űʾĸӾŵı任32ֽڣMatrix4x3Ϊ48ֽ
+//		󲿷ֳڵֱֻ任TransformֻҪʱȾƤȣתΪMatrix4x3
+//		ı任Matrix4x3ͬԼȰscaleţٰrotationתƽtranslation
+//		a * b ʾȽaı任ٽbı任 a.toMatrix() * b.toMatrix() ֻͬĲ
+//		ŵı任ӺȻǾţǾźתӺб䣬ʽʾ
+
+class Transform
+{
+public:
+	//λԪ
+	Quaternion rotation;
+	Vector3 translation;
+	float scale;
+
+	//Ϊλ任
+	void identity();
+
+	//ţתƽ
+	//composeTRSUniform()toMatrices()λһ
+	Matrix4x3 toMatrix() const;
+
+	//* ӱ任Ƚı任ٽaı任
+	Transform operator *(const Transform& a) const;
+	Transform& operator *=(const Transform& a);
+};
+
+//汾ڴ沼֣rotationtranslationscale8float
+static_assert(sizeof(Transform) == 8 * sizeof(float), "Transform must be eight packed floats");
+
+//* 任ӱ任汾concatenate()ȣ˳ͬ޸ʱҪһ
+//ӱ任ƽưašתټaƽ
+inline Transform Transform::operator *(const Transform& a) const {
+	Transform r;
+	r.rotation = rotation * a.rotation;
+	r.translation = rotate(a.rotation, translation * a.scale) + a.translation;
+	r.scale = scale * a.scale;
+	return r;
+}
+
+inline Transform& Transform::operator *=(const Transform& a) {
+	*this = *this * a;
+	return *this;
+}
+
+//*任任
+inline Vector3 operator *(const Vector3& p, const Transform& t) {
+	return rotate(t.rotation, p * t.scale) + t.translation;
+}
+
+inline Vector3& operator *=(Vector3& p, const Transform& t) {
+	p = p * t;
+	return p;
+}
+
+//任scaleΪ0
+//ƽ-translationٰת1/scaleţ
+//дתƽƵʽƽΪ rotate(, -translation) / scale
+inline Transform inverse(const Transform& t) {
+	assert(t.scale != 0.0f);
+	Transform r;
+	r.rotation.x = -t.rotation.x;
+	r.rotation.y = -t.rotation.y;
+	r.rotation.z = -t.rotation.z;
+	r.rotation.w = t.rotation.w;
+	r.scale = 1.0f / t.scale;
+	r.translation = rotate(r.rotation, -t.translation) * r.scale;
+	return r;
+}
+
+//任㣬out[i] = in[i] * t
+//ȰtתΪtransformPoints()任operator*ֻĲ
+//in  out ͬһ
+void transformPoints(const Vector3* in, Vector3* out, size_t n, const Transform& t);
+
+//ӱ任out[i] = a[i] * b[i]ÿμkSimdWidth48operator*λһ
+//out Ժ a  b ͬһ
+void concatenate(const Transform* a, const Transform* b, Transform* out, size_t n);
+
+//任out[i] = inverse(in[i])ÿμkSimdWidth48λһ
+//scale Ϊ0in  out ͬһ
+void inverse(const Transform* in, Transform* out, size_t n);
+
+//ظڵϱ任õֲı任
+//	parent[i] < 0 ʱ out[i] = local[i] out[i] = local[i] * out[parent[i]]
+//	operator*λһ
+//ڵӽڵ֮ǰparent[i] < i
+//һkSimdWidthڵĸڵ㶼һ֮ǰʱSIMD㣬һ㣬
+//Խڵ㰴ͬһĽڵڣʱЧ
+//out ܺ local ͬһ
+void composeHierarchy(const Transform* local, const int* parent, Transform* out, size_t n);
+
+//תΪout[i] = in[i].toMatrix()ÿתkSimdWidth48λһ
+//ֻתҪĽڵ㣬ɼ
+void toMatrices(const Transform* in, Matrix4x3* out, size_t n);
+
+#endif // #ifndef __TRANSFORM_H_INCLUDED__
@@ -1,85 +1,185 @@
 #pragma once
 #include <math.h>
+#include <type_traits>
 
 // ƣ3D
 // ߣcary
 // 3Dķװ
+//		ģVector3Ϊfloat汾Vector3dΪdouble汾
+//		double汾ڴΧ꣬һתΪfloat㣬CameraRelative.h
+//		졢ȽϺ㶼constexprڱڼ㳣
+//		ӡȡͱ˳ñʽģʵ֣˵
 
-class Vector3
+template <typename T> class Vector3T;
+
+//ʽģ
+//a + b * k - c ıʽÿһһVector3ʱ󣬶һñʽ
+//ڸֵVector3Vector3ʱֵʽֻһѭ
+//ÿֻͬһ v = w - v ͬһʱҲȷ
+//˳𲽼ʱʱͬλһ
+//
+//ʽΪҶӵVector3ҪautoʽӦֱӸֵVector3
+
+//ʽĻ࣬EΪıʽͣṩ evalX() evalY() evalZ()
+template <typename E>
+class Vector3Expression
 {
 public:
-	float x, y, z;
+	constexpr const E& derived() const { return static_cast<const E&>(*this); }
+};
 
-	Vector3() {}
+//ʽбķʽVector3ãмڵСֱӱֵ
+template <typename E>
+struct Vector3Operand { typedef const E type; };
+template <typename T>
+struct Vector3Operand<Vector3T<T> > { typedef const Vector3T<T>& type; };
 
-	Vector3(const Vector3& a) :x(a.x), y(a.y), z(a.z) {}
+//ıͱͬfloatdouble֮Ҫʽת
+template <typename L, typename R>
+struct Vector3BinaryScalar {
+	static_assert(std::is_same<typename L::Scalar, typename R::Scalar>::value,
+		"mixing float and double vectors needs an explicit conversion");
+	typedef typename L::Scalar type;
+};
 
-	Vector3(float nx, float ny, float nz) :x(nx), y(ny), z(nz) {}
+//ӷ
+template <typename L, typename R>
+class Vector3Sum : public Vector3Expression<Vector3Sum<L, R> >
+{
+public:
+	typedef typename Vector3BinaryScalar<L, R>::type Scalar;
+	constexpr Vector3Sum(const L& l, const R& r) :l(l), r(r) {}
+	constexpr Scalar evalX() const { return l.evalX() + r.evalX(); }
+	constexpr Scalar evalY() const { return l.evalY() + r.evalY(); }
+	constexpr Scalar evalZ() const { return l.evalZ() + r.evalZ(); }
+private:
+	typename Vector3Operand<L>::type l;
+	typename Vector3Operand<R>::type r;
+};
 
-	Vector3 operator = (const Vector3& a) {
-		x = a.x;
-		y = a.y;
-		z = a.z;
-		return *this;
-	}
+//
+template <typename L, typename R>
+class Vector3Difference : public Vector3Expression<Vector3Difference<L, R> >
+{
+public:
+	typedef typename Vector3BinaryScalar<L, R>::type Scalar;
+	constexpr Vector3Difference(const L& l, const R& r) :l(l), r(r) {}
+	constexpr Scalar evalX() const { return l.evalX() - r.evalX(); }
+	constexpr Scalar evalY() const { return l.evalY() - r.evalY(); }
+	constexpr Scalar evalZ() const { return l.evalZ() - r.evalZ(); }
+private:
+	typename Vector3Operand<L>::type l;
+	typename Vector3Operand<R>::type r;
+};
 
-	bool operator == (const Vector3& a) {
-		return x == a.x && y == a.y && z == a.z;
-	}
+//ȡ
+template <typename E>
+class Vector3Negation : public Vector3Expression<Vector3Negation<E> >
+{
+public:
+	typedef typename E::Scalar Scalar;
+	explicit constexpr Vector3Negation(const E& e) :e(e) {}
+	constexpr Scalar evalX() const { return -e.evalX(); }
+	constexpr Scalar evalY() const { return -e.evalY(); }
+	constexpr Scalar evalZ() const { return -e.evalZ(); }
+private:
+	typename Vector3Operand<E>::type e;
+};
 
-	bool operator != (const Vector3& a) {
-		return x != a.x || y != a.y || z != a.z;
-	}
+//˷תΪԵ
+template <typename E>
+class Vector3Scale : public Vector3Expression<Vector3Scale<E> >
+{
+public:
+	typedef typename E::Scalar Scalar;
+	constexpr Vector3Scale(const E& e, Scalar k) :e(e), k(k) {}
+	constexpr Scalar evalX() const { return e.evalX() * k; }
+	constexpr Scalar evalY() const { return e.evalY() * k; }
+	constexpr Scalar evalZ() const { return e.evalZ() * k; }
+private:
+	typename Vector3Operand<E>::type e;
+	Scalar k;
+};
 
-	//
-	void zero() {
-		x = y = z = 0.0f;
-	}
+template <typename T>
+class Vector3T : public Vector3Expression<Vector3T<T> >
+{
+public:
+	typedef T Scalar;
 
-	Vector3 operator - () const {
-		return Vector3(-x, -y, -z);
-	}
+	T x, y, z;
+
+	//ʼVector3 v{} ʱ
+	Vector3T() = default;
+
+	Vector3T(const Vector3T& a) = default;
+
+	constexpr Vector3T(T nx, T ny, T nz) :x(nx), y(ny), z(nz) {}
+
+	//ӱʽ죬ֵʽıͱͬ
+	template <typename E, typename = typename std::enable_if<std::is_same<typename E::Scalar, T>::value>::type>
+	constexpr Vector3T(const Vector3Expression<E>& a)
+		:x(a.derived().evalX()), y(a.derived().evalY()), z(a.derived().evalZ()) {}
+
+	//floatdouble֮תʽ
+	template <typename U, typename = typename std::enable_if<!std::is_same<U, T>::value>::type>
+	explicit constexpr Vector3T(const Vector3T<U>& a) :x(T(a.x)), y(T(a.y)), z(T(a.z)) {}
 
-	Vector3 operator + (const Vector3& a) const {
-		return Vector3(x + a.x, y + a.y, z + a.z);
+	//ֵ
+	Vector3T& operator = (const Vector3T& a) = default;
+
+	template <typename E>
+	constexpr Vector3T& operator = (const Vector3Expression<E>& a) {
+		static_assert(std::is_same<typename E::Scalar, T>::value, "mixing float and double vectors needs an explicit conversion");
+		const E& e = a.derived();
+		x = e.evalX();
+		y = e.evalY();
+		z = e.evalZ();
+		return *this;
 	}
 
-	Vector3 operator - (const Vector3& a) const {
-		return Vector3(x - a.x, y - a.y, z - a.z);
+	constexpr bool operator == (const Vector3T& a) const {
+		return x == a.x && y == a.y && z == a.z;
 	}
 
-	Vector3 operator * (const float a) const {
-		return Vector3(x * a, y *a, z * a);
+	constexpr bool operator != (const Vector3T& a) const {
+		return x != a.x || y != a.y || z != a.z;
 	}
 
-	Vector3 operator / (const float a) const {
-		float reciprocal = 1.0f / a;
-		return Vector3(x * reciprocal, y * reciprocal, z * reciprocal);
+	//
+	constexpr void zero() {
+		x = y = z = T(0);
 	}
 
-	Vector3 operator += (const Vector3& a) {
-		x += a.x;
-		y += a.y;
-		z += a.z;
+	template <typename E>
+	constexpr Vector3T& operator += (const Vector3Expression<E>& a) {
+		static_assert(std::is_same<typename E::Scalar, T>::value, "mixing float and double vectors needs an explicit conversion");
+		const E& e = a.derived();
+		x += e.evalX();
+		y += e.evalY();
+		z += e.evalZ();
 		return *this;
 	}
 
-	Vector3 operator -= (const Vector3& a) {
-		x -= a.x;
-		y -= a.y;
-		z -= a.z;
+	template <typename E>
+	constexpr Vector3T& operator -= (const Vector3Expression<E>& a) {
+		static_assert(std::is_same<typename E::Scalar, T>::value, "mixing float and double vectors needs an explicit conversion");
+		const E& e = a.derived();
+		x -= e.evalX();
+		y -= e.evalY();
+		z -= e.evalZ();
 		return *this;
 	}
 
-	Vector3 operator *= (const float a) {
+	constexpr Vector3T& operator *= (const T a) {
 		x *= a;
 		y *= a;
 		z *= a;
 		return *this;
 	}
 
-	Vector3 operator /= (const float a) {
-		float reciprocal = 1.0f / a;
+	constexpr Vector3T& operator /= (const T a) {
+		T reciprocal = T(1) / a;
 		x *= reciprocal;
 		y *= reciprocal;
 		z *= reciprocal;
@@ -88,59 +188,105 @@ public:
 
 	//׼
 	void normalize() {
-		float sumOfSquare = x * x + y * y + z * z;
-		if (sumOfSquare > 0.0f) {
-			float reciprocal = 1.0f / sqrt(sumOfSquare);
+		T sumOfSquare = x * x + y * y + z * z;
+		if (sumOfSquare > T(0)) {
+			T reciprocal = T(1) / sqrt(sumOfSquare);
 			x *= reciprocal;
 			y *= reciprocal;
 			z *= reciprocal;
 		}
 	}
 
-	float operator * (const Vector3 &a) const {
-		return x * a.x + y * a.y + z * a.z;
-	}
+	//ʽģҶ
+	constexpr T evalX() const { return x; }
+	constexpr T evalY() const { return y; }
+	constexpr T evalZ() const { return z; }
 };
 
+typedef Vector3T<float> Vector3;
+typedef Vector3T<double> Vector3d;
+
+//Vector3ʽرʽ
+template <typename E>
+constexpr Vector3Negation<E> operator - (const Vector3Expression<E>& a) {
+	return Vector3Negation<E>(a.derived());
+}
+
+template <typename L, typename R>
+constexpr Vector3Sum<L, R> operator + (const Vector3Expression<L>& a, const Vector3Expression<R>& b) {
+	return Vector3Sum<L, R>(a.derived(), b.derived());
+}
+
+template <typename L, typename R>
+constexpr Vector3Difference<L, R> operator - (const Vector3Expression<L>& a, const Vector3Expression<R>& b) {
+	return Vector3Difference<L, R>(a.derived(), b.derived());
+}
+
+template <typename E>
+constexpr Vector3Scale<E> operator * (const Vector3Expression<E>& a, typename E::Scalar k) {
+	return Vector3Scale<E>(a.derived(), k);
+}
+
+//ʵֱ
+template <typename E>
+constexpr Vector3Scale<E> operator * (typename E::Scalar k, const Vector3Expression<E>& a) {
+	return Vector3Scale<E>(a.derived(), k);
+}
+
+template <typename E>
+constexpr Vector3Scale<E> operator / (const Vector3Expression<E>& a, typename E::Scalar k) {
+	return Vector3Scale<E>(a.derived(), typename E::Scalar(1) / k);
+}
+
+//
+template <typename L, typename R>
+constexpr typename Vector3BinaryScalar<L, R>::type operator * (const Vector3Expression<L>& a, const Vector3Expression<R>& b) {
+	return a.derived().evalX() * b.derived().evalX() + a.derived().evalY() * b.derived().evalY()
+		+ a.derived().evalZ() * b.derived().evalZ();
+}
+
+//ºĲVector3ʽı¼
+
 //Ĥ
-inline float vectorMag(const Vector3& a) {
-	double x = double(a.x);
-	double y = double(a.y);
-	double z = double(a.z);
-	return sqrt(x * x + y * y + z * z);
+template <typename E>
+inline typename E::Scalar vectorMag(const Vector3Expression<E>& e) {
+	const Vector3T<typename E::Scalar> a(e);
+	return sqrt(a.x * a.x + a.y * a.y + a.z * a.z);
 }
 
 //Ĳ
-inline Vector3 crossProduct(const Vector3 &a, const Vector3& b) {
-	return Vector3(
+template <typename L, typename R>
+constexpr Vector3T<typename Vector3BinaryScalar<L, R>::type> crossProduct(const Vector3Expression<L>& l, const Vector3Expression<R>& r) {
+	typedef Vector3T<typename Vector3BinaryScalar<L, R>::type> Vector;
+	const Vector a(l), b(r);
+	return Vector(
 		a.y * b.z - a.z * b.y,
 		a.z * b.x - a.x * b.z,
-		a.x * b.y - a.y - b.x
+		a.x * b.y - a.y * b.x
 	);
 }
 
-//ʵֱ
-inline Vector3 operator *(float k,const Vector3 &v) {
-	return Vector3(k * v.x, k * v.y,k*v.z);
+//ľƽ
+template <typename L, typename R>
+constexpr typename Vector3BinaryScalar<L, R>::type distanceSquared(const Vector3Expression<L>& a, const Vector3Expression<R>& b) {
+	typedef typename Vector3BinaryScalar<L, R>::type Scalar;
+	Scalar dx = a.derived().evalX() - b.derived().evalX();
+	Scalar dy = a.derived().evalY() - b.derived().evalY();
+	Scalar dz = a.derived().evalZ() - b.derived().evalZ();
+	return dx * dx + dy * dy + dz * dz;
+
 }
 
 //ľ
-inline float distance(const Vector3& a, const Vector3& b) {
+template <typename L, typename R>
+inline typename Vector3BinaryScalar<L, R>::type distance(const Vector3Expression<L>& a, const Vector3Expression<R>& b) {
 	
 	//ľƽ
-	float squared = distanceSquared(a,b);
+	typename Vector3BinaryScalar<L, R>::type squared = distanceSquared(a,b);
 	return sqrt(squared);
 
 }
 
-//ľƽ
-inline float distanceSquared(const Vector3& a, const Vector3& b) {
-	double dx = double(a.x) - double(b.x);
-	double dy = double(a.y) - double(b.y);
-	double dz = double(a.z) - double(b.z);
-	return dx * dx + dy * dy + dz * dz;
-
-}
 
-//ṩһȫ
-extern const Vector3 kZeroVector;
\ No newline at end of file
+//ṩһȫڳҪ̬ʼ
+constexpr Vector3 kZeroVector(0.0f, 0.0f, 0.0f);
@@ -0,0 +1,275 @@
+#include <assert.h>
+#include <string.h>
+
+#include "Vector3Array.h"
+#include "Vector3.h"
+#include "SimdUtil.h"
+
+// ƣ3D
+// ߣcary
+// SoAʽһ3Dxyzֱ
+//
+//		ÿȡ8floatʼַ32ֽڶģ
+//		㰴kSimdWidth飬ʣ²һĲñ봦
+//		SIMD˳֤ͬVector3λһ
+
+//SIMDתҪVector3ڴfloat
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be three packed floats");
+
+//ȡλ
+const size_t kStreamGranularity = kSimdAlignment / sizeof(float);
+
+static size_t roundUpCapacity(size_t n) {
+	return (n + kStreamGranularity - 1) & ~(kStreamGranularity - 1);
+}
+
+Vector3Array::Vector3Array() :x(NULL), y(NULL), z(NULL), count(0), capacity(0), buffer(NULL) {}
+
+Vector3Array::Vector3Array(size_t n) : x(NULL), y(NULL), z(NULL), count(0), capacity(0), buffer(NULL) {
+	resize(n);
+}
+
+Vector3Array::Vector3Array(const Vector3Array& a) : x(NULL), y(NULL), z(NULL), count(0), capacity(0), buffer(NULL) {
+	*this = a;
+}
+
+Vector3Array::~Vector3Array() {
+	alignedFree(buffer);
+}
+
+Vector3Array& Vector3Array::operator =(const Vector3Array& a) {
+	if (this != &a) {
+		resize(a.count);
+		//ָNULLܴmemcpy
+		if (count > 0) {
+			memcpy(x, a.x, count * sizeof(float));
+			memcpy(y, a.y, count * sizeof(float));
+			memcpy(z, a.z, count * sizeof(float));
+		}
+	}
+	return *this;
+}
+
+//ıԭеݱĲδʼ
+void Vector3Array::resize(size_t n) {
+	if (n > capacity) {
+		//ⷴresizeʱƵ
+		size_t newCapacity = roundUpCapacity(n > capacity * 2 ? n : capacity * 2);
+		float* newBuffer = (float*)alignedAlloc(newCapacity * 3 * sizeof(float));
+		assert(newBuffer != NULL);
+		float* newX = newBuffer;
+		float* newY = newBuffer + newCapacity;
+		float* newZ = newBuffer + newCapacity * 2;
+		if (count > 0) {
+			memcpy(newX, x, count * sizeof(float));
+			memcpy(newY, y, count * sizeof(float));
+			memcpy(newZ, z, count * sizeof(float));
+		}
+		alignedFree(buffer);
+		buffer = newBuffer;
+		capacity = newCapacity;
+		x = newX;
+		y = newY;
+		z = newZ;
+	}
+	count = n;
+}
+
+//
+Vector3 Vector3Array::get(size_t i) const {
+	assert(i < count);
+	return Vector3(x[i], y[i], z[i]);
+}
+
+//д
+void Vector3Array::set(size_t i, const Vector3& v) {
+	assert(i < count);
+	x[i] = v.x;
+	y[i] = v.y;
+	z[i] = v.z;
+}
+
+//v[0..n)룬СΪn
+void Vector3Array::fromVector3s(const Vector3* v, size_t n) {
+	resize(n);
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat vx, vy, vz;
+		simdLoadXYZ(&v[i].x, &vx, &vy, &vz);
+		simdStoreAligned(x + i, vx);
+		simdStoreAligned(y + i, vy);
+		simdStoreAligned(z + i, vz);
+	}
+	for (; i < n; ++i) {
+		x[i] = v[i].x;
+		y[i] = v[i].y;
+		z[i] = v[i].z;
+	}
+}
+
+//дv[0..size())
+void Vector3Array::toVector3s(Vector3* v) const {
+	const size_t simdEnd = count - count % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		simdStoreXYZ(&v[i].x, simdLoadAligned(x + i), simdLoadAligned(y + i), simdLoadAligned(z + i));
+	}
+	for (; i < count; ++i) {
+		v[i].x = x[i];
+		v[i].y = y[i];
+		v[i].z = z[i];
+	}
+}
+
+//ȫ
+void Vector3Array::zero() {
+	memset(x, 0, count * sizeof(float));
+	memset(y, 0, count * sizeof(float));
+	memset(z, 0, count * sizeof(float));
+}
+
+//׼Vector3::normalize()ֲͬ
+void Vector3Array::normalize() {
+	const size_t simdEnd = count - count % kSimdWidth;
+	const SimdFloat zero = simdZero();
+	const SimdFloat one = simdSet(1.0f);
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat vx = simdLoadAligned(x + i);
+		SimdFloat vy = simdLoadAligned(y + i);
+		SimdFloat vz = simdLoadAligned(z + i);
+		SimdFloat sumOfSquare = simdAdd(simdAdd(simdMul(vx, vx), simdMul(vy, vy)), simdMul(vz, vz));
+		//Ϊ·1ֲ
+		SimdFloat reciprocal = simdDiv(one, simdSqrt(sumOfSquare));
+		reciprocal = simdSelect(simdCmpGt(sumOfSquare, zero), reciprocal, one);
+		simdStoreAligned(x + i, simdMul(vx, reciprocal));
+		simdStoreAligned(y + i, simdMul(vy, reciprocal));
+		simdStoreAligned(z + i, simdMul(vz, reciprocal));
+	}
+	for (; i < count; ++i) {
+		float sumOfSquare = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+		if (sumOfSquare > 0.0f) {
+			float reciprocal = 1.0f / sqrt(sumOfSquare);
+			x[i] *= reciprocal;
+			y[i] *= reciprocal;
+			z[i] *= reciprocal;
+		}
+	}
+}
+
+//out[i] = a[i] + b[i]
+void add(const Vector3Array& a, const Vector3Array& b, Vector3Array* out) {
+	assert(a.size() == b.size());
+	const size_t n = a.size();
+	out->resize(n);
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		simdStoreAligned(out->x + i, simdAdd(simdLoadAligned(a.x + i), simdLoadAligned(b.x + i)));
+		simdStoreAligned(out->y + i, simdAdd(simdLoadAligned(a.y + i), simdLoadAligned(b.y + i)));
+		simdStoreAligned(out->z + i, simdAdd(simdLoadAligned(a.z + i), simdLoadAligned(b.z + i)));
+	}
+	for (; i < n; ++i) {
+		out->x[i] = a.x[i] + b.x[i];
+		out->y[i] = a.y[i] + b.y[i];
+		out->z[i] = a.z[i] + b.z[i];
+	}
+}
+
+//out[i] = a[i] - b[i]
+void subtract(const Vector3Array& a, const Vector3Array& b, Vector3Array* out) {
+	assert(a.size() == b.size());
+	const size_t n = a.size();
+	out->resize(n);
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		simdStoreAligned(out->x + i, simdSub(simdLoadAligned(a.x + i), simdLoadAligned(b.x + i)));
+		simdStoreAligned(out->y + i, simdSub(simdLoadAligned(a.y + i), simdLoadAligned(b.y + i)));
+		simdStoreAligned(out->z + i, simdSub(simdLoadAligned(a.z + i), simdLoadAligned(b.z + i)));
+	}
+	for (; i < n; ++i) {
+		out->x[i] = a.x[i] - b.x[i];
+		out->y[i] = a.y[i] - b.y[i];
+		out->z[i] = a.z[i] - b.z[i];
+	}
+}
+
+//out[i] = a[i] * k
+void scale(const Vector3Array& a, float k, Vector3Array* out) {
+	const size_t n = a.size();
+	out->resize(n);
+	const size_t simdEnd = n - n % kSimdWidth;
+	const SimdFloat vk = simdSet(k);
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		simdStoreAligned(out->x + i, simdMul(simdLoadAligned(a.x + i), vk));
+		simdStoreAligned(out->y + i, simdMul(simdLoadAligned(a.y + i), vk));
+		simdStoreAligned(out->z + i, simdMul(simdLoadAligned(a.z + i), vk));
+	}
+	for (; i < n; ++i) {
+		out->x[i] = a.x[i] * k;
+		out->y[i] = a.y[i] * k;
+		out->z[i] = a.z[i] * k;
+	}
+}
+
+//out[i] = crossProduct(a[i], b[i])
+void crossProduct(const Vector3Array& a, const Vector3Array& b, Vector3Array* out) {
+	assert(a.size() == b.size());
+	const size_t n = a.size();
+	out->resize(n);
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat ax = simdLoadAligned(a.x + i), ay = simdLoadAligned(a.y + i), az = simdLoadAligned(a.z + i);
+		SimdFloat bx = simdLoadAligned(b.x + i), by = simdLoadAligned(b.y + i), bz = simdLoadAligned(b.z + i);
+		//ȫдأoutԺabͬһ
+		SimdFloat rx = simdSub(simdMul(ay, bz), simdMul(az, by));
+		SimdFloat ry = simdSub(simdMul(az, bx), simdMul(ax, bz));
+		SimdFloat rz = simdSub(simdMul(ax, by), simdMul(ay, bx));
+		simdStoreAligned(out->x + i, rx);
+		simdStoreAligned(out->y + i, ry);
+		simdStoreAligned(out->z + i, rz);
+	}
+	for (; i < n; ++i) {
+		Vector3 r = crossProduct(a.get(i), b.get(i));
+		out->set(i, r);
+	}
+}
+
+//out[i] = a[i] * b[i]
+void dotProduct(const Vector3Array& a, const Vector3Array& b, float* out) {
+	assert(a.size() == b.size());
+	const size_t n = a.size();
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat xx = simdMul(simdLoadAligned(a.x + i), simdLoadAligned(b.x + i));
+		SimdFloat yy = simdMul(simdLoadAligned(a.y + i), simdLoadAligned(b.y + i));
+		SimdFloat zz = simdMul(simdLoadAligned(a.z + i), simdLoadAligned(b.z + i));
+		simdStore(out + i, simdAdd(simdAdd(xx, yy), zz));
+	}
+	for (; i < n; ++i) {
+		out[i] = a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i];
+	}
+}
+
+//out[i] = vectorMag(a[i])
+//˳vectorMag()ͬλһ
+void vectorMag(const Vector3Array& a, float* out) {
+	const size_t n = a.size();
+	const size_t simdEnd = n - n % kSimdWidth;
+	size_t i = 0;
+	for (; i < simdEnd; i += kSimdWidth) {
+		SimdFloat vx = simdLoadAligned(a.x + i);
+		SimdFloat vy = simdLoadAligned(a.y + i);
+		SimdFloat vz = simdLoadAligned(a.z + i);
+		SimdFloat sumOfSquare = simdAdd(simdAdd(simdMul(vx, vx), simdMul(vy, vy)), simdMul(vz, vz));
+		simdStore(out + i, simdSqrt(sumOfSquare));
+	}
+	for (; i < n; ++i) {
+		out[i] = sqrt(a.x[i] * a.x[i] + a.y[i] * a.y[i] + a.z[i] * a.z[i]);
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#ifndef __VECTOR3ARRAY_H_INCLUDED__
+#define __VECTOR3ARRAY_H_INCLUDED__
+
+#include <stddef.h>
+
+template <typename T> class Vector3T;
+typedef Vector3T<float> Vector3;
+
+// ƣ3D
+// ߣcary
+// SoAʽһ3Dxyzֱ
+//		SIMDʵ֣Vector3һ
+
+class Vector3Array
+{
+public:
+	float* x;
+	float* y;
+	float* z;
+
+	Vector3Array();
+	explicit Vector3Array(size_t n);
+	Vector3Array(const Vector3Array& a);
+	~Vector3Array();
+
+	Vector3Array& operator =(const Vector3Array& a);
+
+	//
+	size_t size() const { return count; }
+
+	//ıԭеݱĲδʼ
+	void resize(size_t n);
+
+	//д
+	Vector3 get(size_t i) const;
+	void set(size_t i, const Vector3& v);
+
+	//AoS֮ת
+	//v[0..n)룬СΪn
+	void fromVector3s(const Vector3* v, size_t n);
+	//дv[0..size())
+	void toVector3s(Vector3* v) const;
+
+	//ȫ
+	void zero();
+
+	//׼Vector3::normalize()ֲͬ
+	void normalize();
+
+private:
+	size_t count;
+	size_t capacity;
+	//һڴ
+	float* buffer;
+};
+
+//㣬out Ժͬһ飬outĴСͬ
+//out[i] = a[i] + b[i]
+void add(const Vector3Array& a, const Vector3Array& b, Vector3Array* out);
+//out[i] = a[i] - b[i]
+void subtract(const Vector3Array& a, const Vector3Array& b, Vector3Array* out);
+//out[i] = a[i] * k
+void scale(const Vector3Array& a, float k, Vector3Array* out);
+//out[i] = crossProduct(a[i], b[i])
+void crossProduct(const Vector3Array& a, const Vector3Array& b, Vector3Array* out);
+
+//Ϊ㣬out Ҫ a.size() Ԫ
+//out[i] = a[i] * b[i]
+void dotProduct(const Vector3Array& a, const Vector3Array& b, float* out);
+//out[i] = vectorMag(a[i])
+void vectorMag(const Vector3Array& a, float* out);
+
+#endif // #ifndef __VECTOR3ARRAY_H_INCLUDED__
@@ -0,0 +1,292 @@
+#include <stdlib.h>
+#include <vector>
+
+#include "Benchmark.h"
+#include "AABB3.h"
+#include "AABB3Array.h"
+#include "Matrix4x3.h"
+
+// ƣAABBܲ
+// ߣcary
+// AABBȫѯÿѯnAABBһ
+//		ཻAABB任ཻ̬͵㡢AABBѯȽ汾õ汾
+
+static float randomFloat() {
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+static AABB3 randomBox() {
+	AABB3 box;
+	box.min = Vector3(randomFloat(), randomFloat(), randomFloat()) * 4.0f;
+	box.max = box.min + Vector3(randomFloat() + 1.5f, randomFloat() + 1.5f, randomFloat() + 1.5f);
+	return box;
+}
+
+void benchmarkAABB3() {
+	printf("== AABB3\n");
+	for (size_t level = 0; level < kCacheLevelCount; ++level) {
+		const CacheLevel& cache = kCacheLevels[level];
+		//ֹ˶AABB㣬ߺ;룬ԼһAABB
+		const size_t n = itemsForCacheLevel(cache, sizeof(AABB3) * 3 + sizeof(Vector3) * 2 + sizeof(Matrix4x3));
+		std::vector<Vector3> org(n), delta(n);
+		std::vector<AABB3> boxes(n), moving(n), boxOut(n);
+		std::vector<Matrix4x3> matrices(n);
+		for (size_t i = 0; i < n; ++i) {
+			org[i] = Vector3(randomFloat(), randomFloat(), randomFloat()) * 8.0f;
+			delta[i] = Vector3(randomFloat(), randomFloat(), randomFloat()) * 16.0f;
+			boxes[i] = randomBox();
+			moving[i] = randomBox();
+		}
+		Vector3Array orgArray, deltaArray, normal;
+		orgArray.fromVector3s(org.data(), n);
+		deltaArray.fromVector3s(delta.data(), n);
+		AABB3Array boxArray, movingArray;
+		boxArray.fromAABB3s(boxes.data(), n);
+		movingArray.fromAABB3s(moving.data(), n);
+		//ÿ˶AABB16Զ
+		const size_t kPairsPerMover = 16;
+		const size_t moverCount = n / kPairsPerMover;
+		std::vector<int> firstPair(moverCount + 1);
+		for (size_t k = 0; k <= moverCount; ++k) {
+			firstPair[k] = (int)(k * kPairsPerMover);
+		}
+		std::vector<float> moverT(moverCount);
+		std::vector<int> moverPair(moverCount);
+		std::vector<float> t(n);
+		std::vector<int> result(n);
+		std::vector<uint32_t> mask((n + 31) / 32);
+		std::vector<Vector3> pointOut(n);
+		const AABB3 box = boxes[0];
+		const Vector3 rayOrg = org[0], rayDelta = delta[0];
+		const Vector3 rayDeltaInv(1.0f / rayDelta.x, 1.0f / rayDelta.y, 1.0f / rayDelta.z);
+		const Vector3 planeN(0.0f, 0.6f, 0.8f);
+		Matrix4x3 m;
+		m.setupRotate(planeN, 0.5f);
+		m.tx = 1.0f;
+		m.ty = 2.0f;
+		m.tz = 3.0f;
+		for (size_t i = 0; i < n; ++i) {
+			matrices[i].setupRotate(planeN, randomFloat() * kPi);
+			matrices[i].tx = org[i].x;
+			matrices[i].ty = org[i].y;
+			matrices[i].tz = org[i].z;
+		}
+		AABB3Array boxArrayOut;
+		Vector3Array pointArrayOut;
+
+		reportBenchmark("isEmpty", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				result[i] = boxes[i].isEmpty();
+			}
+			gBenchmarkSink = (float)result[n - 1];
+		}));
+		reportBenchmark("corner", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				pointOut[i] = boxes[i].corner((int)(i & 7));
+			}
+			gBenchmarkSink = pointOut[n - 1].x;
+		}));
+		reportBenchmark("add(Vector3)", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				boxOut[i] = boxes[i];
+				boxOut[i].add(org[i]);
+			}
+			gBenchmarkSink = boxOut[n - 1].min.x;
+		}));
+		reportBenchmark("add(AABB3)", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				boxOut[i] = boxes[i];
+				boxOut[i].add(box);
+			}
+			gBenchmarkSink = boxOut[n - 1].min.x;
+		}));
+		reportBenchmark("setToTransFormedBox", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				boxOut[i].setToTransFormedBox(boxes[i], m);
+			}
+			gBenchmarkSink = boxOut[n - 1].min.x;
+		}));
+		reportBenchmark("transformBoxes(boxes, m)", cache, n, measureSeconds([&]() {
+			transformBoxes(boxArray, &boxArrayOut, m);
+			gBenchmarkSink = boxArrayOut.min.x[n - 1];
+		}));
+		reportBenchmark("n matrices, setToTransFormedBox", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				boxOut[i].setToTransFormedBox(boxes[i], matrices[i]);
+			}
+			gBenchmarkSink = boxOut[n - 1].min.x;
+		}));
+		reportBenchmark("n matrices, transformBoxes(boxes, m[])", cache, n, measureSeconds([&]() {
+			transformBoxes(boxArray, &boxArrayOut, matrices.data());
+			gBenchmarkSink = boxArrayOut.min.x[n - 1];
+		}));
+		reportBenchmark("contains", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				result[i] = boxes[i].contains(org[i]);
+			}
+			gBenchmarkSink = (float)result[n - 1];
+		}));
+		reportBenchmark("closestPointTo", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				pointOut[i] = boxes[i].closestPointTo(org[i]);
+			}
+			gBenchmarkSink = pointOut[n - 1].x;
+		}));
+		reportBenchmark("intersectsSphere", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				result[i] = boxes[i].intersectsSphere(org[i], 2.0f);
+			}
+			gBenchmarkSink = (float)result[n - 1];
+		}));
+		reportBenchmark("classifyPlane", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				result[i] = boxes[i].classifyPlane(planeN, 1.0f);
+			}
+			gBenchmarkSink = (float)result[n - 1];
+		}));
+		reportBenchmark("intersectPlane", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				t[i] = boxes[i].intersectPlane(planeN, 1.0f, delta[i]);
+			}
+			gBenchmarkSink = t[n - 1];
+		}));
+		reportBenchmark("intersectAABBs", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				result[i] = intersectAABBs(box, boxes[i]);
+			}
+			gBenchmarkSink = (float)result[n - 1];
+		}));
+		reportBenchmark("intersectAABBs + boxIntersect", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				result[i] = intersectAABBs(box, boxes[i], &boxOut[i]);
+			}
+			gBenchmarkSink = (float)result[n - 1];
+		}));
+		//һѯnAABB汾±дresultУ汾ͬ
+		const Vector3 p = org[0];
+		reportBenchmark("n boxes, AABB3::contains -> indices", cache, n, measureSeconds([&]() {
+			size_t count = 0;
+			for (size_t i = 0; i < n; ++i) {
+				if (boxes[i].contains(p)) {
+					result[count++] = (int)i;
+				}
+			}
+			gBenchmarkSink = (float)count;
+		}));
+		reportBenchmark("n boxes, contains(boxes, p) -> mask", cache, n, measureSeconds([&]() {
+			gBenchmarkSink = (float)contains(boxArray, p, mask.data());
+		}));
+		reportBenchmark("n boxes, contains(boxes, p) -> indices", cache, n, measureSeconds([&]() {
+			gBenchmarkSink = (float)contains(boxArray, p, NULL, result.data());
+		}));
+		reportBenchmark("n boxes, AABB3::intersectsSphere -> indices", cache, n, measureSeconds([&]() {
+			size_t count = 0;
+			for (size_t i = 0; i < n; ++i) {
+				if (boxes[i].intersectsSphere(p, 2.0f)) {
+					result[count++] = (int)i;
+				}
+			}
+			gBenchmarkSink = (float)count;
+		}));
+		reportBenchmark("n boxes, intersectsSphere(boxes) -> mask", cache, n, measureSeconds([&]() {
+			gBenchmarkSink = (float)intersectsSphere(boxArray, p, 2.0f, mask.data());
+		}));
+		reportBenchmark("n boxes, intersectsSphere(boxes) -> indices", cache, n, measureSeconds([&]() {
+			gBenchmarkSink = (float)intersectsSphere(boxArray, p, 2.0f, NULL, result.data());
+		}));
+		reportBenchmark("n boxes, intersectAABBs -> indices", cache, n, measureSeconds([&]() {
+			size_t count = 0;
+			for (size_t i = 0; i < n; ++i) {
+				if (intersectAABBs(box, boxes[i])) {
+					result[count++] = (int)i;
+				}
+			}
+			gBenchmarkSink = (float)count;
+		}));
+		reportBenchmark("n boxes, intersectAABBs(boxes, box) -> mask", cache, n, measureSeconds([&]() {
+			gBenchmarkSink = (float)intersectAABBs(boxArray, box, mask.data());
+		}));
+		reportBenchmark("n boxes, intersectAABBs(boxes, box) -> indices", cache, n, measureSeconds([&]() {
+			gBenchmarkSink = (float)intersectAABBs(boxArray, box, NULL, result.data());
+		}));
+		reportBenchmark("n boxes, AABB3::closestPointTo", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				pointOut[i] = boxes[i].closestPointTo(p);
+			}
+			gBenchmarkSink = pointOut[n - 1].x;
+		}));
+		reportBenchmark("n boxes, closestPointTo(boxes, p)", cache, n, measureSeconds([&]() {
+			closestPointTo(boxArray, p, &pointArrayOut);
+			gBenchmarkSink = pointArrayOut.x[n - 1];
+		}));
+		reportBenchmark("n pairs, intersectMovingAABB", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				t[i] = intersectMovingAABB(boxes[i], moving[i], delta[i]);
+			}
+			gBenchmarkSink = t[n - 1];
+		}));
+		reportBenchmark("n pairs, intersectMovingAABBs", cache, n, measureSeconds([&]() {
+			intersectMovingAABBs(boxArray, movingArray, deltaArray, t.data());
+			gBenchmarkSink = t[n - 1];
+		}));
+		reportBenchmark("n pairs, earliest per mover, scalar", cache, n, measureSeconds([&]() {
+			for (size_t k = 0; k < moverCount; ++k) {
+				float best = kNoIntersection;
+				int bestPair = -1;
+				for (int i = firstPair[k]; i < firstPair[k + 1]; ++i) {
+					float r = intersectMovingAABB(boxes[i], moving[i], delta[i]);
+					if (r < best) {
+						best = r;
+						bestPair = i;
+					}
+				}
+				moverT[k] = best;
+				moverPair[k] = bestPair;
+			}
+			gBenchmarkSink = moverT[moverCount - 1];
+		}));
+		reportBenchmark("n pairs, intersectMovingAABBs + earliestHits", cache, n, measureSeconds([&]() {
+			intersectMovingAABBs(boxArray, movingArray, deltaArray, t.data());
+			earliestHits(t.data(), firstPair.data(), moverCount, moverT.data(), moverPair.data());
+			gBenchmarkSink = moverT[moverCount - 1];
+		}));
+		reportBenchmark("n boxes, earliest intersectMovingAABB", cache, n, measureSeconds([&]() {
+			float best = kNoIntersection;
+			for (size_t i = 0; i < n; ++i) {
+				float r = intersectMovingAABB(boxes[i], moving[0], delta[0]);
+				if (r < best) {
+					best = r;
+				}
+			}
+			gBenchmarkSink = best;
+		}));
+		reportBenchmark("n boxes, intersectMovingAABB(boxes, box)", cache, n, measureSeconds([&]() {
+			gBenchmarkSink = intersectMovingAABB(boxArray, moving[0], delta[0]);
+		}));
+
+		reportBenchmark("n rays, AABB3::rayIntersect", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				t[i] = box.rayIntersect(org[i], delta[i]);
+			}
+			gBenchmarkSink = t[n - 1];
+		}));
+		reportBenchmark("n rays, rayIntersect(box, rays)", cache, n, measureSeconds([&]() {
+			rayIntersect(box, orgArray, deltaArray, t.data());
+			gBenchmarkSink = t[n - 1];
+		}));
+		reportBenchmark("n rays, rayIntersect + normal", cache, n, measureSeconds([&]() {
+			rayIntersect(box, orgArray, deltaArray, t.data(), &normal);
+			gBenchmarkSink = t[n - 1];
+		}));
+		reportBenchmark("n boxes, AABB3::rayIntersect", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				t[i] = boxes[i].rayIntersect(rayOrg, rayDelta);
+			}
+			gBenchmarkSink = t[n - 1];
+		}));
+		reportBenchmark("n boxes, rayIntersect(boxes, ray)", cache, n, measureSeconds([&]() {
+			rayIntersect(boxArray, rayOrg, rayDelta, rayDeltaInv, t.data());
+			gBenchmarkSink = t[n - 1];
+		}));
+	}
+}
@@ -0,0 +1,113 @@
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+#include "Benchmark.h"
+#include "AnimationClip.h"
+#include "Quaternion.h"
+#include "EulerAngles.h"
+
+// ƣܲ
+// ߣcary
+// 5000ʵͬʱͬһƬΣÿһ֡ÿʵǰ1/60룬ȫ
+//		Ƚÿֲҹؼ֡ٵslerp()αܣ
+//		Լÿζʱ䣨αʧЧʱ
+//		Ƭ64ת64ƽƹ2룬ؼ֡ÿ860ʱ
+
+static float randomFloat() {
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+void benchmarkAnimation() {
+	printf("== Animation\n");
+	const size_t kInstanceCount = 5000;
+	const size_t kTrackCount = 64;
+	const float kDuration = 2.0f;
+	const float kFrameTime = 1.0f / 60.0f;
+
+	AnimationClip clip;
+	std::vector<std::vector<float> > rotationTimes(kTrackCount), translationTimes(kTrackCount);
+	std::vector<std::vector<Quaternion> > rotationKeys(kTrackCount);
+	std::vector<std::vector<Vector3> > translationKeys(kTrackCount);
+	for (size_t i = 0; i < kTrackCount; ++i) {
+		size_t count = 8 + rand() % 53;
+		//[0, kDuration]ȡcount - 2ʱ䣬
+		std::vector<float> times(count);
+		times[0] = 0.0f;
+		times[count - 1] = kDuration;
+		for (size_t k = 1; k + 1 < count; ++k) {
+			times[k] = (randomFloat() * 0.5f + 0.5f) * kDuration;
+		}
+		std::sort(times.begin(), times.end());
+		times.erase(std::unique(times.begin(), times.end()), times.end());
+		rotationTimes[i] = times;
+		translationTimes[i] = times;
+		for (size_t k = 0; k < times.size(); ++k) {
+			Quaternion q;
+			q.setToRotationObjectToInertial(EulerAngles(randomFloat() * kPi, randomFloat() * kPiOver2, randomFloat() * kPi));
+			rotationKeys[i].push_back(q);
+			translationKeys[i].push_back(Vector3(randomFloat(), randomFloat(), randomFloat()));
+		}
+		clip.addRotationTrack(&rotationTimes[i][0], &rotationKeys[i][0], times.size());
+		clip.addTranslationTrack(&translationTimes[i][0], &translationKeys[i][0], times.size());
+	}
+
+	std::vector<float> times(kInstanceCount);
+	for (size_t i = 0; i < kInstanceCount; ++i) {
+		times[i] = (randomFloat() * 0.5f + 0.5f) * kDuration;
+	}
+	std::vector<uint32_t> cursors(kInstanceCount * clip.cursorCount(), 0);
+	std::vector<Quaternion> rotations(kInstanceCount * kTrackCount);
+	std::vector<Vector3> translations(kInstanceCount * kTrackCount);
+	//ÿʵǰһ֡ѭ
+	auto advance = [&]() {
+		for (size_t i = 0; i < kInstanceCount; ++i) {
+			times[i] += kFrameTime;
+			if (times[i] >= kDuration) {
+				times[i] -= kDuration;
+			}
+		}
+	};
+	const size_t items = kInstanceCount * kTrackCount * 2;
+	printf("%zu instances, %zu rotation + %zu translation tracks\n", kInstanceCount, kTrackCount, kTrackCount);
+
+	double binarySearch = measureSeconds([&]() {
+		advance();
+		for (size_t i = 0; i < kInstanceCount; ++i) {
+			const float time = times[i];
+			for (size_t j = 0; j < kTrackCount; ++j) {
+				const std::vector<float>& t = rotationTimes[j];
+				size_t k = std::upper_bound(t.begin() + 1, t.end() - 1, time) - t.begin() - 1;
+				float fraction = std::min(std::max((time - t[k]) / (t[k + 1] - t[k]), 0.0f), 1.0f);
+				rotations[i * kTrackCount + j] = slerp(rotationKeys[j][k], rotationKeys[j][k + 1], fraction);
+			}
+			for (size_t j = 0; j < kTrackCount; ++j) {
+				const std::vector<float>& t = translationTimes[j];
+				size_t k = std::upper_bound(t.begin() + 1, t.end() - 1, time) - t.begin() - 1;
+				float fraction = std::min(std::max((time - t[k]) / (t[k + 1] - t[k]), 0.0f), 1.0f);
+				const Vector3& a = translationKeys[j][k];
+				const Vector3& b = translationKeys[j][k + 1];
+				translations[i * kTrackCount + j] = a + (b - a) * fraction;
+			}
+		}
+		gBenchmarkSink = rotations[0].w + translations[0].x;
+	});
+	reportBenchmark("binary search + slerp", items, binarySearch);
+	double cached = measureSeconds([&]() {
+		advance();
+		clip.sample(times.data(), cursors.data(), kInstanceCount, rotations.data(), translations.data());
+		gBenchmarkSink = rotations[0].w + translations[0].x;
+	});
+	reportBenchmark("sample, cached cursors", items, cached);
+	double seek = measureSeconds([&]() {
+		for (size_t i = 0; i < kInstanceCount; ++i) {
+			times[i] = (float)rand() / RAND_MAX * kDuration;
+		}
+		clip.sample(times.data(), cursors.data(), kInstanceCount, rotations.data(), translations.data());
+		gBenchmarkSink = rotations[0].w + translations[0].x;
+	});
+	reportBenchmark("sample, random seek", items, seek);
+	printf("per frame: %.2f ms (binary search + slerp), %.2f ms (cached cursors), %.2f ms (random seek)\n",
+		binarySearch * 1e3, cached * 1e3, seek * 1e3);
+}
@@ -0,0 +1,140 @@
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "Benchmark.h"
+#include "BVH.h"
+
+// ƣΰΧܲ
+// ߣcary
+// ȽBVHĹʱ䣬ԼߡAABBƽѯԣ
+
+static float randomFloat() {
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+void benchmarkBVH() {
+	printf("== BVH\n");
+	const size_t kCounts[] = { 65536, 1048576 };
+	const size_t kQueryCount = 256;
+	for (size_t c = 0; c < sizeof(kCounts) / sizeof(kCounts[0]); ++c) {
+		const size_t n = kCounts[c];
+		//ȷֲڱ߳Ϊ1000
+		std::vector<AABB3> boxes(n);
+		for (size_t i = 0; i < n; ++i) {
+			Vector3 center(randomFloat() * 500.0f, randomFloat() * 500.0f, randomFloat() * 500.0f);
+			Vector3 extent(fabs(randomFloat()) + 0.5f, fabs(randomFloat()) + 0.5f, fabs(randomFloat()) + 0.5f);
+			boxes[i].min = center - extent;
+			boxes[i].max = center + extent;
+		}
+		std::vector<Vector3> rayOrg(kQueryCount), rayDelta(kQueryCount);
+		std::vector<AABB3> queryBoxes(kQueryCount);
+		std::vector<Vector3> planeNormal(kQueryCount);
+		for (size_t i = 0; i < kQueryCount; ++i) {
+			rayOrg[i] = Vector3(randomFloat(), randomFloat(), randomFloat()) * 500.0f;
+			rayDelta[i] = Vector3(randomFloat(), randomFloat(), randomFloat()) * 1000.0f;
+			queryBoxes[i].min = rayOrg[i] - Vector3(10.0f, 10.0f, 10.0f);
+			queryBoxes[i].max = rayOrg[i] + Vector3(10.0f, 10.0f, 10.0f);
+			planeNormal[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+			planeNormal[i].normalize();
+		}
+		std::vector<int> result;
+		result.reserve(n);
+
+		BVH bvh;
+		double buildSingle = measureSeconds([&]() {
+			bvh.build(boxes.data(), NULL, n, 1);
+		});
+		reportBenchmark("build, 1 thread", n, buildSingle);
+		double buildParallel = measureSeconds([&]() {
+			bvh.build(boxes.data(), NULL, n);
+		});
+		reportBenchmark("build, all threads", n, buildParallel);
+
+		//ÿβѯҪȫ壬ֻѯ
+		const size_t bruteCount = 8;
+		double bruteRay = measureSeconds([&]() {
+			for (size_t q = 0; q < bruteCount; ++q) {
+				float best = kNoIntersection;
+				for (size_t i = 0; i < n; ++i) {
+					float t = boxes[i].rayIntersect(rayOrg[q], rayDelta[q]);
+					if (t < best) {
+						best = t;
+					}
+				}
+				gBenchmarkSink = best;
+			}
+		});
+		reportBenchmark("ray, brute force", bruteCount, bruteRay);
+		double bvhRay = measureSeconds([&]() {
+			for (size_t q = 0; q < kQueryCount; ++q) {
+				gBenchmarkSink = bvh.rayIntersect(rayOrg[q], rayDelta[q]);
+			}
+		});
+		reportBenchmark("ray, BVH", kQueryCount, bvhRay);
+
+		double bruteBox = measureSeconds([&]() {
+			for (size_t q = 0; q < bruteCount; ++q) {
+				result.clear();
+				for (size_t i = 0; i < n; ++i) {
+					if (intersectAABBs(boxes[i], queryBoxes[q])) {
+						result.push_back((int)i);
+					}
+				}
+				gBenchmarkSink = (float)result.size();
+			}
+		});
+		reportBenchmark("AABB, brute force", bruteCount, bruteBox);
+		double bvhBox = measureSeconds([&]() {
+			for (size_t q = 0; q < kQueryCount; ++q) {
+				result.clear();
+				bvh.queryAABB(queryBoxes[q], &result);
+				gBenchmarkSink = (float)result.size();
+			}
+		});
+		reportBenchmark("AABB, BVH", kQueryCount, bvhBox);
+
+		double bruteSphere = measureSeconds([&]() {
+			for (size_t q = 0; q < bruteCount; ++q) {
+				result.clear();
+				for (size_t i = 0; i < n; ++i) {
+					if (boxes[i].intersectsSphere(rayOrg[q], 10.0f)) {
+						result.push_back((int)i);
+					}
+				}
+				gBenchmarkSink = (float)result.size();
+			}
+		});
+		reportBenchmark("sphere, brute force", bruteCount, bruteSphere);
+		double bvhSphere = measureSeconds([&]() {
+			for (size_t q = 0; q < kQueryCount; ++q) {
+				result.clear();
+				bvh.querySphere(rayOrg[q], 10.0f, &result);
+				gBenchmarkSink = (float)result.size();
+			}
+		});
+		reportBenchmark("sphere, BVH", kQueryCount, bvhSphere);
+
+		//ƽѯֻռƽ
+		double brutePlane = measureSeconds([&]() {
+			for (size_t q = 0; q < bruteCount; ++q) {
+				result.clear();
+				for (size_t i = 0; i < n; ++i) {
+					if (boxes[i].classifyPlane(planeNormal[q], 0.0f) == 0) {
+						result.push_back((int)i);
+					}
+				}
+				gBenchmarkSink = (float)result.size();
+			}
+		});
+		reportBenchmark("plane, brute force", bruteCount, brutePlane);
+		double bvhPlane = measureSeconds([&]() {
+			for (size_t q = 0; q < bruteCount; ++q) {
+				result.clear();
+				bvh.classifyPlane(planeNormal[q], 0.0f, NULL, NULL, &result);
+				gBenchmarkSink = (float)result.size();
+			}
+		});
+		reportBenchmark("plane, BVH", bruteCount, bvhPlane);
+	}
+}
@@ -0,0 +1,103 @@
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+#include "Benchmark.h"
+#include "AABB3.h"
+#include "AABB3Array.h"
+#include "Frustum.h"
+#include "Matrix4x3.h"
+
+// ƣ׶üܲ
+// ߣcary
+// ȽAABBFrustum::classifyAABB()SIMDü
+//		ԼϴξܾƽƽĲ
+//		üһAABBһԣڵAABBڿռҲʱϴξܾƽͬ
+//		Էֱ˳ͰռAABB
+
+static float randomFloat() {
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+void benchmarkFrustum() {
+	printf("== Frustum\n");
+	const size_t n = 1048576;
+	//ȷֲڱ߳Ϊ1000Уģ󲿷׶
+	std::vector<AABB3> boxes(n);
+	for (size_t i = 0; i < n; ++i) {
+		Vector3 center(randomFloat() * 500.0f, randomFloat() * 500.0f, randomFloat() * 500.0f);
+		Vector3 extent(fabs(randomFloat()) + 0.5f, fabs(randomFloat()) + 0.5f, fabs(randomFloat()) + 0.5f);
+		boxes[i].min = center - extent;
+		boxes[i].max = center + extent;
+	}
+	AABB3Array boxArray;
+	boxArray.fromAABB3s(boxes.data(), n);
+
+	//yת30
+	Matrix4x3 worldToCamera;
+	float s = sinf(0.5236f), c = cosf(0.5236f);
+	worldToCamera.m11 = c;    worldToCamera.m12 = 0.0f; worldToCamera.m13 = s;
+	worldToCamera.m21 = 0.0f; worldToCamera.m22 = 1.0f; worldToCamera.m23 = 0.0f;
+	worldToCamera.m31 = -s;   worldToCamera.m32 = 0.0f; worldToCamera.m33 = c;
+	worldToCamera.tx = 0.0f;  worldToCamera.ty = 0.0f;  worldToCamera.tz = 0.0f;
+	Frustum frustum;
+	frustum.setupFromView(worldToCamera, 1.5f, 16.0f / 9.0f, 0.1f, 400.0f);
+
+	std::vector<signed char> result(n);
+	std::vector<unsigned char> returnMask(n);
+	std::vector<unsigned char> lastPlane(n, kFrustumNoPlane);
+
+	double scalar = measureSeconds([&]() {
+		for (size_t i = 0; i < n; ++i) {
+			result[i] = (signed char)frustum.classifyAABB(boxes[i]);
+		}
+	});
+	reportBenchmark("classifyAABB, scalar", n, scalar);
+	double scalarCached = measureSeconds([&]() {
+		for (size_t i = 0; i < n; ++i) {
+			result[i] = (signed char)frustum.classifyAABB(boxes[i], kFrustumAllPlanes, NULL, &lastPlane[i]);
+		}
+	});
+	reportBenchmark("classifyAABB, scalar, last plane", n, scalarCached);
+
+	double simd = measureSeconds([&]() {
+		cullAABBs(frustum, boxArray, result.data());
+	});
+	reportBenchmark("cullAABBs", n, simd);
+	double simdMask = measureSeconds([&]() {
+		cullAABBs(frustum, boxArray, result.data(), kFrustumAllPlanes, returnMask.data());
+	});
+	reportBenchmark("cullAABBs, return mask", n, simdMask);
+	std::fill(lastPlane.begin(), lastPlane.end(), kFrustumNoPlane);
+	double simdCached = measureSeconds([&]() {
+		cullAABBs(frustum, boxArray, result.data(), kFrustumAllPlanes, NULL, lastPlane.data());
+	});
+	reportBenchmark("cullAABBs, last plane", n, simdCached);
+	//ڵѾڽüԶü֮䣬ֻĸ
+	const unsigned sideMask = kFrustumAllPlanes & ~((1u << kFrustumNear) | (1u << kFrustumFar));
+	double simdSides = measureSeconds([&]() {
+		cullAABBs(frustum, boxArray, result.data(), sideMask, NULL, lastPlane.data());
+	});
+	reportBenchmark("cullAABBs, last plane, 4 planes", n, simdSides);
+
+	//߳Ϊ64ͬһеAABB
+	std::sort(boxes.begin(), boxes.end(), [](const AABB3& a, const AABB3& b) {
+		int ax = (int)floorf(a.min.x / 64.0f), ay = (int)floorf(a.min.y / 64.0f), az = (int)floorf(a.min.z / 64.0f);
+		int bx = (int)floorf(b.min.x / 64.0f), by = (int)floorf(b.min.y / 64.0f), bz = (int)floorf(b.min.z / 64.0f);
+		if (ax != bx) {
+			return ax < bx;
+		}
+		return ay != by ? ay < by : az < bz;
+	});
+	boxArray.fromAABB3s(boxes.data(), n);
+	double sorted = measureSeconds([&]() {
+		cullAABBs(frustum, boxArray, result.data());
+	});
+	reportBenchmark("cullAABBs, grid order", n, sorted);
+	std::fill(lastPlane.begin(), lastPlane.end(), kFrustumNoPlane);
+	double sortedCached = measureSeconds([&]() {
+		cullAABBs(frustum, boxArray, result.data(), kFrustumAllPlanes, NULL, lastPlane.data());
+	});
+	reportBenchmark("cullAABBs, grid order, last plane", n, sortedCached);
+}
@@ -0,0 +1,215 @@
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "Benchmark.h"
+#include "LooseOctree.h"
+#include "Frustum.h"
+#include "Matrix4x3.h"
+
+// ƣɢ˲ܲ
+// ߣcary
+// ȽȫAABBɢ˲ߡ׶塢AABBѯ
+//		Լ˲ĲƶۡҪƵڵıռõڴ
+//		ȷֲ߳13֮䣬ÿ16һ10
+
+static float randomFloat() {
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+void benchmarkLooseOctree() {
+	printf("== LooseOctree\n");
+	const size_t kCounts[] = { 16384, 131072 };
+	const size_t kQueryCount = 1024;
+	//ĴۺȣֻԽٵ
+	const size_t kMaxBruteCount = 16384;
+	const float kRadius = 3.0f;
+	//ȣ16384ʱĵԪֱ߳Ϊ3282߳һΪ2
+	const int kDepths[] = { 4, 6, 8 };
+	for (size_t c = 0; c < sizeof(kCounts) / sizeof(kCounts[0]); ++c) {
+		const size_t n = kCounts[c];
+		//ռСӣܶȲ
+		const float halfSize = 10.0f * cbrtf((float)n);
+		std::vector<AABB3> boxes(n);
+		for (size_t i = 0; i < n; ++i) {
+			Vector3 center(randomFloat() * halfSize, randomFloat() * halfSize, randomFloat() * halfSize);
+			Vector3 extent(fabs(randomFloat()) + 0.5f, fabs(randomFloat()) + 0.5f, fabs(randomFloat()) + 0.5f);
+			if (i % 16 == 0) {
+				extent *= 10.0f;
+			}
+			boxes[i].min = center - extent;
+			boxes[i].max = center + extent;
+		}
+		std::vector<Vector3> points(kQueryCount), rayOrg(kQueryCount), rayDelta(kQueryCount);
+		std::vector<AABB3> queryBoxes(kQueryCount);
+		for (size_t i = 0; i < kQueryCount; ++i) {
+			points[i] = Vector3(randomFloat() * halfSize, randomFloat() * halfSize, randomFloat() * halfSize);
+			queryBoxes[i].min = points[i] - Vector3(3.0f, 3.0f, 3.0f);
+			queryBoxes[i].max = points[i] + Vector3(3.0f, 3.0f, 3.0f);
+			rayOrg[i] = Vector3(randomFloat() * halfSize, randomFloat() * halfSize, randomFloat() * halfSize);
+			rayDelta[i] = Vector3(randomFloat(), randomFloat(), randomFloat()) * halfSize;
+		}
+
+		//ģyת30ȣԼ1/20
+		Matrix4x3 worldToCamera;
+		float s = sinf(0.5236f), cs = cosf(0.5236f);
+		worldToCamera.m11 = cs;   worldToCamera.m12 = 0.0f; worldToCamera.m13 = s;
+		worldToCamera.m21 = 0.0f; worldToCamera.m22 = 1.0f; worldToCamera.m23 = 0.0f;
+		worldToCamera.m31 = -s;   worldToCamera.m32 = 0.0f; worldToCamera.m33 = cs;
+		worldToCamera.tx = 0.0f;  worldToCamera.ty = 0.0f;  worldToCamera.tz = 0.0f;
+		Frustum frustum;
+		frustum.setupFromView(worldToCamera, 1.5f, 16.0f / 9.0f, 0.1f, halfSize);
+		const Vector3 planeN(0.0f, 0.6f, 0.8f);
+
+		std::vector<int> result, back, spanning;
+		char label[64];
+		printf("%zu boxes, %zu queries\n", n, kQueryCount);
+
+		if (n <= kMaxBruteCount) {
+			reportBenchmark("rayIntersect, brute force", kQueryCount, measureSeconds([&]() {
+				float sum = 0.0f;
+				for (size_t q = 0; q < kQueryCount; ++q) {
+					float best = kNoIntersection;
+					for (size_t i = 0; i < n; ++i) {
+						float t = boxes[i].rayIntersect(rayOrg[q], rayDelta[q]);
+						if (t < best) {
+							best = t;
+						}
+					}
+					sum += best;
+				}
+				gBenchmarkSink = sum;
+			}));
+			reportBenchmark("querySphere, brute force", kQueryCount, measureSeconds([&]() {
+				result.clear();
+				for (size_t q = 0; q < kQueryCount; ++q) {
+					for (size_t i = 0; i < n; ++i) {
+						if (boxes[i].intersectsSphere(points[q], kRadius)) {
+							result.push_back((int)i);
+						}
+					}
+				}
+				gBenchmarkSink = (float)result.size();
+			}));
+			reportBenchmark("queryAABB, brute force", kQueryCount, measureSeconds([&]() {
+				result.clear();
+				for (size_t q = 0; q < kQueryCount; ++q) {
+					for (size_t i = 0; i < n; ++i) {
+						if (intersectAABBs(queryBoxes[q], boxes[i])) {
+							result.push_back((int)i);
+						}
+					}
+				}
+				gBenchmarkSink = (float)result.size();
+			}));
+		}
+		//׶ƽѯÿζҪȫ
+		reportBenchmark("queryFrustum, brute force", n, measureSeconds([&]() {
+			result.clear();
+			for (size_t i = 0; i < n; ++i) {
+				if (frustum.classifyAABB(boxes[i]) != kCullOutside) {
+					result.push_back((int)i);
+				}
+			}
+			gBenchmarkSink = (float)result.size();
+		}));
+		reportBenchmark("classifyPlane, brute force", n, measureSeconds([&]() {
+			result.clear();
+			back.clear();
+			spanning.clear();
+			for (size_t i = 0; i < n; ++i) {
+				int side = boxes[i].classifyPlane(planeN, 1.0f);
+				(side > 0 ? result : (side < 0 ? back : spanning)).push_back((int)i);
+			}
+			gBenchmarkSink = (float)spanning.size();
+		}));
+
+		for (size_t k = 0; k < sizeof(kDepths) / sizeof(kDepths[0]); ++k) {
+			const int depth = kDepths[k];
+			snprintf(label, sizeof(label), "insert all, depth %d", depth);
+			reportBenchmark(label, n, measureSeconds([&]() {
+				LooseOctree tree(Vector3(0.0f, 0.0f, 0.0f), halfSize, depth);
+				for (size_t i = 0; i < n; ++i) {
+					tree.add(boxes[i]);
+				}
+				gBenchmarkSink = (float)tree.size();
+			}));
+
+			LooseOctree tree(Vector3(0.0f, 0.0f, 0.0f), halfSize, depth);
+			for (size_t i = 0; i < n; ++i) {
+				tree.add(boxes[i]);
+			}
+			LooseOctree::Stats stats = tree.getStats();
+			printf("depth %d: %zu nodes, objects up to depth %d, %.1f bytes per object\n",
+				depth, stats.nodeCount, stats.maxDepth, (double)stats.memoryBytes / stats.objectCount);
+
+			snprintf(label, sizeof(label), "rayIntersect, depth %d", depth);
+			reportBenchmark(label, kQueryCount, measureSeconds([&]() {
+				float sum = 0.0f;
+				for (size_t q = 0; q < kQueryCount; ++q) {
+					sum += tree.rayIntersect(rayOrg[q], rayDelta[q]);
+				}
+				gBenchmarkSink = sum;
+			}));
+			snprintf(label, sizeof(label), "querySphere, depth %d", depth);
+			reportBenchmark(label, kQueryCount, measureSeconds([&]() {
+				result.clear();
+				for (size_t q = 0; q < kQueryCount; ++q) {
+					tree.querySphere(points[q], kRadius, &result);
+				}
+				gBenchmarkSink = (float)result.size();
+			}));
+			snprintf(label, sizeof(label), "queryAABB, depth %d", depth);
+			reportBenchmark(label, kQueryCount, measureSeconds([&]() {
+				result.clear();
+				for (size_t q = 0; q < kQueryCount; ++q) {
+					tree.queryAABB(queryBoxes[q], &result);
+				}
+				gBenchmarkSink = (float)result.size();
+			}));
+			snprintf(label, sizeof(label), "queryFrustum, depth %d", depth);
+			reportBenchmark(label, n, measureSeconds([&]() {
+				result.clear();
+				tree.queryFrustum(frustum, &result);
+				gBenchmarkSink = (float)result.size();
+			}));
+			snprintf(label, sizeof(label), "classifyPlane, depth %d", depth);
+			reportBenchmark(label, n, measureSeconds([&]() {
+				result.clear();
+				back.clear();
+				spanning.clear();
+				tree.classifyPlane(planeN, 1.0f, &result, &back, &spanning);
+				gBenchmarkSink = (float)spanning.size();
+			}));
+
+			//ÿƶһСξ룬󲿷ԭڵɢ߽
+			tree.resetUpdateStats();
+			snprintf(label, sizeof(label), "update, small moves, depth %d", depth);
+			reportBenchmark(label, n, measureSeconds([&]() {
+				for (size_t i = 0; i < n; ++i) {
+					AABB3 box = tree.getBox((int)i);
+					Vector3 d(randomFloat() * 0.05f, randomFloat() * 0.05f, randomFloat() * 0.05f);
+					box.min += d;
+					box.max += d;
+					tree.update((int)i, box);
+				}
+				gBenchmarkSink = (float)tree.size();
+			}));
+			stats = tree.getStats();
+			printf("%.2f%% of small moves relocated\n", 100.0 * stats.relocationCount / stats.updateCount);
+			//ÿƶһλ
+			tree.resetUpdateStats();
+			snprintf(label, sizeof(label), "update, teleport, depth %d", depth);
+			reportBenchmark(label, n, measureSeconds([&]() {
+				for (size_t i = 0; i < n; ++i) {
+					tree.update((int)i, boxes[rand() % n]);
+				}
+				gBenchmarkSink = (float)tree.size();
+			}));
+			stats = tree.getStats();
+			printf("%.2f%% of teleports relocated, %zu nodes, %.1f bytes per object\n",
+				100.0 * stats.relocationCount / stats.updateCount,
+				stats.nodeCount, (double)stats.memoryBytes / stats.objectCount);
+		}
+	}
+}
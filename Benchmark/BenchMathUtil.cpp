@@ -0,0 +1,116 @@
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "Benchmark.h"
+#include "MathUtil.h"
+
+// ƣѧܲ
+// ߣcary
+// ȽϿǺĸȵȼ汾ͱ׼⺯
+
+static float randomFloat() {
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+static const char* const kPrecisionNames[] = { "full", "medium", "low" };
+
+void benchmarkMathUtil() {
+	printf("== MathUtil\n");
+	char label[64];
+	for (size_t level = 0; level < kCacheLevelCount; ++level) {
+		const CacheLevel& cache = kCacheLevels[level];
+		//
+		const size_t n = itemsForCacheLevel(cache, sizeof(float) * 4);
+		std::vector<float> theta(n), x(n), y(n), out0(n), out1(n);
+		for (size_t i = 0; i < n; ++i) {
+			theta[i] = randomFloat() * 10.0f;
+			x[i] = randomFloat();
+			y[i] = randomFloat();
+		}
+
+		reportBenchmark("sinf + cosf", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out0[i] = sinf(theta[i]);
+				out1[i] = cosf(theta[i]);
+			}
+			gBenchmarkSink = out0[n - 1];
+		}));
+		reportBenchmark("acosf", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out0[i] = acosf(x[i]);
+			}
+			gBenchmarkSink = out0[n - 1];
+		}));
+		reportBenchmark("atan2f", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out0[i] = atan2f(y[i], x[i]);
+			}
+			gBenchmarkSink = out0[n - 1];
+		}));
+
+		for (int p = kPrecisionFull; p <= kPrecisionLow; ++p) {
+			const MathPrecision precision = (MathPrecision)p;
+			snprintf(label, sizeof(label), "fastSinCos, %s", kPrecisionNames[p]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				for (size_t i = 0; i < n; ++i) {
+					fastSinCos(&out0[i], &out1[i], theta[i], precision);
+				}
+				gBenchmarkSink = out0[n - 1];
+			}));
+			snprintf(label, sizeof(label), "fastAcos, %s", kPrecisionNames[p]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				for (size_t i = 0; i < n; ++i) {
+					out0[i] = fastAcos(x[i], precision);
+				}
+				gBenchmarkSink = out0[n - 1];
+			}));
+			snprintf(label, sizeof(label), "fastAsin, %s", kPrecisionNames[p]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				for (size_t i = 0; i < n; ++i) {
+					out0[i] = fastAsin(x[i], precision);
+				}
+				gBenchmarkSink = out0[n - 1];
+			}));
+			snprintf(label, sizeof(label), "fastAtan2, %s", kPrecisionNames[p]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				for (size_t i = 0; i < n; ++i) {
+					out0[i] = fastAtan2(y[i], x[i], precision);
+				}
+				gBenchmarkSink = out0[n - 1];
+			}));
+
+			snprintf(label, sizeof(label), "sinCosArray, %s", kPrecisionNames[p]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				sinCosArray(theta.data(), out0.data(), out1.data(), n, precision);
+				gBenchmarkSink = out0[n - 1];
+			}));
+			snprintf(label, sizeof(label), "acosArray, %s", kPrecisionNames[p]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				acosArray(x.data(), out0.data(), n, precision);
+				gBenchmarkSink = out0[n - 1];
+			}));
+			snprintf(label, sizeof(label), "asinArray, %s", kPrecisionNames[p]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				asinArray(x.data(), out0.data(), n, precision);
+				gBenchmarkSink = out0[n - 1];
+			}));
+			snprintf(label, sizeof(label), "atan2Array, %s", kPrecisionNames[p]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				atan2Array(y.data(), x.data(), out0.data(), n, precision);
+				gBenchmarkSink = out0[n - 1];
+			}));
+		}
+
+		reportBenchmark("warpPi", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out0[i] = warpPi(theta[i]);
+			}
+			gBenchmarkSink = out0[n - 1];
+		}));
+		reportBenchmark("warpPiArray", cache, n, measureSeconds([&]() {
+			warpPiArray(theta.data(), out0.data(), n);
+			gBenchmarkSink = out0[n - 1];
+		}));
+	}
+}
@@ -0,0 +1,271 @@
+#include <stdlib.h>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Matrix4x3.h"
+#include "Vector3.h"
+#include "EulerAngles.h"
+#include "RotationMatrix.h"
+#include "Quaternion.h"
+#include "CameraRelative.h"
+
+// ƣ4X3ܲ
+// ߣcary
+// ӡ任͸setup
+//		Ƚӡ任 operator* 
+//		ԼTRSƤ
+//		Χֱdouble任תΪԵfloat任
+
+static float randomFloat() {
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+static void randomMatrices(std::vector<Matrix4x3>& m) {
+	for (size_t i = 0; i < m.size(); ++i) {
+		float* p = &m[i].m11;
+		for (int j = 0; j < 12; ++j) {
+			p[j] = randomFloat();
+		}
+	}
+}
+
+void benchmarkMatrix4x3() {
+	printf("== Matrix4x3\n");
+	for (size_t level = 0; level < kCacheLevelCount; ++level) {
+		const CacheLevel& cache = kCacheLevels[level];
+		//һ
+		const size_t n = itemsForCacheLevel(cache, sizeof(Matrix4x3) * 3);
+		std::vector<Matrix4x3> a(n), b(n), out(n);
+		randomMatrices(a);
+		randomMatrices(b);
+		std::vector<Vector3> v(n), vOut(n);
+		std::vector<EulerAngles> euler(n);
+		std::vector<Quaternion> q(n);
+		std::vector<float> scalarOut(n), uniformScale(n);
+		for (size_t i = 0; i < n; ++i) {
+			v[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+			euler[i] = EulerAngles(randomFloat() * kPi, randomFloat() * kPiOver2, randomFloat() * kPi);
+			q[i].setToRotationObjectToInertial(euler[i]);
+			uniformScale[i] = randomFloat() + 2.0f;
+		}
+		RotationMatrix orient;
+		orient.setup(euler[0]);
+
+		reportBenchmark("operator*", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = a[i] * b[i];
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("concatenate(a[], b[])", cache, n, measureSeconds([&]() {
+			concatenate(a.data(), b.data(), out.data(), n);
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("concatenate(a, b[])", cache, n, measureSeconds([&]() {
+			concatenate(a[0], b.data(), out.data(), n);
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+
+		//ƤԪƽơţaΪ
+		reportBenchmark("TRS, fromQuaternion", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				Matrix4x3 m;
+				m.fromQuaternion(q[i]);
+				m.m11 *= v[i].x; m.m12 *= v[i].x; m.m13 *= v[i].x;
+				m.m21 *= v[i].y; m.m22 *= v[i].y; m.m23 *= v[i].y;
+				m.m31 *= v[i].z; m.m32 *= v[i].z; m.m33 *= v[i].z;
+				m.setTranslation(v[i]);
+				out[i] = m;
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("composeTRS", cache, n, measureSeconds([&]() {
+			composeTRS(q.data(), v.data(), v.data(), out.data(), n);
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("composeTRS, no scale", cache, n, measureSeconds([&]() {
+			composeTRS(q.data(), v.data(), NULL, out.data(), n);
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("TRS, fromQuaternion, bind pose", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				Matrix4x3 m;
+				m.fromQuaternion(q[i]);
+				m.m11 *= v[i].x; m.m12 *= v[i].x; m.m13 *= v[i].x;
+				m.m21 *= v[i].y; m.m22 *= v[i].y; m.m23 *= v[i].y;
+				m.m31 *= v[i].z; m.m32 *= v[i].z; m.m33 *= v[i].z;
+				m.setTranslation(v[i]);
+				out[i] = a[i] * m;
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("composeTRS, bind pose", cache, n, measureSeconds([&]() {
+			composeTRS(q.data(), v.data(), v.data(), out.data(), n, a.data());
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("composeTRSUniform, bind pose", cache, n, measureSeconds([&]() {
+			composeTRSUniform(q.data(), v.data(), uniformScale.data(), out.data(), n, a.data());
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+
+		reportBenchmark("Vector3 * Matrix4x3", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				vOut[i] = v[i] * a[0];
+			}
+			gBenchmarkSink = vOut[n - 1].x;
+		}));
+		reportBenchmark("transformPoints", cache, n, measureSeconds([&]() {
+			transformPoints(v.data(), vOut.data(), n, a[0]);
+			gBenchmarkSink = vOut[n - 1].x;
+		}));
+		reportBenchmark("transformVectors", cache, n, measureSeconds([&]() {
+			transformVectors(v.data(), vOut.data(), n, a[0]);
+			gBenchmarkSink = vOut[n - 1].x;
+		}));
+
+		//ԭԶ꣬double汾
+		const Vector3d cameraPos(1.0e6, 2.0e3, -3.0e6);
+		std::vector<Vector3d> worldPoints(n), worldOut(n);
+		std::vector<Matrix4x3d> localToWorld(n), worldOutMatrices(n);
+		for (size_t i = 0; i < n; ++i) {
+			worldPoints[i] = cameraPos + Vector3d(Vector3(v[i] * 100.0f));
+			const float* p = &a[i].m11;
+			double* d = &localToWorld[i].m11;
+			for (int j = 0; j < 12; ++j) {
+				d[j] = p[j];
+			}
+			localToWorld[i].setTranslation(worldPoints[i]);
+		}
+		Matrix4x3d worldToCamera;
+		worldToCamera.setupTranslation(-cameraPos);
+		reportBenchmark("Vector3d * Matrix4x3d", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				worldOut[i] = worldPoints[i] * worldToCamera;
+			}
+			gBenchmarkSink = (float)worldOut[n - 1].x;
+		}));
+		reportBenchmark("rebasePoints + transformPoints", cache, n, measureSeconds([&]() {
+			rebasePoints(worldPoints.data(), cameraPos, vOut.data(), n);
+			transformPoints(vOut.data(), vOut.data(), n, rebaseWorldToCamera(worldToCamera, cameraPos));
+			gBenchmarkSink = vOut[n - 1].x;
+		}));
+		reportBenchmark("Matrix4x3d operator*", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				worldOutMatrices[i] = localToWorld[i] * worldToCamera;
+			}
+			gBenchmarkSink = (float)worldOutMatrices[n - 1].tx;
+		}));
+		reportBenchmark("rebaseMatrices + concatenate", cache, n, measureSeconds([&]() {
+			rebaseMatrices(localToWorld.data(), cameraPos, out.data(), n);
+			concatenate(out.data(), rebaseWorldToCamera(worldToCamera, cameraPos), out.data(), n);
+			gBenchmarkSink = out[n - 1].tx;
+		}));
+
+		reportBenchmark("determinant", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				scalarOut[i] = determinant(a[i]);
+			}
+			gBenchmarkSink = scalarOut[n - 1];
+		}));
+		//ܽӽ죬ʹתźƽƹľ
+		composeTRSUniform(q.data(), v.data(), uniformScale.data(), b.data(), n);
+		reportBenchmark("inverse", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = inverse(b[i]);
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+
+		reportBenchmark("setupLocalToParent(EulerAngles)", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setupLocalToParent(v[i], euler[i]);
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("setupLocalToParent(RotationMatrix)", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setupLocalToParent(v[i], orient);
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("setupParentToLocal(EulerAngles)", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setupParentToLocal(v[i], euler[i]);
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("setupParentToLocal(RotationMatrix)", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setupParentToLocal(v[i], orient);
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("setupRotate(axis)", cache, n, measureSeconds([&]() {
+			AxisTypeEnum axis = y;
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setupRotate(axis, euler[i].heading);
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("setupRotate(Vector3)", cache, n, measureSeconds([&]() {
+			const Vector3 axis(0.0f, 0.6f, 0.8f);
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setupRotate(axis, euler[i].heading);
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("fromQuaternion", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i].fromQuaternion(q[i]);
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("setupScale", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setupScale(v[i]);
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("setuoSacleAlongAxis", cache, n, measureSeconds([&]() {
+			const Vector3 axis(0.0f, 0.6f, 0.8f);
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setuoSacleAlongAxis(axis, v[i].x);
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("setupShear", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setupShear(z, v[i].x, v[i].y);
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("setupProject", cache, n, measureSeconds([&]() {
+			const Vector3 normal(0.0f, 0.6f, 0.8f);
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setupProject(normal);
+				out[i].tx = v[i].x;
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("setupReflect(axis)", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setupReflect(x, v[i].x);
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("setupReflect(Vector3)", cache, n, measureSeconds([&]() {
+			const Vector3 normal(0.0f, 0.6f, 0.8f);
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setupReflect(normal);
+				out[i].tx = v[i].x;
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+		reportBenchmark("setupTranslation", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setupTranslation(v[i]);
+			}
+			gBenchmarkSink = out[n - 1].m11;
+		}));
+	}
+}
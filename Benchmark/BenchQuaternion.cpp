@@ -0,0 +1,164 @@
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Quaternion.h"
+#include "EulerAngles.h"
+#include "Vector3.h"
+#include "CompressedQuaternion.h"
+
+// ƣԪܲ
+// ߣcary
+// Ԫĳ˷ֵݺ͹캯
+//		˷Ƚ汾Լعתֹ˳
+//		ѹԪֱӸԪȽϣѹǶ
+
+static float randomFloat() {
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+void benchmarkQuaternion() {
+	printf("== Quaternion\n");
+	for (size_t level = 0; level < kCacheLevelCount; ++level) {
+		const CacheLevel& cache = kCacheLevels[level];
+		//ԪһԪһ
+		const size_t n = itemsForCacheLevel(cache, sizeof(Quaternion) * 3 + sizeof(float));
+		std::vector<Quaternion> a(n), b(n), out(n);
+		std::vector<EulerAngles> euler(n);
+		std::vector<float> t(n), scalarOut(n);
+		std::vector<int> parent(n);
+		for (size_t i = 0; i < n; ++i) {
+			euler[i] = EulerAngles(randomFloat() * kPi, randomFloat() * kPiOver2, randomFloat() * kPi);
+			a[i].setToRotationObjectToInertial(euler[i]);
+			b[i].setToRotationInertialToObject(euler[i]);
+			t[i] = randomFloat() * 0.5f + 0.5f;
+		}
+
+		reportBenchmark("operator*", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = a[i] * b[i];
+			}
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		reportBenchmark("operator*=", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = a[i];
+				out[i] *= b[i];
+			}
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		reportBenchmark("multiplyBatch", cache, n, measureSeconds([&]() {
+			multiplyBatch(a.data(), b.data(), out.data(), n);
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		//ĲͬһĹڣֻһ
+		for (int chain = 0; chain < 2; ++chain) {
+			for (size_t i = 0; i < n; ++i) {
+				parent[i] = i == 0 ? -1 : (chain ? (int)i - 1 : (int)((i - 1) / 4));
+			}
+			reportBenchmark(chain ? "hierarchy, chain, operator*" : "hierarchy, by level, operator*", cache, n, measureSeconds([&]() {
+				for (size_t i = 0; i < n; ++i) {
+					out[i] = parent[i] < 0 ? a[i] : a[i] * out[parent[i]];
+				}
+				gBenchmarkSink = out[n - 1].w;
+			}));
+			reportBenchmark(chain ? "hierarchy, chain, composeHierarchy" : "hierarchy, by level, composeHierarchy", cache, n, measureSeconds([&]() {
+				composeHierarchy(a.data(), parent.data(), out.data(), n);
+				gBenchmarkSink = out[n - 1].w;
+			}));
+		}
+		reportBenchmark("dotProduct", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				scalarOut[i] = dotProduct(a[i], b[i]);
+			}
+			gBenchmarkSink = scalarOut[n - 1];
+		}));
+		reportBenchmark("conjugate", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = conjugate(a[i]);
+			}
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		reportBenchmark("normalize", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = a[i];
+				out[i].normalize();
+			}
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		reportBenchmark("slerp", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = slerp(a[i], b[i], t[i]);
+			}
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		reportBenchmark("slerpBatch", cache, n, measureSeconds([&]() {
+			slerpBatch(a.data(), b.data(), t.data(), out.data(), n);
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		reportBenchmark("pow", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = pow(a[i], t[i]);
+			}
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		reportBenchmark("setQutaernionAboutAxis", cache, n, measureSeconds([&]() {
+			const Vector3 axis(0.0f, 0.6f, 0.8f);
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setQutaernionAboutAxis(axis, t[i]);
+			}
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		reportBenchmark("setToRotationObjectToInertial", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setToRotationObjectToInertial(euler[i]);
+			}
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		reportBenchmark("setToRotationObjectToInertial, medium", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setToRotationObjectToInertial(euler[i], kPrecisionMedium);
+			}
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		reportBenchmark("setToRotationInertialToObject", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i].setToRotationInertialToObject(euler[i]);
+			}
+			gBenchmarkSink = out[n - 1].w;
+		}));
+
+		std::vector<CompressedQuaternion48> packed48(n);
+		std::vector<CompressedQuaternion32> packed32(n);
+		compressQuaternions(a.data(), packed48.data(), n);
+		compressQuaternions(a.data(), packed32.data(), n);
+		reportBenchmark("copy Quaternion", cache, n, measureSeconds([&]() {
+			memcpy(out.data(), a.data(), n * sizeof(Quaternion));
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		reportBenchmark("decompressQuaternion, 48 bit", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = decompressQuaternion(packed48[i]);
+			}
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		reportBenchmark("decompressQuaternions, 48 bit", cache, n, measureSeconds([&]() {
+			decompressQuaternions(packed48.data(), out.data(), n);
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		float error48 = maxAngularError(a.data(), out.data(), n);
+		reportBenchmark("decompressQuaternion, 32 bit", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = decompressQuaternion(packed32[i]);
+			}
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		reportBenchmark("decompressQuaternions, 32 bit", cache, n, measureSeconds([&]() {
+			decompressQuaternions(packed32.data(), out.data(), n);
+			gBenchmarkSink = out[n - 1].w;
+		}));
+		float error32 = maxAngularError(a.data(), out.data(), n);
+		printf("max angular error: 48 bit %.3g rad, 32 bit %.3g rad\n", error48, error32);
+	}
+}
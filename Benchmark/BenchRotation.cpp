@@ -0,0 +1,200 @@
+#include <stdlib.h>
+#include <vector>
+
+#include "Benchmark.h"
+#include "EulerAngles.h"
+#include "RotationMatrix.h"
+#include "Quaternion.h"
+#include "Matrix4x3.h"
+#include "Vector3.h"
+#include "Vector3Array.h"
+#include "OrientationArray.h"
+
+// ƣλתܲ
+// ߣcary
+// ŷǡתԪ֮תԼתת
+//		ȽתתAoSSoA룩
+
+static float randomFloat() {
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+void benchmarkRotation() {
+	printf("== EulerAngles / RotationMatrix\n");
+	for (size_t level = 0; level < kCacheLevelCount; ++level) {
+		const CacheLevel& cache = kCacheLevels[level];
+		//루󣩺
+		const size_t n = itemsForCacheLevel(cache, sizeof(Matrix4x3) + sizeof(RotationMatrix));
+		std::vector<EulerAngles> euler(n), eulerOut(n);
+		std::vector<Quaternion> q(n);
+		std::vector<Matrix4x3> m(n);
+		std::vector<RotationMatrix> r(n), rOut(n);
+		std::vector<Vector3> v(n), vOut(n);
+		for (size_t i = 0; i < n; ++i) {
+			euler[i] = EulerAngles(randomFloat() * kPi, randomFloat() * kPiOver2, randomFloat() * kPi);
+			q[i].setToRotationObjectToInertial(euler[i]);
+			m[i].setupLocalToParent(Vector3(0.0f, 0.0f, 0.0f), euler[i]);
+			r[i].setup(euler[i]);
+			v[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+		}
+
+		reportBenchmark("EulerAngles::fromObjectToIntertialQuaternion", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				eulerOut[i].fromObjectToIntertialQuaternion(q[i]);
+			}
+			gBenchmarkSink = eulerOut[n - 1].heading;
+		}));
+		reportBenchmark("EulerAngles::fromIntertialToObjectQuaternion", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				eulerOut[i].fromIntertialToObjectQuaternion(q[i]);
+			}
+			gBenchmarkSink = eulerOut[n - 1].heading;
+		}));
+		reportBenchmark("EulerAngles::formObjectToWorldMatrix", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				eulerOut[i].formObjectToWorldMatrix(m[i]);
+			}
+			gBenchmarkSink = eulerOut[n - 1].heading;
+		}));
+		reportBenchmark("EulerAngles::formWorldToObjectMatrix", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				eulerOut[i].formWorldToObjectMatrix(m[i]);
+			}
+			gBenchmarkSink = eulerOut[n - 1].heading;
+		}));
+		reportBenchmark("EulerAngles::fromRotationMatrix", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				eulerOut[i].fromRotationMatrix(r[i]);
+			}
+			gBenchmarkSink = eulerOut[n - 1].heading;
+		}));
+		reportBenchmark("EulerAngles::fromRotationMatrix, medium", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				eulerOut[i].fromRotationMatrix(r[i], kPrecisionMedium);
+			}
+			gBenchmarkSink = eulerOut[n - 1].heading;
+		}));
+
+		reportBenchmark("RotationMatrix::setup", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				rOut[i].setup(euler[i]);
+			}
+			gBenchmarkSink = rOut[n - 1].m11;
+		}));
+		reportBenchmark("RotationMatrix::setup, medium", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				rOut[i].setup(euler[i], kPrecisionMedium);
+			}
+			gBenchmarkSink = rOut[n - 1].m11;
+		}));
+		reportBenchmark("RotationMatrix::formIntertialToObjectQuaternion", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				rOut[i].formIntertialToObjectQuaternion(q[i]);
+			}
+			gBenchmarkSink = rOut[n - 1].m11;
+		}));
+		reportBenchmark("RotationMatrix::formObjectToIntertialQuaternion", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				rOut[i].formObjectToIntertialQuaternion(q[i]);
+			}
+			gBenchmarkSink = rOut[n - 1].m11;
+		}));
+		reportBenchmark("formIntertialToObjectQuaternions", cache, n, measureSeconds([&]() {
+			formIntertialToObjectQuaternions(q.data(), rOut.data(), n);
+			gBenchmarkSink = rOut[n - 1].m11;
+		}));
+		reportBenchmark("formObjectToIntertialQuaternions", cache, n, measureSeconds([&]() {
+			formObjectToIntertialQuaternions(q.data(), rOut.data(), n);
+			gBenchmarkSink = rOut[n - 1].m11;
+		}));
+		//תŷǷֱAoSSoA룬ᡪvΪ
+		std::vector<float> heading(n), pitch(n), bank(n), theta(n);
+		Vector3Array axis(n);
+		std::vector<Quaternion> qOut(n);
+		std::vector<Matrix4x3> mOut(n);
+		for (size_t i = 0; i < n; ++i) {
+			heading[i] = euler[i].heading;
+			pitch[i] = euler[i].pitch;
+			bank[i] = euler[i].bank;
+			theta[i] = randomFloat() * kPi;
+			v[i].normalize();
+			axis.set(i, v[i]);
+		}
+		const MathPrecision kPrecisions[] = { kPrecisionFull, kPrecisionMedium };
+		const char* kPrecisionNames[] = { "full", "medium" };
+		char label[96];
+		for (int k = 0; k < 2; ++k) {
+			const MathPrecision precision = kPrecisions[k];
+			snprintf(label, sizeof(label), "Quaternion::setToRotationObjectToInertial, %s", kPrecisionNames[k]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				for (size_t i = 0; i < n; ++i) {
+					qOut[i].setToRotationObjectToInertial(euler[i], precision);
+				}
+				gBenchmarkSink = qOut[n - 1].w;
+			}));
+			snprintf(label, sizeof(label), "setToRotationObjectToInertial, AoS, %s", kPrecisionNames[k]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				setToRotationObjectToInertial(euler.data(), qOut.data(), n, precision);
+				gBenchmarkSink = qOut[n - 1].w;
+			}));
+			snprintf(label, sizeof(label), "setToRotationObjectToInertial, SoA, %s", kPrecisionNames[k]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				setToRotationObjectToInertial(heading.data(), pitch.data(), bank.data(), qOut.data(), n, precision);
+				gBenchmarkSink = qOut[n - 1].w;
+			}));
+			snprintf(label, sizeof(label), "RotationMatrix::setup, %s", kPrecisionNames[k]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				for (size_t i = 0; i < n; ++i) {
+					rOut[i].setup(euler[i], precision);
+				}
+				gBenchmarkSink = rOut[n - 1].m11;
+			}));
+			snprintf(label, sizeof(label), "setupRotationMatrices, AoS, %s", kPrecisionNames[k]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				setupRotationMatrices(euler.data(), rOut.data(), n, precision);
+				gBenchmarkSink = rOut[n - 1].m11;
+			}));
+			snprintf(label, sizeof(label), "setupLocalToParentMatrices, SoA, %s", kPrecisionNames[k]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				setupLocalToParentMatrices(heading.data(), pitch.data(), bank.data(), mOut.data(), n, precision);
+				gBenchmarkSink = mOut[n - 1].m11;
+			}));
+			snprintf(label, sizeof(label), "Matrix4x3::setupRotate(Vector3), %s", kPrecisionNames[k]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				for (size_t i = 0; i < n; ++i) {
+					mOut[i].setupRotate(v[i], theta[i], precision);
+				}
+				gBenchmarkSink = mOut[n - 1].m11;
+			}));
+			snprintf(label, sizeof(label), "setupRotateMatrices, AoS, %s", kPrecisionNames[k]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				setupRotateMatrices(v.data(), theta.data(), mOut.data(), n, precision);
+				gBenchmarkSink = mOut[n - 1].m11;
+			}));
+			snprintf(label, sizeof(label), "setQuaternionsAboutAxis, SoA, %s", kPrecisionNames[k]);
+			reportBenchmark(label, cache, n, measureSeconds([&]() {
+				setQuaternionsAboutAxis(axis, theta.data(), qOut.data(), n, precision);
+				gBenchmarkSink = qOut[n - 1].w;
+			}));
+		}
+		reportBenchmark("Quaternion::setQutaernionAboutAxis", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				qOut[i].setQutaernionAboutAxis(v[i], theta[i]);
+			}
+			gBenchmarkSink = qOut[n - 1].w;
+		}));
+
+		reportBenchmark("RotationMatrix::intertialToObject", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				vOut[i] = r[0].intertialToObject(v[i]);
+			}
+			gBenchmarkSink = vOut[n - 1].x;
+		}));
+		reportBenchmark("RotationMatrix::objectToIntertial", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				vOut[i] = r[0].objectToIntertial(v[i]);
+			}
+			gBenchmarkSink = vOut[n - 1].x;
+		}));
+	}
+}
@@ -0,0 +1,135 @@
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Skinning.h"
+#include "DualQuaternion.h"
+#include "Matrix4x3.h"
+#include "Quaternion.h"
+#include "EulerAngles.h"
+
+// ƣƤܲ
+// ߣcary
+// ȽϾɫƤԻϣͶżԪƤ̺߳ọ̈̄߳Լı汾
+//		ÿ4Ӱ죬ͬʱ任λúͷĵɫСһֱڻ
+//		ַڡǹֽµxŤת180ȵĹͲĹռһȨʱ
+//		xΪ1ĵϺxľ룬ȷĽ1
+
+static float randomFloat() {
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+void benchmarkSkinning() {
+	printf("== Skinning\n");
+	const size_t kBoneCount = 128;
+	printf("%zu bones: palette %zu bytes as Matrix4x3, %zu bytes as DualQuaternion\n",
+		kBoneCount, kBoneCount * sizeof(Matrix4x3), kBoneCount * sizeof(DualQuaternion));
+
+	//ǹֽ
+	{
+		Quaternion twist;
+		twist.setQuaternionAboutX(kPi);
+		Matrix4x3 m[2];
+		m[0].identity();
+		m[1].fromQuaternion(twist);
+		m[1].zeroTranslation();
+		DualQuaternion dq[2];
+		dq[0].identity();
+		dq[1].setup(twist, Vector3(0.0f, 0.0f, 0.0f));
+		SkinWeights w = { { 0, 1, 0, 0 }, { 0.5f, 0.5f, 0.0f, 0.0f } };
+		Vector3 p(0.5f, 1.0f, 0.0f), linear, dual;
+		skinLinearBlend(m, &w, &p, NULL, &linear, NULL, 1, 1);
+		skinDualQuaternion(dq, &w, &p, NULL, &dual, NULL, 1, 1);
+		printf("180 degree twist, 50/50 weights: distance to axis %.3f (linear blend), %.3f (dual quaternion)\n",
+			sqrtf(linear.y * linear.y + linear.z * linear.z), sqrtf(dual.y * dual.y + dual.z * dual.z));
+	}
+
+	std::vector<Matrix4x3> palette(kBoneCount);
+	std::vector<DualQuaternion> bones(kBoneCount);
+	for (size_t b = 0; b < kBoneCount; ++b) {
+		Quaternion q;
+		q.setToRotationObjectToInertial(EulerAngles(randomFloat() * kPi, randomFloat() * kPiOver2, randomFloat() * kPi));
+		Vector3 t(randomFloat(), randomFloat(), randomFloat());
+		palette[b].fromQuaternion(q);
+		palette[b].setTranslation(t);
+		bones[b].setup(q, t);
+	}
+
+	for (size_t level = 0; level < kCacheLevelCount; ++level) {
+		const CacheLevel& cache = kCacheLevels[level];
+		//Ȩأλá
+		const size_t n = itemsForCacheLevel(cache, sizeof(SkinWeights) + sizeof(Vector3) * 4);
+		std::vector<SkinWeights> weights(n);
+		std::vector<Vector3> positions(n), normals(n), outPositions(n), outNormals(n);
+		for (size_t i = 0; i < n; ++i) {
+			//ڵĶڵĹӰ
+			float sum = 0.0f;
+			for (int k = 0; k < 4; ++k) {
+				weights[i].bone[k] = (uint16_t)((i * kBoneCount / n + k) % kBoneCount);
+				weights[i].weight[k] = fabsf(randomFloat()) + 0.01f;
+				sum += weights[i].weight[k];
+			}
+			for (int k = 0; k < 4; ++k) {
+				weights[i].weight[k] /= sum;
+			}
+			positions[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+			normals[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+		}
+
+		reportBenchmark("linear blend, scalar", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				const SkinWeights& w = weights[i];
+				Matrix4x3 m;
+				const float* e0 = &palette[w.bone[0]].m11;
+				float* e = &m.m11;
+				for (int j = 0; j < 12; ++j) {
+					e[j] = w.weight[0] * e0[j];
+				}
+				for (int k = 1; k < 4; ++k) {
+					const float* ek = &palette[w.bone[k]].m11;
+					for (int j = 0; j < 12; ++j) {
+						e[j] += w.weight[k] * ek[j];
+					}
+				}
+				outPositions[i] = positions[i] * m;
+				m.zeroTranslation();
+				outNormals[i] = normals[i] * m;
+			}
+			gBenchmarkSink = outPositions[n - 1].x;
+		}));
+		reportBenchmark("skinLinearBlend, 1 thread", cache, n, measureSeconds([&]() {
+			skinLinearBlend(palette.data(), weights.data(), positions.data(), normals.data(),
+				outPositions.data(), outNormals.data(), n, 1);
+			gBenchmarkSink = outPositions[n - 1].x;
+		}));
+		reportBenchmark("skinLinearBlend, all threads", cache, n, measureSeconds([&]() {
+			skinLinearBlend(palette.data(), weights.data(), positions.data(), normals.data(),
+				outPositions.data(), outNormals.data(), n);
+			gBenchmarkSink = outPositions[n - 1].x;
+		}));
+
+		reportBenchmark("dual quaternion, blend + operator*", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				const SkinWeights& w = weights[i];
+				DualQuaternion gathered[4] = {
+					bones[w.bone[0]], bones[w.bone[1]], bones[w.bone[2]], bones[w.bone[3]]
+				};
+				DualQuaternion dq = blend(gathered, w.weight, 4);
+				outPositions[i] = positions[i] * dq;
+				outNormals[i] = rotate(dq.real, normals[i]);
+			}
+			gBenchmarkSink = outPositions[n - 1].x;
+		}));
+		reportBenchmark("skinDualQuaternion, 1 thread", cache, n, measureSeconds([&]() {
+			skinDualQuaternion(bones.data(), weights.data(), positions.data(), normals.data(),
+				outPositions.data(), outNormals.data(), n, 1);
+			gBenchmarkSink = outPositions[n - 1].x;
+		}));
+		reportBenchmark("skinDualQuaternion, all threads", cache, n, measureSeconds([&]() {
+			skinDualQuaternion(bones.data(), weights.data(), positions.data(), normals.data(),
+				outPositions.data(), outNormals.data(), n);
+			gBenchmarkSink = outPositions[n - 1].x;
+		}));
+	}
+}
@@ -0,0 +1,144 @@
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SpatialHashGrid.h"
+
+// ƣռϣܲ
+// ߣcary
+// ȽȫAABBÿռϣĵ㡢AABBѯԼĲƶ
+//		ȷֲ߳13֮䣬Ԫֱ߳ȡʹС124
+
+static float randomFloat() {
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+void benchmarkSpatialHashGrid() {
+	printf("== SpatialHashGrid\n");
+	const size_t kCounts[] = { 16384, 131072 };
+	const size_t kQueryCount = 1024;
+	//ĴۺȣֻԽٵ
+	const size_t kMaxBruteCount = 16384;
+	const float kCellSizes[] = { 2.0f, 4.0f, 8.0f };
+	for (size_t c = 0; c < sizeof(kCounts) / sizeof(kCounts[0]); ++c) {
+		const size_t n = kCounts[c];
+		//ռСӣܶȲ
+		const float halfSize = 10.0f * cbrtf((float)n);
+		std::vector<AABB3> boxes(n);
+		for (size_t i = 0; i < n; ++i) {
+			Vector3 center(randomFloat() * halfSize, randomFloat() * halfSize, randomFloat() * halfSize);
+			Vector3 extent(fabs(randomFloat()) + 0.5f, fabs(randomFloat()) + 0.5f, fabs(randomFloat()) + 0.5f);
+			boxes[i].min = center - extent;
+			boxes[i].max = center + extent;
+		}
+		std::vector<Vector3> points(kQueryCount);
+		std::vector<AABB3> queryBoxes(kQueryCount);
+		for (size_t i = 0; i < kQueryCount; ++i) {
+			points[i] = Vector3(randomFloat() * halfSize, randomFloat() * halfSize, randomFloat() * halfSize);
+			queryBoxes[i].min = points[i] - Vector3(3.0f, 3.0f, 3.0f);
+			queryBoxes[i].max = points[i] + Vector3(3.0f, 3.0f, 3.0f);
+		}
+		const float kRadius = 3.0f;
+		std::vector<int> result;
+		char label[64];
+		printf("%zu boxes, %zu queries\n", n, kQueryCount);
+
+		if (n <= kMaxBruteCount) {
+			reportBenchmark("queryPoint, brute force", kQueryCount, measureSeconds([&]() {
+				result.clear();
+				for (size_t q = 0; q < kQueryCount; ++q) {
+					for (size_t i = 0; i < n; ++i) {
+						if (boxes[i].contains(points[q])) {
+							result.push_back((int)i);
+						}
+					}
+				}
+				gBenchmarkSink = (float)result.size();
+			}));
+			reportBenchmark("querySphere, brute force", kQueryCount, measureSeconds([&]() {
+				result.clear();
+				for (size_t q = 0; q < kQueryCount; ++q) {
+					for (size_t i = 0; i < n; ++i) {
+						if (boxes[i].intersectsSphere(points[q], kRadius)) {
+							result.push_back((int)i);
+						}
+					}
+				}
+				gBenchmarkSink = (float)result.size();
+			}));
+			reportBenchmark("queryAABB, brute force", kQueryCount, measureSeconds([&]() {
+				result.clear();
+				for (size_t q = 0; q < kQueryCount; ++q) {
+					for (size_t i = 0; i < n; ++i) {
+						if (intersectAABBs(queryBoxes[q], boxes[i])) {
+							result.push_back((int)i);
+						}
+					}
+				}
+				gBenchmarkSink = (float)result.size();
+			}));
+		}
+
+		for (size_t s = 0; s < sizeof(kCellSizes) / sizeof(kCellSizes[0]); ++s) {
+			const float cellSize = kCellSizes[s];
+			snprintf(label, sizeof(label), "insert all, cell %.0f", cellSize);
+			reportBenchmark(label, n, measureSeconds([&]() {
+				SpatialHashGrid grid(cellSize);
+				for (size_t i = 0; i < n; ++i) {
+					grid.add(boxes[i]);
+				}
+				gBenchmarkSink = (float)grid.cellCount();
+			}));
+
+			SpatialHashGrid grid(cellSize);
+			for (size_t i = 0; i < n; ++i) {
+				grid.add(boxes[i]);
+			}
+			snprintf(label, sizeof(label), "queryPoint, cell %.0f", cellSize);
+			reportBenchmark(label, kQueryCount, measureSeconds([&]() {
+				result.clear();
+				for (size_t q = 0; q < kQueryCount; ++q) {
+					grid.queryPoint(points[q], &result);
+				}
+				gBenchmarkSink = (float)result.size();
+			}));
+			snprintf(label, sizeof(label), "querySphere, cell %.0f", cellSize);
+			reportBenchmark(label, kQueryCount, measureSeconds([&]() {
+				result.clear();
+				for (size_t q = 0; q < kQueryCount; ++q) {
+					grid.querySphere(points[q], kRadius, &result);
+				}
+				gBenchmarkSink = (float)result.size();
+			}));
+			snprintf(label, sizeof(label), "queryAABB, cell %.0f", cellSize);
+			reportBenchmark(label, kQueryCount, measureSeconds([&]() {
+				result.clear();
+				for (size_t q = 0; q < kQueryCount; ++q) {
+					grid.queryAABB(queryBoxes[q], &result);
+				}
+				gBenchmarkSink = (float)result.size();
+			}));
+			//ÿƶһСξ룬󲿷ԭĵԪ
+			snprintf(label, sizeof(label), "update, small moves, cell %.0f", cellSize);
+			reportBenchmark(label, n, measureSeconds([&]() {
+				for (size_t i = 0; i < n; ++i) {
+					AABB3 box = grid.getBox((int)i);
+					Vector3 d(randomFloat() * 0.05f, randomFloat() * 0.05f, randomFloat() * 0.05f);
+					box.min += d;
+					box.max += d;
+					grid.update((int)i, box);
+				}
+				gBenchmarkSink = (float)grid.cellCount();
+			}));
+			//ÿƶһλ
+			snprintf(label, sizeof(label), "update, teleport, cell %.0f", cellSize);
+			reportBenchmark(label, n, measureSeconds([&]() {
+				for (size_t i = 0; i < n; ++i) {
+					grid.update((int)i, boxes[rand() % n]);
+				}
+				gBenchmarkSink = (float)grid.cellCount();
+			}));
+		}
+	}
+}
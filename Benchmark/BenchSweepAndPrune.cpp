@@ -0,0 +1,105 @@
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SweepAndPrune.h"
+
+// ƣɨͼܲ
+// ߣcary
+// Ƚÿ֡intersectAABBs()ԲԣͶɨͼĴ
+//		ÿ֡һƶһСξ룬㣬ÿ֡ʱ
+
+static float randomFloat() {
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+//ƶcountѡ壬ÿƶstep
+static void moveBoxes(std::vector<AABB3>& boxes, size_t count, float step, SweepAndPrune* sap) {
+	for (size_t i = 0; i < count; ++i) {
+		size_t index = rand() % boxes.size();
+		Vector3 d(randomFloat() * step, randomFloat() * step, randomFloat() * step);
+		boxes[index].min += d;
+		boxes[index].max += d;
+		if (sap != NULL) {
+			sap->update((int)index, boxes[index]);
+		}
+	}
+}
+
+void benchmarkSweepAndPrune() {
+	printf("== SweepAndPrune\n");
+	//100000壬ƶʱÿ֡Ŀ1
+	const size_t kCounts[] = { 16384, 100000 };
+	//ĴۺƽȣֻԽٵ
+	const size_t kMaxBruteCount = 16384;
+	const float kStep = 0.05f;
+	for (size_t c = 0; c < sizeof(kCounts) / sizeof(kCounts[0]); ++c) {
+		const size_t n = kCounts[c];
+		//ı߳13֮䣬ռСӣܶȲ
+		const float halfSize = 10.0f * cbrtf((float)n);
+		std::vector<AABB3> boxes(n);
+		for (size_t i = 0; i < n; ++i) {
+			Vector3 center(randomFloat() * halfSize, randomFloat() * halfSize, randomFloat() * halfSize);
+			Vector3 extent(fabs(randomFloat()) + 0.5f, fabs(randomFloat()) + 0.5f, fabs(randomFloat()) + 0.5f);
+			boxes[i].min = center - extent;
+			boxes[i].max = center + extent;
+		}
+		std::vector<SweepAndPrune::Pair> added, removed;
+		printf("%zu boxes\n", n);
+
+		if (n <= kMaxBruteCount) {
+			std::vector<SweepAndPrune::Pair> pairs;
+			double brute = measureSeconds([&]() {
+				moveBoxes(boxes, n / 100, kStep, NULL);
+				pairs.clear();
+				for (size_t i = 0; i < n; ++i) {
+					for (size_t j = i + 1; j < n; ++j) {
+						if (intersectAABBs(boxes[i], boxes[j])) {
+							SweepAndPrune::Pair pair = { (int)i, (int)j };
+							pairs.push_back(pair);
+						}
+					}
+				}
+				gBenchmarkSink = (float)pairs.size();
+			});
+			reportBenchmark("frame, brute force", n, brute);
+		}
+
+		for (int m = 0; m < 2; ++m) {
+			SweepAndPrune::Mode mode = m == 0 ? SweepAndPrune::kSingleAxis : SweepAndPrune::kMultiAxis;
+			const char* name = m == 0 ? "single axis" : "multi axis";
+			char label[64];
+
+			//һupdatePairs()ȫ
+			double insert = measureSeconds([&]() {
+				SweepAndPrune sap(mode);
+				for (size_t i = 0; i < n; ++i) {
+					sap.add(boxes[i]);
+				}
+				sap.updatePairs(NULL, NULL);
+				gBenchmarkSink = (float)sap.pairCount();
+			});
+			snprintf(label, sizeof(label), "insert all, %s", name);
+			reportBenchmark(label, n, insert);
+
+			SweepAndPrune sap(mode);
+			for (size_t i = 0; i < n; ++i) {
+				sap.add(boxes[i]);
+			}
+			sap.updatePairs(NULL, NULL);
+			const size_t kMovingPercent[] = { 1, 10 };
+			for (size_t p = 0; p < sizeof(kMovingPercent) / sizeof(kMovingPercent[0]); ++p) {
+				double frame = measureSeconds([&]() {
+					moveBoxes(boxes, n * kMovingPercent[p] / 100, kStep, &sap);
+					added.clear();
+					removed.clear();
+					sap.updatePairs(&added, &removed);
+					gBenchmarkSink = (float)(added.size() + removed.size());
+				});
+				snprintf(label, sizeof(label), "frame, %s, %zu%% moving", name, kMovingPercent[p]);
+				reportBenchmark(label, n, frame);
+			}
+		}
+	}
+}
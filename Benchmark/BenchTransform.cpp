@@ -0,0 +1,135 @@
+#include <stdlib.h>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Transform.h"
+#include "Matrix4x3.h"
+#include "Quaternion.h"
+#include "EulerAngles.h"
+
+// ƣ任ܲ
+// ߣcary
+// ȽTransformתƽƣţMatrix4x3ӡϡı任
+//		ԼTransformתΪĴ
+//		ֱʾʹͬĽڵϴMatrix4x3ѡ
+
+static float randomFloat() {
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+void benchmarkTransform() {
+	printf("== Transform\n");
+	printf("sizeof(Transform) = %zu, sizeof(Matrix4x3) = %zu\n", sizeof(Transform), sizeof(Matrix4x3));
+	for (size_t level = 0; level < kCacheLevelCount; ++level) {
+		const CacheLevel& cache = kCacheLevels[level];
+		//һ
+		const size_t n = itemsForCacheLevel(cache, sizeof(Matrix4x3) * 3);
+		std::vector<Transform> a(n), b(n), out(n);
+		std::vector<Matrix4x3> ma(n), mb(n), mOut(n);
+		std::vector<Vector3> v(n), vOut(n);
+		std::vector<int> parent(n);
+		for (size_t i = 0; i < n; ++i) {
+			a[i].rotation.setToRotationObjectToInertial(EulerAngles(randomFloat() * kPi, randomFloat() * kPiOver2, randomFloat() * kPi));
+			a[i].translation = Vector3(randomFloat(), randomFloat(), randomFloat());
+			a[i].scale = randomFloat() * 0.1f + 1.0f;
+			b[i].rotation.setToRotationObjectToInertial(EulerAngles(randomFloat() * kPi, randomFloat() * kPiOver2, randomFloat() * kPi));
+			b[i].translation = Vector3(randomFloat(), randomFloat(), randomFloat());
+			b[i].scale = randomFloat() * 0.1f + 1.0f;
+			ma[i] = a[i].toMatrix();
+			mb[i] = b[i].toMatrix();
+			v[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+			//8ͬһĽڵ
+			parent[i] = i == 0 ? -1 : (int)((i - 1) / 8);
+		}
+
+		reportBenchmark("Matrix4x3 operator*", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				mOut[i] = ma[i] * mb[i];
+			}
+			gBenchmarkSink = mOut[n - 1].m11;
+		}));
+		reportBenchmark("Transform operator*", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = a[i] * b[i];
+			}
+			gBenchmarkSink = out[n - 1].scale;
+		}));
+		reportBenchmark("concatenate(Matrix4x3[])", cache, n, measureSeconds([&]() {
+			concatenate(ma.data(), mb.data(), mOut.data(), n);
+			gBenchmarkSink = mOut[n - 1].m11;
+		}));
+		reportBenchmark("concatenate(Transform[])", cache, n, measureSeconds([&]() {
+			concatenate(a.data(), b.data(), out.data(), n);
+			gBenchmarkSink = out[n - 1].scale;
+		}));
+
+		reportBenchmark("hierarchy, Matrix4x3 operator*", cache, n, measureSeconds([&]() {
+			mOut[0] = ma[0];
+			for (size_t i = 1; i < n; ++i) {
+				mOut[i] = ma[i] * mOut[parent[i]];
+			}
+			gBenchmarkSink = mOut[n - 1].m11;
+		}));
+		reportBenchmark("hierarchy, Transform operator*", cache, n, measureSeconds([&]() {
+			out[0] = a[0];
+			for (size_t i = 1; i < n; ++i) {
+				out[i] = a[i] * out[parent[i]];
+			}
+			gBenchmarkSink = out[n - 1].scale;
+		}));
+		reportBenchmark("composeHierarchy(Transform[])", cache, n, measureSeconds([&]() {
+			composeHierarchy(a.data(), parent.data(), out.data(), n);
+			gBenchmarkSink = out[n - 1].scale;
+		}));
+		reportBenchmark("composeHierarchy + toMatrices", cache, n, measureSeconds([&]() {
+			composeHierarchy(a.data(), parent.data(), out.data(), n);
+			toMatrices(out.data(), mOut.data(), n);
+			gBenchmarkSink = mOut[n - 1].m11;
+		}));
+
+		reportBenchmark("toMatrix", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				mOut[i] = a[i].toMatrix();
+			}
+			gBenchmarkSink = mOut[n - 1].m11;
+		}));
+		reportBenchmark("toMatrices", cache, n, measureSeconds([&]() {
+			toMatrices(a.data(), mOut.data(), n);
+			gBenchmarkSink = mOut[n - 1].m11;
+		}));
+
+		reportBenchmark("Vector3 * Matrix4x3", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				vOut[i] = v[i] * ma[i];
+			}
+			gBenchmarkSink = vOut[n - 1].x;
+		}));
+		reportBenchmark("Vector3 * Transform", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				vOut[i] = v[i] * a[i];
+			}
+			gBenchmarkSink = vOut[n - 1].x;
+		}));
+		reportBenchmark("transformPoints(Transform)", cache, n, measureSeconds([&]() {
+			transformPoints(v.data(), vOut.data(), n, a[0]);
+			gBenchmarkSink = vOut[n - 1].x;
+		}));
+
+		reportBenchmark("inverse(Matrix4x3)", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				mOut[i] = inverse(ma[i]);
+			}
+			gBenchmarkSink = mOut[n - 1].m11;
+		}));
+		reportBenchmark("inverse(Transform)", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = inverse(a[i]);
+			}
+			gBenchmarkSink = out[n - 1].scale;
+		}));
+		reportBenchmark("inverse(Transform[])", cache, n, measureSeconds([&]() {
+			inverse(a.data(), out.data(), n);
+			gBenchmarkSink = out[n - 1].scale;
+		}));
+	}
+}
@@ -0,0 +1,197 @@
+#include <stdlib.h>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Vector3.h"
+#include "Vector3Array.h"
+
+// ƣܲ
+// ߣcary
+// Vector3ͳúԼVector3ArrayӦ
+//		Ƚϱʽģԭÿһʱ󡢸ֵֵصʵ
+
+static float randomFloat() {
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+//ԭVector3ʵ֣ÿһʱ󣬸ƹ캯ƽģ
+//ֵ͸ϸֵֵ*thisÿζһθ
+struct LegacyVector3 {
+	float x, y, z;
+
+	LegacyVector3() {}
+	LegacyVector3(const LegacyVector3& a) :x(a.x), y(a.y), z(a.z) {}
+	LegacyVector3(float nx, float ny, float nz) :x(nx), y(ny), z(nz) {}
+
+	LegacyVector3 operator = (const LegacyVector3& a) {
+		x = a.x; y = a.y; z = a.z;
+		return *this;
+	}
+	LegacyVector3 operator + (const LegacyVector3& a) const {
+		return LegacyVector3(x + a.x, y + a.y, z + a.z);
+	}
+	LegacyVector3 operator - (const LegacyVector3& a) const {
+		return LegacyVector3(x - a.x, y - a.y, z - a.z);
+	}
+	LegacyVector3 operator * (const float a) const {
+		return LegacyVector3(x * a, y * a, z * a);
+	}
+	LegacyVector3 operator += (const LegacyVector3& a) {
+		x += a.x; y += a.y; z += a.z;
+		return *this;
+	}
+};
+
+void benchmarkVector3() {
+	printf("== Vector3\n");
+	for (size_t level = 0; level < kCacheLevelCount; ++level) {
+		const CacheLevel& cache = kCacheLevels[level];
+		//һ
+		const size_t n = itemsForCacheLevel(cache, sizeof(Vector3) * 3);
+		std::vector<Vector3> a(n), b(n), out(n);
+		std::vector<float> scalarOut(n);
+		for (size_t i = 0; i < n; ++i) {
+			a[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+			b[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+		}
+		Vector3Array arrayA, arrayB, arrayOut;
+		arrayA.fromVector3s(a.data(), n);
+		arrayB.fromVector3s(b.data(), n);
+
+		reportBenchmark("operator+", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = a[i] + b[i];
+			}
+			gBenchmarkSink = out[n - 1].x;
+		}));
+		reportBenchmark("operator-", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = a[i] - b[i];
+			}
+			gBenchmarkSink = out[n - 1].x;
+		}));
+		reportBenchmark("operator*(float)", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = a[i] * 2.5f;
+			}
+			gBenchmarkSink = out[n - 1].x;
+		}));
+		reportBenchmark("operator/(float)", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = a[i] / 2.5f;
+			}
+			gBenchmarkSink = out[n - 1].x;
+		}));
+		reportBenchmark("operator+=", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] += a[i];
+			}
+			gBenchmarkSink = out[n - 1].x;
+		}));
+		reportBenchmark("operator*(Vector3), dot", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				scalarOut[i] = a[i] * b[i];
+			}
+			gBenchmarkSink = scalarOut[n - 1];
+		}));
+		reportBenchmark("crossProduct", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = crossProduct(a[i], b[i]);
+			}
+			gBenchmarkSink = out[n - 1].x;
+		}));
+		reportBenchmark("vectorMag", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				scalarOut[i] = vectorMag(a[i]);
+			}
+			gBenchmarkSink = scalarOut[n - 1];
+		}));
+		reportBenchmark("distance", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				scalarOut[i] = distance(a[i], b[i]);
+			}
+			gBenchmarkSink = scalarOut[n - 1];
+		}));
+		reportBenchmark("normalize", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = a[i];
+				out[i].normalize();
+			}
+			gBenchmarkSink = out[n - 1].x;
+		}));
+
+		//һp += v * dt + acc * (dt * dt / 2)v += acc * dt
+		//aΪٶȣλúٶÿβǰڼʱָ֮ΪinitialPositionb
+		//汾Ԫػָvectorֵ޷ȷ֮ûб-O2ʱȽϾͲƽ
+		const float dt = 0.016f, halfDt2 = 0.5f * dt * dt, k = 0.25f;
+		std::vector<Vector3> initialPosition(n), position(n), velocity(n);
+		std::vector<LegacyVector3> legacyA(n), legacyB(n), legacyPosition(n), legacyVelocity(n), legacyOut(n);
+		for (size_t i = 0; i < n; ++i) {
+			initialPosition[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+			legacyA[i] = LegacyVector3(a[i].x, a[i].y, a[i].z);
+			legacyB[i] = LegacyVector3(b[i].x, b[i].y, b[i].z);
+		}
+		reportBenchmark("integrate step, temporaries", cache, n, measureSecondsWithReset([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				legacyPosition[i] += legacyVelocity[i] * dt + legacyA[i] * halfDt2;
+				legacyVelocity[i] += legacyA[i] * dt;
+			}
+			gBenchmarkSink = legacyPosition[n - 1].x;
+		}, [&]() {
+			for (size_t i = 0; i < n; ++i) {
+				legacyPosition[i] = LegacyVector3(initialPosition[i].x, initialPosition[i].y, initialPosition[i].z);
+				legacyVelocity[i] = legacyB[i];
+			}
+		}));
+		reportBenchmark("integrate step, expression templates", cache, n, measureSecondsWithReset([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				position[i] += velocity[i] * dt + a[i] * halfDt2;
+				velocity[i] += a[i] * dt;
+			}
+			gBenchmarkSink = position[n - 1].x;
+		}, [&]() {
+			for (size_t i = 0; i < n; ++i) {
+				position[i] = initialPosition[i];
+				velocity[i] = b[i];
+			}
+		}));
+		reportBenchmark("a + b * k - (a - b) * k, temporaries", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				legacyOut[i] = legacyA[i] + legacyB[i] * k - (legacyA[i] - legacyB[i]) * k;
+			}
+			gBenchmarkSink = legacyOut[n - 1].x;
+		}));
+		reportBenchmark("a + b * k - (a - b) * k, expression templates", cache, n, measureSeconds([&]() {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = a[i] + b[i] * k - (a[i] - b[i]) * k;
+			}
+			gBenchmarkSink = out[n - 1].x;
+		}));
+
+		reportBenchmark("Vector3Array add", cache, n, measureSeconds([&]() {
+			add(arrayA, arrayB, &arrayOut);
+			gBenchmarkSink = arrayOut.x[n - 1];
+		}));
+		reportBenchmark("Vector3Array scale", cache, n, measureSeconds([&]() {
+			scale(arrayA, 2.5f, &arrayOut);
+			gBenchmarkSink = arrayOut.x[n - 1];
+		}));
+		reportBenchmark("Vector3Array dotProduct", cache, n, measureSeconds([&]() {
+			dotProduct(arrayA, arrayB, scalarOut.data());
+			gBenchmarkSink = scalarOut[n - 1];
+		}));
+		reportBenchmark("Vector3Array crossProduct", cache, n, measureSeconds([&]() {
+			crossProduct(arrayA, arrayB, &arrayOut);
+			gBenchmarkSink = arrayOut.x[n - 1];
+		}));
+		reportBenchmark("Vector3Array vectorMag", cache, n, measureSeconds([&]() {
+			vectorMag(arrayA, scalarOut.data());
+			gBenchmarkSink = scalarOut[n - 1];
+		}));
+		reportBenchmark("Vector3Array normalize", cache, n, measureSeconds([&]() {
+			arrayOut = arrayA;
+			arrayOut.normalize();
+			gBenchmarkSink = arrayOut.x[n - 1];
+		}));
+	}
+}
@@ -0,0 +1,62 @@
+#include <string.h>
+
+#include "Benchmark.h"
+
+// ƣܲ
+// ߣcary
+// ܲԳڣи
+//		вΪҪе Benchmark Vector3 AABB3ûвʱȫ
+
+volatile float gBenchmarkSink;
+
+struct BenchmarkGroup {
+	const char* name;
+	void (*run)();
+};
+
+static const BenchmarkGroup kGroups[] = {
+	{ "Vector3", benchmarkVector3 },
+	{ "Matrix4x3", benchmarkMatrix4x3 },
+	{ "Transform", benchmarkTransform },
+	{ "Quaternion", benchmarkQuaternion },
+	{ "Rotation", benchmarkRotation },
+	{ "Skinning", benchmarkSkinning },
+	{ "Animation", benchmarkAnimation },
+	{ "MathUtil", benchmarkMathUtil },
+	{ "AABB3", benchmarkAABB3 },
+	{ "BVH", benchmarkBVH },
+	{ "SweepAndPrune", benchmarkSweepAndPrune },
+	{ "Frustum", benchmarkFrustum },
+	{ "SpatialHashGrid", benchmarkSpatialHashGrid },
+	{ "LooseOctree", benchmarkLooseOctree }
+};
+const size_t kGroupCount = sizeof(kGroups) / sizeof(kGroups[0]);
+
+int main(int argc, char* argv[])
+{
+	for (int i = 1; i < argc; ++i) {
+		bool found = false;
+		for (size_t g = 0; g < kGroupCount; ++g) {
+			found = found || strcmp(argv[i], kGroups[g].name) == 0;
+		}
+		if (!found) {
+			printf("unknown group: %s\navailable groups:", argv[i]);
+			for (size_t g = 0; g < kGroupCount; ++g) {
+				printf(" %s", kGroups[g].name);
+			}
+			printf("\n");
+			return 1;
+		}
+	}
+
+	for (size_t g = 0; g < kGroupCount; ++g) {
+		bool run = argc == 1;
+		for (int i = 1; i < argc; ++i) {
+			run = run || strcmp(argv[i], kGroups[g].name) == 0;
+		}
+		if (run) {
+			kGroups[g].run();
+		}
+	}
+	return 0;
+}
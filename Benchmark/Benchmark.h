@@ -0,0 +1,114 @@
+#pragma once
+
+#ifndef __BENCHMARK_H_INCLUDED__
+#define __BENCHMARK_H_INCLUDED__
+
+#include <stdio.h>
+#include <stddef.h>
+#include <chrono>
+
+// ƣܲ
+// ߣcary
+// ܲõļʱߣԼԵ
+
+//ֹѲԽôŻ
+extern volatile float gBenchmarkSink;
+
+//funcֱۼminSeconds룬ƽÿεõ
+template <typename Func>
+double measureSeconds(Func func, double minSeconds = 0.2) {
+	typedef std::chrono::steady_clock Clock;
+	//һΣݽ뻺
+	func();
+	size_t iterations = 1;
+	for (;;) {
+		Clock::time_point start = Clock::now();
+		for (size_t i = 0; i < iterations; ++i) {
+			func();
+		}
+		double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		if (seconds >= minSeconds) {
+			return seconds / iterations;
+		}
+		iterations *= 2;
+	}
+}
+
+//measureSeconds()ͬÿεfunc֮ǰȵresetָݣֻfuncʱ
+//ڻ޸ԼĲԣһÿεõʱfuncʱҪԶڶȡʱӵĿ
+template <typename Func, typename Reset>
+double measureSecondsWithReset(Func func, Reset reset, double minSeconds = 0.2) {
+	typedef std::chrono::steady_clock Clock;
+	reset();
+	func();
+	double seconds = 0.0;
+	size_t iterations = 0;
+	while (seconds < minSeconds) {
+		reset();
+		Clock::time_point start = Clock::now();
+		func();
+		seconds += std::chrono::duration<double>(Clock::now() - start).count();
+		++iterations;
+	}
+	return seconds / iterations;
+}
+
+//һнƺĲ
+//nameLength ΪѾƵַ56ַʱո
+inline void reportBenchmarkValues(int nameLength, size_t items, double secondsPerCall) {
+	double nsPerItem = secondsPerCall * 1e9 / items;
+	int padding = nameLength < 56 ? 56 - nameLength : 0;
+	printf("%*s %10zu items %10.3f ns/op %12.3f M items/s\n", padding, "", items, nsPerItem, items / secondsPerCall * 1e-6);
+}
+
+//һн
+//items ΪÿεôԪظ
+inline void reportBenchmark(const char* name, size_t items, double secondsPerCall) {
+	reportBenchmarkValues(printf("%s", name), items, secondsPerCall);
+}
+
+//漶
+//ÿԵȫֱֽŵýL1L2L3棬ֻܷڴ
+//ͷѡL132KBL2256KBL38MB
+struct CacheLevel {
+	const char* name;
+	size_t bytes;
+};
+
+const CacheLevel kCacheLevels[] = {
+	{ "L1", 16 * 1024 },
+	{ "L2", 192 * 1024 },
+	{ "L3", 4 * 1024 * 1024 },
+	{ "DRAM", 64 * 1024 * 1024 }
+};
+const size_t kCacheLevelCount = sizeof(kCacheLevels) / sizeof(kCacheLevels[0]);
+
+//ÿԪռbytesPerItemֽʱû漶ŵµԪظȡ8ıΪ8
+inline size_t itemsForCacheLevel(const CacheLevel& level, size_t bytesPerItem) {
+	size_t items = level.bytes / bytesPerItem / 8 * 8;
+	return items < 8 ? 8 : items;
+}
+
+//һнƺϻ漶
+//ƺͻ漶̶ֱȵĻƽϳʱҲᱻض
+inline void reportBenchmark(const char* name, const CacheLevel& level, size_t items, double secondsPerCall) {
+	reportBenchmarkValues(printf("%s [%s]", name, level.name), items, secondsPerCall);
+}
+
+//
+void benchmarkVector3();
+void benchmarkMatrix4x3();
+void benchmarkTransform();
+void benchmarkQuaternion();
+void benchmarkRotation();
+void benchmarkSkinning();
+void benchmarkAnimation();
+void benchmarkMathUtil();
+void benchmarkAABB3();
+void benchmarkBVH();
+void benchmarkSweepAndPrune();
+void benchmarkFrustum();
+void benchmarkSpatialHashGrid();
+void benchmarkLooseOctree();
+
+#endif // #ifndef __BENCHMARK_H_INCLUDED__